@@ -219,6 +219,11 @@ extern "C"
 EXTERN volatile uint64_t *g_current_regs[CONFIG_SMP_NCPUS];
 #define CURRENT_REGS (g_current_regs[up_cpu_index()])
 
+/* Return the PC of the given context or of the interrupted context */
+
+#define up_getusrpc(regs) \
+  (((FAR uint64_t *)((regs) ? (regs) : CURRENT_REGS))[REG_ELR])
+
 struct xcptcontext
 {
   /* The following function pointer is non-zero if there are pending signals
@@ -22,16 +22,108 @@
  * Included Files
  ****************************************************************************/
 
+#include <nuttx/config.h>
+
+#include <errno.h>
+#include <sched.h>
+
+#include <nuttx/arch.h>
 #include <nuttx/clock.h>
+#include <nuttx/irq.h>
+#include <nuttx/perf.h>
 
+#include "arm64_gic.h"
 #include "arm64_pmu.h"
 
-#ifdef CONFIG_ARCH_PERF_EVENTS
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+/* The PMU overflow interrupt.  The Arm BSA recommends PPI 7, a chip using
+ * another one can define ARM64_PMU_IRQ in its chip.h.
+ */
+
+#ifndef ARM64_PMU_IRQ
+#  define ARM64_PMU_IRQ       (GIC_PPI_INT_BASE + 7)
+#endif
+
+#define ARM64_PMU_NCOUNTERS   31
+#define ARM64_PMU_WRAP        (UINT64_C(1) << 32)
+
+/****************************************************************************
+ * Private Data
+ ****************************************************************************/
+
+#ifdef CONFIG_PERF_EVENTS
+/* ARMv8 common architectural and microarchitectural events */
+
+static const uint16_t g_arm64_pmu_events[PERF_COUNT_HW_MAX] =
+{
+  0x11,   /* CPU_CYCLES */
+  0x08,   /* INST_RETIRED */
+  0x04,   /* L1D_CACHE */
+  0x03,   /* L1D_CACHE_REFILL */
+  0x0c,   /* PC_WRITE_RETIRED */
+  0x10,   /* BR_MIS_PRED */
+};
+
+/* The event counters are only 32 bits wide.  Their overflow interrupt
+ * extends them to 64 bits in software, per CPU since each CPU has its own
+ * PMU.
+ */
+
+static uint64_t g_arm64_pmu_high[CONFIG_SMP_NCPUS][ARM64_PMU_NCOUNTERS];
+static cpu_set_t g_arm64_pmu_irqen;
+static bool g_arm64_pmu_attached;
+#endif
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+#ifdef CONFIG_PERF_EVENTS
+/****************************************************************************
+ * Name: arm64_pmu_overflow
+ *
+ * Description:
+ *   Account for the pending overflows of the event counters of this CPU in
+ *   'mask'.  Called with the interrupts disabled.
+ *
+ ****************************************************************************/
+
+static void arm64_pmu_overflow(uint64_t mask)
+{
+  FAR uint64_t *high = g_arm64_pmu_high[up_cpu_index()];
+  int counter;
+
+  mask &= read_sysreg(pmovsclr_el0) & ((1ul << ARM64_PMU_NCOUNTERS) - 1);
+  write_sysreg(mask, pmovsclr_el0);
+
+  for (counter = 0; mask != 0; counter++, mask >>= 1)
+    {
+      if (mask & 1)
+        {
+          high[counter] += ARM64_PMU_WRAP;
+        }
+    }
+}
+
+/****************************************************************************
+ * Name: arm64_pmu_interrupt
+ ****************************************************************************/
+
+static int arm64_pmu_interrupt(int irq, FAR void *context, FAR void *arg)
+{
+  arm64_pmu_overflow((1ul << ARM64_PMU_NCOUNTERS) - 1);
+  return OK;
+}
+#endif
 
 /****************************************************************************
  * Public Functions
  ****************************************************************************/
 
+#ifdef CONFIG_ARCH_PERF_EVENTS
 void up_perf_init(void *arg)
 {
   pmu_ccntr_ccfiltr_config(PMCCFILTR_EL0_NSH);
@@ -61,3 +153,66 @@ void up_perf_convert(unsigned long elapsed, struct timespec *ts)
   ts->tv_nsec = NSEC_PER_SEC * left / cpu_freq;
 }
 #endif
+
+#ifdef CONFIG_PERF_EVENTS
+int up_pmu_counters(void)
+{
+  return pmu_get_ncntrs();
+}
+
+int up_pmu_start(int counter, int event)
+{
+  if (event < 0 || event >= PERF_COUNT_HW_MAX)
+    {
+      return -ENOTSUP;
+    }
+
+  /* Route the overflow interrupt to this CPU the first time it is used */
+
+  if (!g_arm64_pmu_attached)
+    {
+      irq_attach(ARM64_PMU_IRQ, arm64_pmu_interrupt, NULL);
+      g_arm64_pmu_attached = true;
+    }
+
+  if (!CPU_ISSET(up_cpu_index(), &g_arm64_pmu_irqen))
+    {
+      CPU_SET(up_cpu_index(), &g_arm64_pmu_irqen);
+      up_enable_irq(ARM64_PMU_IRQ);
+    }
+
+  pmu_cntr_disable(1ul << counter);
+  pmu_evcntr_config(counter, g_arm64_pmu_events[event]);
+  pmu_set_evcntr(counter, 0);
+  write_sysreg(1ul << counter, pmovsclr_el0);
+  g_arm64_pmu_high[up_cpu_index()][counter] = 0;
+  pmu_cntr_irq_enable(1ul << counter);
+  write_sysreg(read_sysreg(pmcr_el0) | PMCR_EL0_E, pmcr_el0);
+  pmu_cntr_enable(1ul << counter);
+  return OK;
+}
+
+void up_pmu_stop(int counter)
+{
+  pmu_cntr_disable(1ul << counter);
+  pmu_cntr_irq_disable(1ul << counter);
+}
+
+uint64_t up_pmu_read(int counter)
+{
+  uint64_t value;
+
+  /* Take an overflow that is not handled yet into account, and read the
+   * counter again since it may have wrapped after the first read.
+   */
+
+  value = pmu_get_evcntr(counter) & UINT32_MAX;
+  if (read_sysreg(pmovsclr_el0) & (1ul << counter))
+    {
+      arm64_pmu_overflow(1ul << counter);
+      value = pmu_get_evcntr(counter) & UINT32_MAX;
+    }
+
+  return value + g_arm64_pmu_high[up_cpu_index()][counter];
+}
+#endif
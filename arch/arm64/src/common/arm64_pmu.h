@@ -54,6 +54,8 @@
 
 /* PMCR_EL0 */
 
+#define PMCR_EL0_N_SHIFT         (11)         /* Number of event counters */
+#define PMCR_EL0_N_MASK          (0x1ful << PMCR_EL0_N_SHIFT)
 #define PMCR_EL0_LC              (1ul << 6)   /* Long cycle counter enable */
 #define PMCR_EL0_DP              (1ul << 5)   /* Disable cycle counter when event counting is prohibited */
 #define PMCR_EL0_X               (1ul << 4)   /* Enable export of events */
@@ -190,6 +192,73 @@ static inline void pmu_cntr_enable(uint64_t mask)
   write_sysreg(mask, pmcntenset_el0);
 }
 
+/****************************************************************************
+ * Name: pmu_cntr_disable
+ *
+ * Description:
+ *   Disable counters.
+ *
+ * Parameters:
+ *   mask - Counters to disable.
+ *
+ ****************************************************************************/
+
+static inline void pmu_cntr_disable(uint64_t mask)
+{
+  write_sysreg(mask, pmcntenclr_el0);
+}
+
+/****************************************************************************
+ * Name: pmu_get_ncntrs
+ *
+ * Description:
+ *   Read the number of event counters implemented.
+ *
+ ****************************************************************************/
+
+static inline int pmu_get_ncntrs(void)
+{
+  return (read_sysreg(pmcr_el0) & PMCR_EL0_N_MASK) >> PMCR_EL0_N_SHIFT;
+}
+
+/****************************************************************************
+ * Name: pmu_evcntr_config
+ *
+ * Description:
+ *   Select the event counted by an event counter.
+ *
+ * Parameters:
+ *   counter - Event counter (0-30)
+ *   event   - Event number, counted at EL0 and EL1
+ *
+ ****************************************************************************/
+
+static inline void pmu_evcntr_config(int counter, uint64_t event)
+{
+  pmu_cntr_select(counter);
+  write_sysreg(event, pmxevtyper_el0);
+}
+
+/****************************************************************************
+ * Name: pmu_get_evcntr / pmu_set_evcntr
+ *
+ * Description:
+ *   Read or write an event counter.
+ *
+ ****************************************************************************/
+
+static inline uint64_t pmu_get_evcntr(int counter)
+{
+  pmu_cntr_select(counter);
+  return read_sysreg(pmxevcntr_el0);
+}
+
+static inline void pmu_set_evcntr(int counter, uint64_t value)
+{
+  pmu_cntr_select(counter);
+  write_sysreg(value, pmxevcntr_el0);
+}
+
 /****************************************************************************
  * Name: pmu_cntr_irq_enable
  *
@@ -632,6 +632,11 @@ extern "C"
 EXTERN volatile uintptr_t *g_current_regs[CONFIG_SMP_NCPUS];
 #define CURRENT_REGS (g_current_regs[up_cpu_index()])
 
+/* Return the PC of the given context or of the interrupted context */
+
+#define up_getusrpc(regs) \
+  (((FAR uintptr_t *)((regs) ? (regs) : CURRENT_REGS))[REG_EPC])
+
 /****************************************************************************
  * Public Function Prototypes
  ****************************************************************************/
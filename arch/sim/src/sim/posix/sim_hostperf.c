@@ -0,0 +1,147 @@
+/****************************************************************************
+ * arch/sim/src/sim/posix/sim_hostperf.c
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#define _GNU_SOURCE 1 /* For syscall() */
+
+#include <errno.h>
+#include <stdint.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <linux/perf_event.h>
+
+#include "sim_internal.h"
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+#ifdef CONFIG_SMP
+#  define HOST_PERF_NCPUS CONFIG_SMP_NCPUS
+#else
+#  define HOST_PERF_NCPUS 1
+#endif
+
+/****************************************************************************
+ * Private Types
+ ****************************************************************************/
+
+/* Each simulated CPU is a host thread.  A counter is a host perf event
+ * counting that thread, opened by the thread itself on first use and
+ * reopened when the counter is programmed with another event.
+ */
+
+struct host_perf_counter_s
+{
+  int fd;        /* Host perf event, 0 if not yet opened */
+  int event;     /* PERF_COUNT_HW_* counted by fd */
+};
+
+/****************************************************************************
+ * Private Data
+ ****************************************************************************/
+
+static struct host_perf_counter_s
+g_host_perf[HOST_PERF_NCPUS][SIM_PERF_NCOUNTERS];
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: host_perf_start
+ *
+ * Description:
+ *   Reset 'counter' of 'cpu' and start counting 'event'.  The NuttX
+ *   PERF_COUNT_HW_* numbering matches the Linux one.
+ *
+ ****************************************************************************/
+
+int host_perf_start(int cpu, int counter, int event)
+{
+  struct host_perf_counter_s *cntr = &g_host_perf[cpu][counter];
+  struct perf_event_attr attr;
+  int fd;
+
+  if (cntr->fd > 0 && cntr->event != event)
+    {
+      close(cntr->fd);
+      cntr->fd = 0;
+    }
+
+  if (cntr->fd <= 0)
+    {
+      memset(&attr, 0, sizeof(attr));
+      attr.type     = PERF_TYPE_HARDWARE;
+      attr.size     = sizeof(attr);
+      attr.config   = event;
+      attr.disabled = 1;
+
+      fd = syscall(__NR_perf_event_open, &attr, 0, -1, -1, 0);
+      if (fd < 0)
+        {
+          return -errno;
+        }
+
+      cntr->fd    = fd;
+      cntr->event = event;
+    }
+
+  ioctl(cntr->fd, PERF_EVENT_IOC_RESET, 0);
+  ioctl(cntr->fd, PERF_EVENT_IOC_ENABLE, 0);
+  return 0;
+}
+
+/****************************************************************************
+ * Name: host_perf_stop
+ ****************************************************************************/
+
+void host_perf_stop(int cpu, int counter)
+{
+  struct host_perf_counter_s *cntr = &g_host_perf[cpu][counter];
+
+  if (cntr->fd > 0)
+    {
+      ioctl(cntr->fd, PERF_EVENT_IOC_DISABLE, 0);
+    }
+}
+
+/****************************************************************************
+ * Name: host_perf_read
+ ****************************************************************************/
+
+uint64_t host_perf_read(int cpu, int counter)
+{
+  struct host_perf_counter_s *cntr = &g_host_perf[cpu][counter];
+  uint64_t value;
+
+  if (cntr->fd <= 0 ||
+      read(cntr->fd, &value, sizeof(value)) != sizeof(value))
+    {
+      return 0;
+    }
+
+  return value;
+}
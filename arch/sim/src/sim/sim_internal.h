@@ -94,6 +94,10 @@
 
 #define SIM_HEAP_SIZE (64*1024*1024)
 
+/* Number of host perf events backing the simulated PMU of each CPU */
+
+#define SIM_PERF_NCOUNTERS 4
+
 /* Macros to handle saving and restoring interrupt state ********************/
 
 #define sim_savestate(regs) sim_copyfullstate(regs, (xcpt_reg_t *)CURRENT_REGS)
@@ -235,6 +239,14 @@ void host_sleepuntil(uint64_t nsec);
 int host_timerirq(void);
 int host_settimer(uint64_t nsec);
 
+/* sim_hostperf.c ***********************************************************/
+
+#ifdef CONFIG_PERF_EVENTS
+int host_perf_start(int cpu, int counter, int event);
+void host_perf_stop(int cpu, int counter);
+uint64_t host_perf_read(int cpu, int counter);
+#endif
+
 /* sim_sigdeliver.c *********************************************************/
 
 void sim_sigdeliver(void);
@@ -0,0 +1,63 @@
+/****************************************************************************
+ * arch/sim/src/sim/sim_perf.c
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <stdint.h>
+#include <errno.h>
+
+#include <nuttx/arch.h>
+#include <nuttx/perf.h>
+
+#include "sim_internal.h"
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+int up_pmu_counters(void)
+{
+  return SIM_PERF_NCOUNTERS;
+}
+
+int up_pmu_start(int counter, int event)
+{
+  if (event < 0 || event >= PERF_COUNT_HW_MAX)
+    {
+      return -ENOTSUP;
+    }
+
+  return host_uninterruptible(host_perf_start, up_cpu_index(), counter,
+                              event);
+}
+
+void up_pmu_stop(int counter)
+{
+  host_uninterruptible_no_return(host_perf_stop, up_cpu_index(), counter);
+}
+
+uint64_t up_pmu_read(int counter)
+{
+  return host_uninterruptible(host_perf_read, up_cpu_index(), counter);
+}
@@ -142,6 +142,7 @@
 #  define X86_64_CPUID_01_TSCDEA (1 << 24)
 #  define X86_64_CPUID_01_XSAVE  (1 << 26)
 #  define X86_64_CPUID_01_RDRAND (1 << 30)
+#define X86_64_CPUID_PERFMON     0x0a
 #define X86_64_CPUID_TSC         0x15
 
 /* MSR Definitions */
@@ -156,6 +157,13 @@
 
 #define MSR_IA32_TSC_DEADLINE   0x6e0
 
+#define MSR_IA32_PMC0           0x0c1
+#define MSR_IA32_PERFEVTSEL0    0x186
+#  define MSR_IA32_PERFEVTSEL_USR (1 << 16)
+#  define MSR_IA32_PERFEVTSEL_OS  (1 << 17)
+#  define MSR_IA32_PERFEVTSEL_EN  (1 << 22)
+#define MSR_IA32_PERF_GLOBAL_CTRL 0x38f
+
 #define MSR_IA32_APIC_BASE      0x01b
 #  define MSR_IA32_APIC_EN      0x800
 #  define MSR_IA32_APIC_X2APIC  0x400
@@ -0,0 +1,141 @@
+/****************************************************************************
+ * arch/x86_64/src/intel64/intel64_pmu.c
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <stdint.h>
+#include <errno.h>
+
+#include <nuttx/arch.h>
+#include <nuttx/perf.h>
+
+#include "x86_64_internal.h"
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+/* Architectural performance monitoring, CPUID leaf 0x0a */
+
+#define PERFMON_VERSION(eax)   ((eax) & 0xff)
+#define PERFMON_NCOUNTERS(eax) (((eax) >> 8) & 0xff)
+
+/* Architectural events, as UMask << 8 | EventSelect */
+
+#define PERFMON_EVENT(umask, event) (((umask) << 8) | (event))
+
+/****************************************************************************
+ * Private Data
+ ****************************************************************************/
+
+static const uint16_t g_intel64_pmu_events[PERF_COUNT_HW_MAX] =
+{
+  PERFMON_EVENT(0x00, 0x3c),   /* UnHalted Core Cycles */
+  PERFMON_EVENT(0x00, 0xc0),   /* Instruction Retired */
+  PERFMON_EVENT(0x4f, 0x2e),   /* LLC Reference */
+  PERFMON_EVENT(0x41, 0x2e),   /* LLC Misses */
+  PERFMON_EVENT(0x00, 0xc4),   /* Branch Instruction Retired */
+  PERFMON_EVENT(0x00, 0xc5),   /* Branch Misses Retired */
+};
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: intel64_pmu_cpuid
+ ****************************************************************************/
+
+static uint32_t intel64_pmu_cpuid(void)
+{
+  unsigned long eax;
+
+  asm volatile("cpuid" : "=a" (eax) : "a" (X86_64_CPUID_PERFMON), "c" (0)
+               : "rbx", "rdx", "memory");
+
+  return eax;
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: up_pmu_counters
+ ****************************************************************************/
+
+int up_pmu_counters(void)
+{
+  uint32_t eax = intel64_pmu_cpuid();
+
+  return PERFMON_VERSION(eax) > 0 ? PERFMON_NCOUNTERS(eax) : 0;
+}
+
+/****************************************************************************
+ * Name: up_pmu_start
+ ****************************************************************************/
+
+int up_pmu_start(int counter, int event)
+{
+  uint32_t eax = intel64_pmu_cpuid();
+
+  if (event < 0 || event >= PERF_COUNT_HW_MAX)
+    {
+      return -ENOTSUP;
+    }
+
+  write_msr(MSR_IA32_PERFEVTSEL0 + counter, 0);
+  write_msr(MSR_IA32_PMC0 + counter, 0);
+  write_msr(MSR_IA32_PERFEVTSEL0 + counter,
+            g_intel64_pmu_events[event] | MSR_IA32_PERFEVTSEL_USR |
+            MSR_IA32_PERFEVTSEL_OS | MSR_IA32_PERFEVTSEL_EN);
+
+  /* Version 2 and later also gate each counter globally */
+
+  if (PERFMON_VERSION(eax) >= 2)
+    {
+      write_msr(MSR_IA32_PERF_GLOBAL_CTRL,
+                read_msr(MSR_IA32_PERF_GLOBAL_CTRL) | (1ul << counter));
+    }
+
+  return OK;
+}
+
+/****************************************************************************
+ * Name: up_pmu_stop
+ ****************************************************************************/
+
+void up_pmu_stop(int counter)
+{
+  write_msr(MSR_IA32_PERFEVTSEL0 + counter, 0);
+}
+
+/****************************************************************************
+ * Name: up_pmu_read
+ ****************************************************************************/
+
+uint64_t up_pmu_read(int counter)
+{
+  return read_msr(MSR_IA32_PMC0 + counter);
+}
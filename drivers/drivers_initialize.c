@@ -36,6 +36,7 @@
 #include <nuttx/net/tun.h>
 #include <nuttx/net/telnet.h>
 #include <nuttx/note/note_driver.h>
+#include <nuttx/perf.h>
 #include <nuttx/power/pm.h>
 #include <nuttx/power/regulator.h>
 #include <nuttx/segger/rtt.h>
@@ -102,10 +103,18 @@ void drivers_initialize(void)
   devascii_register();  /* Non-standard /dev/ascii */
 #endif
 
+#if defined(CONFIG_DEV_PROFILE)
+  devprofile_register(); /* Non-standard /dev/profile */
+#endif
+
 #if defined(CONFIG_DRIVERS_NOTE)
   note_initialize();    /* Non-standard /dev/note */
 #endif
 
+#if defined(CONFIG_PERF_EVENTS)
+  perf_event_register(); /* Non-standard /dev/perf */
+#endif
+
 #if defined(CONFIG_CLK_RPMSG)
   clk_rpmsg_server_initialize();
 #endif
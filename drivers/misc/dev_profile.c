@@ -0,0 +1,419 @@
+/****************************************************************************
+ * drivers/misc/dev_profile.c
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <sys/types.h>
+#include <sys/param.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+#include <errno.h>
+
+#include <nuttx/arch.h>
+#include <nuttx/clock.h>
+#include <nuttx/wdog.h>
+#include <nuttx/spinlock.h>
+#include <nuttx/fs/fs.h>
+#include <nuttx/drivers/drivers.h>
+#include <nuttx/drivers/profile.h>
+
+#include "sched/sched.h"
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+#define NCPUS CONFIG_SMP_NCPUS
+
+#if CONFIG_DEV_PROFILE_DEPTH > 1 && defined(CONFIG_ARCH_HAVE_BACKTRACE)
+#  define PROFILE_BACKTRACE
+#endif
+
+/* Frames of the interrupt handler that may precede the interrupted PC in
+ * the output of up_backtrace().
+ */
+
+#define PROFILE_SKIP            8
+
+/* Number of words of the header, sample record overhead and trailer */
+
+#define PROFILE_HEADER_WORDS    5
+#define PROFILE_SAMPLE_WORDS    2
+#define PROFILE_TRAILER_WORDS   3
+
+/* Read state of an open file, kept in f_priv */
+
+#define PROFILE_STATE_HEADER    0
+#define PROFILE_STATE_SAMPLES   1
+#define PROFILE_STATE_DONE      2
+
+/****************************************************************************
+ * Private Types
+ ****************************************************************************/
+
+struct profile_sample_s
+{
+  uint8_t   depth;                             /* Number of valid entries */
+  uintptr_t pc[CONFIG_DEV_PROFILE_DEPTH];      /* PC, caller, ... */
+};
+
+/* One ring per CPU, so that a CPU never overwrites the samples of
+ * another.  head == tail means the ring is empty.
+ */
+
+struct profile_ring_s
+{
+  unsigned int head;                           /* Next slot to fill */
+  unsigned int tail;                           /* Oldest unread sample */
+  struct profile_sample_s samples[CONFIG_DEV_PROFILE_NSAMPLES];
+};
+
+struct profile_dev_s
+{
+  struct wdog_s wdog;                          /* Sampling timer */
+  spinlock_t    lock;                          /* Protects the rings */
+  bool          running;                       /* Sampling is active */
+  sclock_t      period;                        /* Sampling period in ticks */
+  unsigned long dropped;                       /* Samples lost to full rings */
+  struct profile_ring_s ring[NCPUS];
+};
+
+/****************************************************************************
+ * Private Function Prototypes
+ ****************************************************************************/
+
+static ssize_t profile_read(FAR struct file *filep, FAR char *buffer,
+                            size_t buflen);
+static int profile_ioctl(FAR struct file *filep, int cmd,
+                         unsigned long arg);
+
+/****************************************************************************
+ * Private Data
+ ****************************************************************************/
+
+static const struct file_operations g_profile_fops =
+{
+  NULL,           /* open */
+  NULL,           /* close */
+  profile_read,   /* read */
+  NULL,           /* write */
+  NULL,           /* seek */
+  profile_ioctl,  /* ioctl */
+};
+
+static struct profile_dev_s g_profile;
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: profile_next
+ ****************************************************************************/
+
+static inline unsigned int profile_next(unsigned int index)
+{
+  return ++index >= CONFIG_DEV_PROFILE_NSAMPLES ? 0 : index;
+}
+
+/****************************************************************************
+ * Name: profile_backtrace
+ *
+ * Description:
+ *   Record the PC of the interrupted context and, if configured, its
+ *   callers.
+ *
+ ****************************************************************************/
+
+static void profile_backtrace(FAR struct profile_sample_s *sample)
+{
+  uintptr_t pc = up_getusrpc(NULL);
+#ifdef PROFILE_BACKTRACE
+  FAR void *frames[CONFIG_DEV_PROFILE_DEPTH + PROFILE_SKIP];
+  int nframes;
+  int i;
+
+  /* The backtrace taken from interrupt context starts with the frames of
+   * the interrupt handler.  The interrupted code starts at its PC.
+   */
+
+  nframes = up_backtrace(NULL, frames, nitems(frames), 0);
+  for (i = 0; i < nframes; i++)
+    {
+      if ((uintptr_t)frames[i] == pc)
+        {
+          nframes -= i;
+          if (nframes > CONFIG_DEV_PROFILE_DEPTH)
+            {
+              nframes = CONFIG_DEV_PROFILE_DEPTH;
+            }
+
+          memcpy(sample->pc, &frames[i], nframes * sizeof(uintptr_t));
+          sample->depth = nframes;
+          return;
+        }
+    }
+#endif
+
+  sample->pc[0] = pc;
+  sample->depth = 1;
+}
+
+/****************************************************************************
+ * Name: profile_sample
+ *
+ * Description:
+ *   Watchdog handler, runs in the context of the timer interrupt.
+ *
+ ****************************************************************************/
+
+static void profile_sample(wdparm_t arg)
+{
+  FAR struct profile_dev_s *dev = (FAR struct profile_dev_s *)arg;
+  FAR struct profile_ring_s *ring;
+  irqstate_t flags;
+  unsigned int next;
+  bool running;
+
+  flags = spin_lock_irqsave(&dev->lock);
+
+  ring = &dev->ring[this_cpu()];
+  next = profile_next(ring->head);
+  if (next == ring->tail)
+    {
+      dev->dropped++;
+    }
+  else
+    {
+      profile_backtrace(&ring->samples[ring->head]);
+      ring->head = next;
+    }
+
+  running = dev->running;
+  spin_unlock_irqrestore(&dev->lock, flags);
+
+  if (running)
+    {
+      wd_start(&dev->wdog, dev->period, profile_sample, arg);
+    }
+}
+
+/****************************************************************************
+ * Name: profile_pop
+ *
+ * Description:
+ *   Move the oldest sample of any CPU into 'words' as a pprof record.
+ *
+ * Returned Value:
+ *   The number of words written; 0 if there are no more samples; a
+ *   negated errno value if the next sample does not fit.
+ *
+ ****************************************************************************/
+
+static int profile_pop(FAR struct profile_dev_s *dev, FAR uintptr_t *words,
+                       size_t nwords)
+{
+  FAR struct profile_ring_s *ring;
+  FAR struct profile_sample_s *sample;
+  irqstate_t flags;
+  int ret = 0;
+  int cpu;
+
+  flags = spin_lock_irqsave(&dev->lock);
+
+  for (cpu = 0; cpu < NCPUS; cpu++)
+    {
+      ring = &dev->ring[cpu];
+      if (ring->tail == ring->head)
+        {
+          continue;
+        }
+
+      sample = &ring->samples[ring->tail];
+      if (PROFILE_SAMPLE_WORDS + sample->depth > nwords)
+        {
+          ret = -ENOSPC;
+          break;
+        }
+
+      words[0] = 1;
+      words[1] = sample->depth;
+      memcpy(&words[PROFILE_SAMPLE_WORDS], sample->pc,
+             sample->depth * sizeof(uintptr_t));
+
+      ring->tail = profile_next(ring->tail);
+      ret = PROFILE_SAMPLE_WORDS + sample->depth;
+      break;
+    }
+
+  spin_unlock_irqrestore(&dev->lock, flags);
+  return ret;
+}
+
+/****************************************************************************
+ * Name: profile_read
+ ****************************************************************************/
+
+static ssize_t profile_read(FAR struct file *filep, FAR char *buffer,
+                            size_t buflen)
+{
+  FAR struct profile_dev_s *dev = filep->f_inode->i_private;
+  FAR uintptr_t *words = (FAR uintptr_t *)buffer;
+  size_t nwords = buflen / sizeof(uintptr_t);
+  uintptr_t state = (uintptr_t)filep->f_priv;
+  size_t n = 0;
+  int ret;
+
+  if (state == PROFILE_STATE_DONE)
+    {
+      return 0;
+    }
+
+  if (state == PROFILE_STATE_HEADER)
+    {
+      if (nwords < PROFILE_HEADER_WORDS)
+        {
+          return -EINVAL;
+        }
+
+      words[n++] = 0;
+      words[n++] = 3;
+      words[n++] = 0;
+      words[n++] = TICK2USEC(dev->period);
+      words[n++] = 0;
+      state = PROFILE_STATE_SAMPLES;
+    }
+
+  while ((ret = profile_pop(dev, &words[n], nwords - n)) > 0)
+    {
+      n += ret;
+    }
+
+  /* Terminate the profile once all the samples are out */
+
+  if (ret == 0 && n + PROFILE_TRAILER_WORDS <= nwords)
+    {
+      words[n++] = 0;
+      words[n++] = 1;
+      words[n++] = 0;
+      state = PROFILE_STATE_DONE;
+    }
+
+  if (n == 0)
+    {
+      return -EINVAL;
+    }
+
+  filep->f_priv = (FAR void *)state;
+  filep->f_pos += n * sizeof(uintptr_t);
+  return n * sizeof(uintptr_t);
+}
+
+/****************************************************************************
+ * Name: profile_ioctl
+ ****************************************************************************/
+
+static int profile_ioctl(FAR struct file *filep, int cmd,
+                         unsigned long arg)
+{
+  FAR struct profile_dev_s *dev = filep->f_inode->i_private;
+  irqstate_t flags;
+  int ret = OK;
+  int cpu;
+
+  switch (cmd)
+    {
+      case PROFIOC_START:
+        if (arg == 0)
+          {
+            arg = CONFIG_DEV_PROFILE_FREQUENCY;
+          }
+
+        if (arg > TICK_PER_SEC)
+          {
+            return -EINVAL;
+          }
+
+        wd_cancel(&dev->wdog);
+
+        flags = spin_lock_irqsave(&dev->lock);
+        for (cpu = 0; cpu < NCPUS; cpu++)
+          {
+            dev->ring[cpu].head = 0;
+            dev->ring[cpu].tail = 0;
+          }
+
+        dev->dropped = 0;
+        dev->period  = TICK_PER_SEC / arg;
+        dev->running = true;
+        spin_unlock_irqrestore(&dev->lock, flags);
+
+        ret = wd_start(&dev->wdog, dev->period, profile_sample,
+                       (wdparm_t)dev);
+        break;
+
+      case PROFIOC_STOP:
+        flags = spin_lock_irqsave(&dev->lock);
+        dev->running = false;
+        spin_unlock_irqrestore(&dev->lock, flags);
+
+        wd_cancel(&dev->wdog);
+        break;
+
+      case PROFIOC_GETDROPPED:
+        if (arg == 0)
+          {
+            return -EINVAL;
+          }
+
+        *(FAR unsigned long *)((uintptr_t)arg) = dev->dropped;
+        break;
+
+      default:
+        ret = -ENOTTY;
+        break;
+    }
+
+  return ret;
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: devprofile_register
+ *
+ * Description:
+ *   Register /dev/profile
+ *
+ ****************************************************************************/
+
+void devprofile_register(void)
+{
+  spin_lock_init(&g_profile.lock);
+  g_profile.period = TICK_PER_SEC / CONFIG_DEV_PROFILE_FREQUENCY;
+  register_driver("/dev/profile", &g_profile_fops, 0444, &g_profile);
+}
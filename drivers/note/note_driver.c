@@ -49,6 +49,37 @@
 #  error "Maximum channel number exceeds. "
 #endif
 
+/* This file provides the hooks that sched_note.h guards with static keys */
+
+#undef sched_note_suspend
+#undef sched_note_resume
+#undef sched_note_premption
+#undef sched_note_csection
+#undef sched_note_spinlock
+#undef sched_note_syscall_enter
+#undef sched_note_syscall_leave
+#undef sched_note_irqhandler
+
+/* Mode flags that enable each static key */
+
+#define NOTE_KEY_FLAGS         NOTE_FILTER_MODE_FLAG_ENABLE
+#define NOTE_SWITCH_KEY_FLAGS  (NOTE_FILTER_MODE_FLAG_ENABLE | \
+                                NOTE_FILTER_MODE_FLAG_SWITCH)
+#define NOTE_SYSCALL_KEY_FLAGS (NOTE_FILTER_MODE_FLAG_ENABLE | \
+                                NOTE_FILTER_MODE_FLAG_SYSCALL)
+#define NOTE_DUMP_KEY_FLAGS    (NOTE_FILTER_MODE_FLAG_ENABLE | \
+                                NOTE_FILTER_MODE_FLAG_DUMP)
+
+/* The IRQ hooks also keep track of the interrupt handlers whose system
+ * calls are not traced, so they run if either is traced.
+ */
+
+#define NOTE_IRQ_KEY_ENABLED(flag) \
+  (((flag) & NOTE_FILTER_MODE_FLAG_ENABLE) != 0 && \
+   ((flag) & (NOTE_FILTER_MODE_FLAG_IRQ | NOTE_FILTER_MODE_FLAG_SYSCALL)) != 0)
+
+#define NOTE_KEY_ENABLED(flag, keyflags) (((flag) & (keyflags)) == (keyflags))
+
 #define note_add(drv, note, notelen)                                         \
   ((drv)->ops->add(drv, note, notelen))
 #define note_start(drv, tcb)                                                 \
@@ -186,6 +217,49 @@ static struct note_taskname_s g_note_taskname;
 static spinlock_t g_note_lock;
 #endif
 
+/****************************************************************************
+ * Public Data
+ ****************************************************************************/
+
+#ifdef CONFIG_SCHED_INSTRUMENTATION_FILTER
+struct static_key_s g_note_key =
+{
+  NOTE_KEY_ENABLED(CONFIG_SCHED_INSTRUMENTATION_FILTER_DEFAULT_MODE,
+                   NOTE_KEY_FLAGS)
+};
+
+#ifdef CONFIG_SCHED_INSTRUMENTATION_SWITCH
+struct static_key_s g_note_switch_key =
+{
+  NOTE_KEY_ENABLED(CONFIG_SCHED_INSTRUMENTATION_FILTER_DEFAULT_MODE,
+                   NOTE_SWITCH_KEY_FLAGS)
+};
+#endif
+
+#ifdef CONFIG_SCHED_INSTRUMENTATION_SYSCALL
+struct static_key_s g_note_syscall_key =
+{
+  NOTE_KEY_ENABLED(CONFIG_SCHED_INSTRUMENTATION_FILTER_DEFAULT_MODE,
+                   NOTE_SYSCALL_KEY_FLAGS)
+};
+#endif
+
+#ifdef CONFIG_SCHED_INSTRUMENTATION_IRQHANDLER
+struct static_key_s g_note_irq_key =
+{
+  NOTE_IRQ_KEY_ENABLED(CONFIG_SCHED_INSTRUMENTATION_FILTER_DEFAULT_MODE)
+};
+#endif
+
+#ifdef CONFIG_SCHED_INSTRUMENTATION_DUMP
+struct static_key_s g_note_dump_key =
+{
+  NOTE_KEY_ENABLED(CONFIG_SCHED_INSTRUMENTATION_FILTER_DEFAULT_MODE,
+                   NOTE_DUMP_KEY_FLAGS)
+};
+#endif
+#endif
+
 /****************************************************************************
  * Private Functions
  ****************************************************************************/
@@ -240,6 +314,43 @@ static void note_common(FAR struct tcb_s *tcb,
   note->nc_systime_nsec = ts.tv_nsec;
 }
 
+/****************************************************************************
+ * Name: note_update_keys
+ *
+ * Description:
+ *   Update the static keys of the note hooks after a change of the filter
+ *   mode.
+ *
+ * Input Parameters:
+ *   flag - The new filter mode flags
+ *
+ * Returned Value:
+ *   None
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_SCHED_INSTRUMENTATION_FILTER
+static void note_update_keys(unsigned int flag)
+{
+  static_key_set(&g_note_key, NOTE_KEY_ENABLED(flag, NOTE_KEY_FLAGS));
+#ifdef CONFIG_SCHED_INSTRUMENTATION_SWITCH
+  static_key_set(&g_note_switch_key,
+                 NOTE_KEY_ENABLED(flag, NOTE_SWITCH_KEY_FLAGS));
+#endif
+#ifdef CONFIG_SCHED_INSTRUMENTATION_SYSCALL
+  static_key_set(&g_note_syscall_key,
+                 NOTE_KEY_ENABLED(flag, NOTE_SYSCALL_KEY_FLAGS));
+#endif
+#ifdef CONFIG_SCHED_INSTRUMENTATION_IRQHANDLER
+  static_key_set(&g_note_irq_key, NOTE_IRQ_KEY_ENABLED(flag));
+#endif
+#ifdef CONFIG_SCHED_INSTRUMENTATION_DUMP
+  static_key_set(&g_note_dump_key,
+                 NOTE_KEY_ENABLED(flag, NOTE_DUMP_KEY_FLAGS));
+#endif
+}
+#endif
+
 /****************************************************************************
  * Name: note_isenabled
  *
@@ -1742,6 +1853,7 @@ void sched_note_filter_mode(FAR struct note_filter_mode_s *oldm,
   if (newm != NULL)
     {
       g_note_filter.mode = *newm;
+      note_update_keys(newm->flag);
     }
 
   spin_unlock_irqrestore_wo_note(&g_note_lock, irq_mask);
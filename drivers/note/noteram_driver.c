@@ -29,6 +29,7 @@
 #include <fcntl.h>
 #include <assert.h>
 #include <errno.h>
+#include <limits.h>
 #include <stdio.h>
 #include <string.h>
 
@@ -42,6 +43,8 @@
 #include <nuttx/fs/fs.h>
 #include <nuttx/streams.h>
 
+#include "sched/sched.h"
+
 #ifdef CONFIG_SCHED_INSTRUMENTATION_SYSCALL
 #  ifdef CONFIG_LIB_SYSCALL
 #    include <syscall.h>
@@ -68,20 +71,44 @@
 #define get_task_state(s)                                                    \
   ((s) == 0 ? 'X' : ((s) <= LAST_READY_TO_RUN_STATE ? 'R' : 'S'))
 
+/* The buffer is split into one ring per CPU.  The ring indices run freely
+ * up to NOTERAM_LIMIT(), a multiple of the ring size, so that a full ring
+ * can be told apart from an empty one and a reader can tell that the
+ * producer has overtaken it.
+ */
+
+#define NOTERAM_RINGSIZE(s) ((s) / NCPUS)
+#define NOTERAM_LIMIT(s)    ((UINT_MAX / 2 / NOTERAM_RINGSIZE(s)) * \
+                             NOTERAM_RINGSIZE(s))
+
 /****************************************************************************
  * Private Types
  ****************************************************************************/
 
+/* One single producer ring per CPU.  Only the owning CPU, with local
+ * interrupts disabled, moves nr_head and nr_tail.  Readers never write
+ * them: they clear the ring by raising nr_floor and detect notes that
+ * were overwritten while being copied by re-checking nr_tail afterwards.
+ */
+
+struct noteram_ring_s
+{
+  volatile unsigned int nr_head;  /* End of the newest note */
+  volatile unsigned int nr_tail;  /* Start of the oldest note */
+  volatile unsigned int nr_floor; /* Notes before this one are cleared */
+  unsigned int nr_read;           /* Next note to be read */
+};
+
 struct noteram_driver_s
 {
   struct note_driver_s driver;
   FAR uint8_t *ni_buffer;
   size_t ni_bufsize;
   unsigned int ni_overwrite;
-  volatile unsigned int ni_head;
-  volatile unsigned int ni_tail;
-  volatile unsigned int ni_read;
-  spinlock_t lock;
+  size_t ni_ringsize;
+  unsigned int ni_limit;
+  spinlock_t lock;                /* Serializes the readers */
+  struct noteram_ring_s ni_ring[NCPUS];
 };
 
 /* The structure to hold the context data of trace dump */
@@ -100,6 +127,7 @@ struct noteram_dump_cpu_context_s
 struct noteram_dump_context_s
 {
   struct noteram_dump_cpu_context_s cpu[NCPUS];
+  unsigned int mode;        /* See NOTERAM_MODE_READ_* */
 };
 
 /****************************************************************************
@@ -149,10 +177,12 @@ struct noteram_driver_s g_noteram_driver =
   g_ramnote_buffer,
   CONFIG_DRIVERS_NOTERAM_BUFSIZE,
 #ifdef CONFIG_DRIVERS_NOTERAM_DEFAULT_NOOVERWRITE
-  NOTERAM_MODE_OVERWRITE_DISABLE
+  NOTERAM_MODE_OVERWRITE_DISABLE,
 #else
-  NOTERAM_MODE_OVERWRITE_ENABLE
+  NOTERAM_MODE_OVERWRITE_ENABLE,
 #endif
+  NOTERAM_RINGSIZE(CONFIG_DRIVERS_NOTERAM_BUFSIZE),
+  NOTERAM_LIMIT(CONFIG_DRIVERS_NOTERAM_BUFSIZE)
 };
 
 /****************************************************************************
@@ -160,167 +190,236 @@ struct noteram_driver_s g_noteram_driver =
  ****************************************************************************/
 
 /****************************************************************************
- * Name: noteram_buffer_clear
+ * Name: noteram_next
  *
  * Description:
- *   Clear all contents of the circular buffer.
+ *   Return the ring index at offset from the specified index value,
+ *   handling wraparound
  *
  * Input Parameters:
- *   None.
+ *   ndx    - Old ring index
+ *   offset - Offset to add
  *
  * Returned Value:
- *   None.
+ *   New ring index
  *
  ****************************************************************************/
 
-static void noteram_buffer_clear(FAR struct noteram_driver_s *drv)
+static inline unsigned int noteram_next(FAR struct noteram_driver_s *drv,
+                                        unsigned int ndx,
+                                        unsigned int offset)
 {
-  drv->ni_tail = drv->ni_head;
-  drv->ni_read = drv->ni_head;
-
-  if (drv->ni_overwrite == NOTERAM_MODE_OVERWRITE_OVERFLOW)
+  ndx += offset;
+  if (ndx >= drv->ni_limit)
     {
-      drv->ni_overwrite = NOTERAM_MODE_OVERWRITE_DISABLE;
+      ndx -= drv->ni_limit;
     }
+
+  return ndx;
 }
 
 /****************************************************************************
- * Name: noteram_next
+ * Name: noteram_distance
  *
  * Description:
- *   Return the circular buffer index at offset from the specified index
- *   value, handling wraparound
+ *   Return the number of bytes from ring index 'from' up to ring index
+ *   'to'.
  *
- * Input Parameters:
- *   ndx - Old circular buffer index
+ ****************************************************************************/
+
+static inline unsigned int
+noteram_distance(FAR struct noteram_driver_s *drv, unsigned int from,
+                 unsigned int to)
+{
+  return to >= from ? to - from : to + drv->ni_limit - from;
+}
+
+/****************************************************************************
+ * Name: noteram_tail
  *
- * Returned Value:
- *   New circular buffer index
+ * Description:
+ *   Return the index of the oldest note in the ring that has not been
+ *   cleared, i.e. the later one of nr_tail and nr_floor.
  *
  ****************************************************************************/
 
-static inline unsigned int noteram_next(FAR struct noteram_driver_s *drv,
-                                        unsigned int ndx,
-                                        unsigned int offset)
+static unsigned int noteram_tail(FAR struct noteram_driver_s *drv,
+                                 FAR struct noteram_ring_s *ring,
+                                 unsigned int head)
 {
-  ndx += offset;
-  if (ndx >= drv->ni_bufsize)
+  unsigned int floor = ring->nr_floor;
+  unsigned int tail = ring->nr_tail;
+
+  if (noteram_distance(drv, floor, head) <
+      noteram_distance(drv, tail, head))
     {
-      ndx -= drv->ni_bufsize;
+      tail = floor;
     }
 
-  return ndx;
+  return tail;
 }
 
 /****************************************************************************
- * Name: noteram_length
+ * Name: noteram_buffer_clear
  *
  * Description:
- *   Length of data currently in circular buffer.
+ *   Clear all contents of the circular buffers.
  *
  * Input Parameters:
- *   None
+ *   None.
  *
  * Returned Value:
- *   Length of data currently in circular buffer.
+ *   None.
  *
  ****************************************************************************/
 
-static unsigned int noteram_length(FAR struct noteram_driver_s *drv)
+static void noteram_buffer_clear(FAR struct noteram_driver_s *drv)
 {
-  unsigned int head = drv->ni_head;
-  unsigned int tail = drv->ni_tail;
+  int cpu;
 
-  if (tail > head)
+  for (cpu = 0; cpu < NCPUS; cpu++)
     {
-      head += drv->ni_bufsize;
+      FAR struct noteram_ring_s *ring = &drv->ni_ring[cpu];
+      unsigned int head = ring->nr_head;
+
+      ring->nr_floor = head;
+      ring->nr_read  = head;
     }
 
-  return head - tail;
+  if (drv->ni_overwrite == NOTERAM_MODE_OVERWRITE_OVERFLOW)
+    {
+      drv->ni_overwrite = NOTERAM_MODE_OVERWRITE_DISABLE;
+    }
 }
 
 /****************************************************************************
- * Name: noteram_unread_length
+ * Name: noteram_buffer_rewind
  *
  * Description:
- *   Length of unread data currently in circular buffer.
- *
- * Input Parameters:
- *   None
- *
- * Returned Value:
- *   Length of unread data currently in circular buffer.
+ *   Move the read index of all rings back to the oldest note.
  *
  ****************************************************************************/
 
-static unsigned int noteram_unread_length(FAR struct noteram_driver_s *drv)
+static void noteram_buffer_rewind(FAR struct noteram_driver_s *drv)
 {
-  unsigned int head = drv->ni_head;
-  unsigned int read = drv->ni_read;
+  int cpu;
 
-  if (read > head)
+  for (cpu = 0; cpu < NCPUS; cpu++)
     {
-      head += drv->ni_bufsize;
-    }
+      FAR struct noteram_ring_s *ring = &drv->ni_ring[cpu];
 
-  return head - read;
+      ring->nr_read = noteram_tail(drv, ring, ring->nr_head);
+    }
 }
 
 /****************************************************************************
- * Name: noteram_remove
+ * Name: noteram_copy
  *
  * Description:
- *   Remove the variable length note from the tail of the circular buffer
+ *   Copy the note at the read index of the ring of one CPU.  The producer
+ *   never waits for the reader, so the note may be overwritten while it
+ *   is copied.  This is detected by checking that the tail did not pass
+ *   the read index after the copy, in which case the copy is retried from
+ *   the new tail.
  *
  * Input Parameters:
- *   None
+ *   cpu     - The CPU whose ring is read
+ *   buffer  - Location to return the note
+ *   buflen  - The length of the buffer.  Only the start of the note is
+ *             returned if the buffer is shorter than the note.
+ *   consume - Advance the read index past the note
+ *   skip    - Also advance past a note that does not fit the buffer
  *
  * Returned Value:
- *   None
- *
- * Assumptions:
- *   We are within a critical section.
+ *   The full length of the note; zero if the ring is empty.  -EFBIG if
+ *   the note was to be consumed but the buffer cannot hold it.
  *
  ****************************************************************************/
 
-static void noteram_remove(FAR struct noteram_driver_s *drv)
+static ssize_t noteram_copy(FAR struct noteram_driver_s *drv, int cpu,
+                            FAR uint8_t *buffer, size_t buflen,
+                            bool consume, bool skip)
 {
+  FAR struct noteram_ring_s *ring = &drv->ni_ring[cpu];
+  FAR uint8_t *data = drv->ni_buffer + cpu * drv->ni_ringsize;
+  unsigned int offset;
+  unsigned int space;
+  unsigned int head;
   unsigned int tail;
-  unsigned int length;
+  unsigned int read;
+  size_t notelen;
+  size_t ncopy;
 
-  /* Get the tail index of the circular buffer */
+  for (; ; )
+    {
+      head = ring->nr_head;
+      SP_DMB();
 
-  tail = drv->ni_tail;
-  DEBUGASSERT(tail < drv->ni_bufsize);
+      /* Skip the notes which were overwritten or cleared */
 
-  /* Get the length of the note at the tail index */
+      tail = noteram_tail(drv, ring, head);
+      read = ring->nr_read;
+      if (noteram_distance(drv, tail, read) >
+          noteram_distance(drv, tail, head))
+        {
+          read = tail;
+        }
 
-  length = drv->ni_buffer[tail];
-  DEBUGASSERT(length <= noteram_length(drv));
+      if (read == head)
+        {
+          ring->nr_read = read;
+          return 0;
+        }
 
-  /* Increment the tail index to remove the entire note from the circular
-   * buffer.
-   */
+      offset  = read % drv->ni_ringsize;
+      notelen = data[offset];
+      ncopy   = notelen < buflen ? notelen : buflen;
+      space   = drv->ni_ringsize - offset;
+      space   = space < ncopy ? space : ncopy;
+      memcpy(buffer, data + offset, space);
+      memcpy(buffer + space, data, ncopy - space);
 
-  if (drv->ni_read == drv->ni_tail)
-    {
-      /* The read index also needs increment. */
+      /* Was the note overwritten while we were copying it? */
 
-      drv->ni_read = noteram_next(drv, tail, length);
+      SP_DMB();
+      tail = noteram_tail(drv, ring, ring->nr_head);
+      if (noteram_distance(drv, tail, read) <= drv->ni_ringsize)
+        {
+          break;
+        }
+
+      ring->nr_read = tail;
     }
 
-  drv->ni_tail = noteram_next(drv, tail, length);
+  DEBUGASSERT(notelen >= sizeof(struct note_common_s) &&
+              notelen <= noteram_distance(drv, read, head));
+
+  if (consume && (buflen >= notelen || skip))
+    {
+      ring->nr_read = noteram_next(drv, read, notelen);
+    }
+  else
+    {
+      ring->nr_read = read;
+    }
+
+  /* A large note is skipped so that we do not get constipated. */
+
+  return consume && buflen < notelen ? -EFBIG : (ssize_t)notelen;
 }
 
 /****************************************************************************
  * Name: noteram_get
  *
  * Description:
- *   Get the next note from the read index of the circular buffer.
+ *   Get the oldest unread note of all CPUs.  The rings are merged by the
+ *   time stamp of their next note.
  *
  * Input Parameters:
  *   buffer - Location to return the next note
  *   buflen - The length of the user provided buffer.
+ *   skip   - Drop the note if it does not fit the buffer.  Otherwise it
+ *            is left in the buffer.
  *
  * Returned Value:
  *   On success, the positive, non-zero length of the return note is
@@ -330,66 +429,39 @@ static void noteram_remove(FAR struct noteram_driver_s *drv)
  ****************************************************************************/
 
 static ssize_t noteram_get(FAR struct noteram_driver_s *drv,
-                           FAR uint8_t *buffer, size_t buflen)
+                           FAR uint8_t *buffer, size_t buflen, bool skip)
 {
-  FAR struct note_common_s *note;
-  unsigned int remaining;
-  unsigned int read;
-  ssize_t notelen;
-  size_t circlen;
+  struct note_common_s oldest;
+  struct note_common_s note;
+  int found = -1;
+  int cpu;
 
   DEBUGASSERT(buffer != NULL);
 
-  /* Verify that the circular buffer is not empty */
-
-  circlen = noteram_unread_length(drv);
-  if (circlen <= 0)
-    {
-      return 0;
-    }
-
-  /* Get the read index of the circular buffer */
-
-  read = drv->ni_read;
-  DEBUGASSERT(read < drv->ni_bufsize);
-
-  /* Get the length of the note at the read index */
-
-  note = (FAR struct note_common_s *)&drv->ni_buffer[read];
-  notelen = note->nc_length;
-  DEBUGASSERT(notelen <= circlen);
-
-  /* Is the user buffer large enough to hold the note? */
-
-  if (buflen < notelen)
+  for (cpu = 0; cpu < NCPUS; cpu++)
     {
-      /* Skip the large note so that we do not get constipated. */
-
-      drv->ni_read = noteram_next(drv, read, notelen);
-
-      /* and return an error */
+      if (noteram_copy(drv, cpu, (FAR uint8_t *)&note, sizeof(note),
+                       false, false) <= 0)
+        {
+          continue;
+        }
 
-      return -EFBIG;
+      if (found < 0 ||
+          note.nc_systime_sec < oldest.nc_systime_sec ||
+          (note.nc_systime_sec == oldest.nc_systime_sec &&
+           note.nc_systime_nsec < oldest.nc_systime_nsec))
+        {
+          oldest = note;
+          found  = cpu;
+        }
     }
 
-  /* Loop until the note has been transferred to the user buffer */
-
-  remaining = (unsigned int)notelen;
-  while (remaining > 0)
+  if (found < 0)
     {
-      /* Copy the next byte at the read index */
-
-      *buffer++ = drv->ni_buffer[read];
-
-      /* Adjust indices and counts */
-
-      read = noteram_next(drv, read, 1);
-      remaining--;
+      return 0;
     }
 
-  drv->ni_read = read;
-
-  return notelen;
+  return noteram_copy(drv, found, buffer, buflen, true, skip);
 }
 
 /****************************************************************************
@@ -402,9 +474,9 @@ static int noteram_open(FAR struct file *filep)
   FAR struct noteram_driver_s *drv = (FAR struct noteram_driver_s *)
                                      filep->f_inode->i_private;
 
-  /* Reset the read index of the circular buffer */
+  /* Reset the read index of the circular buffers */
 
-  drv->ni_read = drv->ni_tail;
+  noteram_buffer_rewind(drv);
   ctx = kmm_zalloc(sizeof(*ctx));
   if (ctx == NULL)
     {
@@ -413,6 +485,11 @@ static int noteram_open(FAR struct file *filep)
 
   filep->f_priv = ctx;
   noteram_dump_init_context(ctx);
+#ifdef CONFIG_DRIVERS_NOTERAM_DEFAULT_READ_BINARY
+  ctx->mode = NOTERAM_MODE_READ_BINARY;
+#else
+  ctx->mode = NOTERAM_MODE_READ_ASCII;
+#endif
   return OK;
 }
 
@@ -423,6 +500,46 @@ int noteram_close(FAR struct file *filep)
   return OK;
 }
 
+/****************************************************************************
+ * Name: noteram_read_binary
+ *
+ * Description:
+ *   Return as many whole notes as fit in the user buffer, in the same
+ *   binary layout as the sched_note_* functions produce them.  This is
+ *   much cheaper than the text rendering, keeps the full time stamp
+ *   precision and is what tools/parsetrace.py --json converts into a trace
+ *   that Perfetto or chrome://tracing can load.
+ *
+ ****************************************************************************/
+
+static ssize_t noteram_read_binary(FAR struct noteram_driver_s *drv,
+                                   FAR char *buffer, size_t buflen)
+{
+  irqstate_t flags;
+  size_t nread = 0;
+  ssize_t ret;
+
+  do
+    {
+      /* Stop at the first note that does not fit, except if it is the
+       * very first one.  The lock is only held for one note at a time so
+       * that a large read does not keep interrupts off.
+       */
+
+      flags = spin_lock_irqsave_wo_note(&drv->lock);
+      ret = noteram_get(drv, (FAR uint8_t *)buffer + nread,
+                        buflen - nread, nread == 0);
+      spin_unlock_irqrestore_wo_note(&drv->lock, flags);
+      if (ret > 0)
+        {
+          nread += ret;
+        }
+    }
+  while (ret > 0 && nread < buflen);
+
+  return nread > 0 ? (ssize_t)nread : ret;
+}
+
 /****************************************************************************
  * Name: noteram_read
  ****************************************************************************/
@@ -435,6 +552,11 @@ static ssize_t noteram_read(FAR struct file *filep, FAR char *buffer,
   FAR struct lib_memoutstream_s stream;
   ssize_t ret;
 
+  if (ctx->mode == NOTERAM_MODE_READ_BINARY)
+    {
+      return noteram_read_binary(drv, buffer, buflen);
+    }
+
   lib_memoutstream(&stream, buffer, buflen);
 
   do
@@ -445,7 +567,7 @@ static ssize_t noteram_read(FAR struct file *filep, FAR char *buffer,
       /* Get the next note (removing it from the buffer) */
 
       flags = spin_lock_irqsave_wo_note(&drv->lock);
-      ret = noteram_get(drv, note, sizeof(note));
+      ret = noteram_get(drv, note, sizeof(note), true);
       spin_unlock_irqrestore_wo_note(&drv->lock, flags);
       if (ret <= 0)
         {
@@ -469,6 +591,7 @@ static ssize_t noteram_read(FAR struct file *filep, FAR char *buffer,
 static int noteram_ioctl(FAR struct file *filep, int cmd, unsigned long arg)
 {
   int ret = -ENOSYS;
+  FAR struct noteram_dump_context_s *ctx = filep->f_priv;
   FAR struct noteram_driver_s *drv = filep->f_inode->i_private;
   irqstate_t flags = spin_lock_irqsave_wo_note(&drv->lock);
 
@@ -520,6 +643,42 @@ static int noteram_ioctl(FAR struct file *filep, int cmd, unsigned long arg)
           }
         break;
 
+      /* NOTERAM_GETREADMODE
+       *      - Get read mode
+       *        Argument: A writable pointer to unsigned int
+       */
+
+      case NOTERAM_GETREADMODE:
+        if (arg == 0)
+          {
+            ret = -EINVAL;
+          }
+        else
+          {
+            *(unsigned int *)arg = ctx->mode;
+            ret = OK;
+          }
+        break;
+
+      /* NOTERAM_SETREADMODE
+       *      - Set read mode
+       *        Argument: A read-only pointer to unsigned int
+       */
+
+      case NOTERAM_SETREADMODE:
+        if (arg == 0 ||
+            (*(unsigned int *)arg != NOTERAM_MODE_READ_ASCII &&
+             *(unsigned int *)arg != NOTERAM_MODE_READ_BINARY))
+          {
+            ret = -EINVAL;
+          }
+        else
+          {
+            ctx->mode = *(unsigned int *)arg;
+            ret = OK;
+          }
+        break;
+
       default:
           break;
     }
@@ -532,7 +691,9 @@ static int noteram_ioctl(FAR struct file *filep, int cmd, unsigned long arg)
  * Name: noteram_add
  *
  * Description:
- *   Add the variable length note to the transport layer
+ *   Add the variable length note to the ring of the current CPU.  No lock
+ *   is taken: the ring has a single producer and local interrupts are
+ *   disabled while the note is added.
  *
  * Input Parameters:
  *   note    - The note buffer
@@ -541,61 +702,78 @@ static int noteram_ioctl(FAR struct file *filep, int cmd, unsigned long arg)
  * Returned Value:
  *   None
  *
- * Assumptions:
- *   We are within a critical section.
- *
  ****************************************************************************/
 
 static void noteram_add(FAR struct note_driver_s *driver,
                         FAR const void *note, size_t notelen)
 {
-  FAR const char *buf = note;
+  FAR const uint8_t *buf = note;
   FAR struct noteram_driver_s *drv = (FAR struct noteram_driver_s *)driver;
-  unsigned int head;
-  unsigned int remain;
+  FAR struct noteram_ring_s *ring;
+  FAR uint8_t *data;
+  unsigned int offset;
   unsigned int space;
+  unsigned int head;
+  unsigned int tail;
   irqstate_t flags;
+  int cpu;
 
-  flags = spin_lock_irqsave_wo_note(&drv->lock);
+  flags = up_irq_save();
 
   if (drv->ni_overwrite == NOTERAM_MODE_OVERWRITE_OVERFLOW)
     {
-      spin_unlock_irqrestore_wo_note(&drv->lock, flags);
+      up_irq_restore(flags);
       return;
     }
 
-  DEBUGASSERT(note != NULL && notelen < drv->ni_bufsize);
-  remain = drv->ni_bufsize - noteram_length(drv);
+  DEBUGASSERT(note != NULL && notelen < drv->ni_ringsize);
+
+  cpu  = this_cpu();
+  ring = &drv->ni_ring[cpu];
+  data = drv->ni_buffer + cpu * drv->ni_ringsize;
+  head = ring->nr_head;
+  tail = noteram_tail(drv, ring, head);
 
-  if (remain < notelen)
+  if (drv->ni_ringsize - noteram_distance(drv, tail, head) < notelen)
     {
       if (drv->ni_overwrite == NOTERAM_MODE_OVERWRITE_DISABLE)
         {
           /* Stop recording if not in overwrite mode */
 
           drv->ni_overwrite = NOTERAM_MODE_OVERWRITE_OVERFLOW;
-          spin_unlock_irqrestore_wo_note(&drv->lock, flags);
+          up_irq_restore(flags);
           return;
         }
 
-      /* Remove the note at the tail index , make sure there is enough space
+      /* Remove the notes at the tail index, make sure there is enough
+       * space
        */
 
       do
         {
-          noteram_remove(drv);
-          remain = drv->ni_bufsize - noteram_length(drv);
+          tail = noteram_next(drv, tail,
+                              data[tail % drv->ni_ringsize]);
         }
-      while (remain < notelen);
+      while (drv->ni_ringsize - noteram_distance(drv, tail, head) <
+             notelen);
     }
 
-  head = drv->ni_head;
-  space = drv->ni_bufsize - head;
-  space = space < notelen ? space : notelen;
-  memcpy(drv->ni_buffer + head, note, space);
-  memcpy(drv->ni_buffer, buf + space, notelen - space);
-  drv->ni_head = noteram_next(drv, head, notelen);
-  spin_unlock_irqrestore_wo_note(&drv->lock, flags);
+  /* Release the overwritten notes before reusing their space */
+
+  ring->nr_tail = tail;
+  SP_DMB();
+
+  offset = head % drv->ni_ringsize;
+  space  = drv->ni_ringsize - offset;
+  space  = space < notelen ? space : notelen;
+  memcpy(data + offset, buf, space);
+  memcpy(data, buf + space, notelen - space);
+
+  /* Publish the note */
+
+  SP_DMB();
+  ring->nr_head = noteram_next(drv, head, notelen);
+  up_irq_restore(flags);
 }
 
 /****************************************************************************
@@ -1044,7 +1222,7 @@ static void noteram_dump(FAR struct noteram_driver_s *drv)
     {
       ssize_t ret;
 
-      ret = noteram_get(drv, note, sizeof(note));
+      ret = noteram_get(drv, note, sizeof(note), true);
       if (ret <= 0)
         {
           break;
@@ -1140,9 +1318,10 @@ noteram_initialize(FAR const char *devpath, size_t bufsize, bool overwrite)
   drv->ni_bufsize = bufsize;
   drv->ni_buffer = (FAR uint8_t *)(drv + 1);
   drv->ni_overwrite = overwrite;
-  drv->ni_head = 0;
-  drv->ni_tail = 0;
-  drv->ni_read = 0;
+  drv->ni_ringsize = NOTERAM_RINGSIZE(bufsize);
+  drv->ni_limit = NOTERAM_LIMIT(bufsize);
+  spin_lock_init(&drv->lock);
+  memset(drv->ni_ring, 0, sizeof(drv->ni_ring));
 
   ret = note_driver_register(&drv->driver);
   if (ret < 0)
@@ -0,0 +1,546 @@
+/****************************************************************************
+ * drivers/perf/perf_event.c
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <sys/types.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+#include <errno.h>
+
+#include <nuttx/arch.h>
+#include <nuttx/kmalloc.h>
+#include <nuttx/queue.h>
+#include <nuttx/spinlock.h>
+#include <nuttx/perf.h>
+#include <nuttx/fs/fs.h>
+
+#include "sched/sched.h"
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+#define NCPUS CONFIG_SMP_NCPUS
+
+/****************************************************************************
+ * Private Types
+ ****************************************************************************/
+
+/* One counter, owned by an open file.  A thread event lives in the
+ * perf_events list of its TCB and is only running on the PMU while the
+ * thread runs.  A CPU event lives in the list of its CPU and runs as long
+ * as it is enabled.  pe_count accumulates the counter each time it is
+ * stopped.
+ */
+
+struct perf_event_s
+{
+  sq_entry_t        pe_node;     /* In the TCB or CPU list */
+  FAR struct tcb_s *pe_tcb;      /* Thread counted or NULL */
+  int               pe_cpu;      /* CPU counted or -1 */
+  int               pe_event;    /* PERF_COUNT_HW_* */
+  int               pe_counter;  /* Hardware counter */
+  bool              pe_enabled;  /* Counting was requested */
+  bool              pe_active;   /* The hardware counter is running */
+  bool              pe_discard;  /* Reset while running on another CPU */
+  uint64_t          pe_count;    /* Value up to the last stop */
+};
+
+/****************************************************************************
+ * Private Function Prototypes
+ ****************************************************************************/
+
+static int     perf_close(FAR struct file *filep);
+static ssize_t perf_read(FAR struct file *filep, FAR char *buffer,
+                         size_t buflen);
+static int     perf_ioctl(FAR struct file *filep, int cmd,
+                          unsigned long arg);
+
+/****************************************************************************
+ * Private Data
+ ****************************************************************************/
+
+static const struct file_operations g_perf_fops =
+{
+  NULL,         /* open */
+  perf_close,   /* close */
+  perf_read,    /* read */
+  NULL,         /* write */
+  NULL,         /* seek */
+  perf_ioctl,   /* ioctl */
+};
+
+static spinlock_t g_perf_lock = SP_UNLOCKED;
+
+/* Hardware counters attached to an event, on any CPU */
+
+static uint32_t g_perf_counters;
+
+/* CPU events of each CPU */
+
+static sq_queue_t g_perf_cpu[NCPUS];
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: perf_start / perf_stop
+ *
+ * Description:
+ *   Start or stop the hardware counter of an event on this CPU.  Called
+ *   with g_perf_lock held.
+ *
+ ****************************************************************************/
+
+static void perf_start(FAR struct perf_event_s *pe)
+{
+  pe->pe_discard = false;
+  pe->pe_active  = up_pmu_start(pe->pe_counter, pe->pe_event) >= 0;
+}
+
+static void perf_stop(FAR struct perf_event_s *pe)
+{
+  up_pmu_stop(pe->pe_counter);
+  if (!pe->pe_discard)
+    {
+      pe->pe_count += up_pmu_read(pe->pe_counter);
+    }
+
+  pe->pe_discard = false;
+  pe->pe_active  = false;
+}
+
+/****************************************************************************
+ * Name: perf_is_local
+ *
+ * Description:
+ *   Return true if the hardware counter of the event runs on this CPU.
+ *
+ ****************************************************************************/
+
+static bool perf_is_local(FAR struct perf_event_s *pe)
+{
+  if (pe->pe_tcb != NULL)
+    {
+      return pe->pe_tcb == this_task();
+    }
+
+  return pe->pe_cpu == this_cpu();
+}
+
+/****************************************************************************
+ * Name: perf_setup
+ ****************************************************************************/
+
+static int perf_setup(FAR struct file *filep,
+                      FAR const struct perf_event_attr_s *attr)
+{
+  FAR struct perf_event_s *pe;
+  FAR struct tcb_s *tcb = NULL;
+  irqstate_t flags;
+  int counter;
+  int ret;
+
+  if (filep->f_priv != NULL)
+    {
+      return -EBUSY;
+    }
+
+  if (attr == NULL || attr->type != PERF_TYPE_HARDWARE ||
+      attr->config >= PERF_COUNT_HW_MAX)
+    {
+      return -EINVAL;
+    }
+
+  if (attr->pid < 0)
+    {
+      if (attr->pid != -1 || attr->cpu < 0 || attr->cpu >= NCPUS)
+        {
+          return -EINVAL;
+        }
+    }
+
+  pe = kmm_zalloc(sizeof(struct perf_event_s));
+  if (pe == NULL)
+    {
+      return -ENOMEM;
+    }
+
+  pe->pe_cpu   = attr->pid < 0 ? attr->cpu : -1;
+  pe->pe_event = attr->config;
+
+  flags = spin_lock_irqsave(&g_perf_lock);
+
+  if (attr->pid == 0)
+    {
+      tcb = this_task();
+    }
+  else if (attr->pid > 0)
+    {
+      tcb = nxsched_get_tcb(attr->pid);
+      if (tcb == NULL)
+        {
+          ret = -ESRCH;
+          goto errout_with_lock;
+        }
+    }
+
+  /* Counters are not multiplexed: fail if all are in use */
+
+  for (counter = 0; counter < up_pmu_counters() && counter < 32; counter++)
+    {
+      if ((g_perf_counters & (1u << counter)) == 0)
+        {
+          break;
+        }
+    }
+
+  if (counter >= up_pmu_counters() || counter >= 32)
+    {
+      ret = -EBUSY;
+      goto errout_with_lock;
+    }
+
+  /* Check once that this PMU implements the event */
+
+  ret = up_pmu_start(counter, pe->pe_event);
+  if (ret < 0)
+    {
+      goto errout_with_lock;
+    }
+
+  up_pmu_stop(counter);
+
+  g_perf_counters |= 1u << counter;
+  pe->pe_counter   = counter;
+  pe->pe_tcb       = tcb;
+  pe->pe_enabled   = !attr->disabled;
+
+  if (tcb != NULL)
+    {
+      sq_addlast(&pe->pe_node, &tcb->perf_events);
+    }
+  else
+    {
+      sq_addlast(&pe->pe_node, &g_perf_cpu[pe->pe_cpu]);
+    }
+
+  if (pe->pe_enabled && perf_is_local(pe))
+    {
+      perf_start(pe);
+    }
+
+  spin_unlock_irqrestore(&g_perf_lock, flags);
+
+  filep->f_priv = pe;
+  return OK;
+
+errout_with_lock:
+  spin_unlock_irqrestore(&g_perf_lock, flags);
+  kmm_free(pe);
+  return ret;
+}
+
+/****************************************************************************
+ * Name: perf_close
+ ****************************************************************************/
+
+static int perf_close(FAR struct file *filep)
+{
+  FAR struct perf_event_s *pe = filep->f_priv;
+  irqstate_t flags;
+
+  if (pe == NULL)
+    {
+      return OK;
+    }
+
+  flags = spin_lock_irqsave(&g_perf_lock);
+
+  /* A counter left running on another CPU is harmless: it is reset when
+   * it is attached to the next event.
+   */
+
+  if (pe->pe_active && perf_is_local(pe))
+    {
+      up_pmu_stop(pe->pe_counter);
+    }
+
+  if (pe->pe_tcb != NULL)
+    {
+      sq_rem(&pe->pe_node, &pe->pe_tcb->perf_events);
+    }
+  else if (pe->pe_cpu >= 0)
+    {
+      sq_rem(&pe->pe_node, &g_perf_cpu[pe->pe_cpu]);
+    }
+
+  g_perf_counters &= ~(1u << pe->pe_counter);
+
+  spin_unlock_irqrestore(&g_perf_lock, flags);
+
+  kmm_free(pe);
+  filep->f_priv = NULL;
+  return OK;
+}
+
+/****************************************************************************
+ * Name: perf_read
+ *
+ * Description:
+ *   Return the value of the counter as an uint64_t.  The live value is
+ *   only visible on the CPU that runs the counter; elsewhere the value is
+ *   the one saved at the last context switch.
+ *
+ ****************************************************************************/
+
+static ssize_t perf_read(FAR struct file *filep, FAR char *buffer,
+                         size_t buflen)
+{
+  FAR struct perf_event_s *pe = filep->f_priv;
+  irqstate_t flags;
+  uint64_t value;
+
+  if (pe == NULL || buflen < sizeof(uint64_t))
+    {
+      return -EINVAL;
+    }
+
+  flags = spin_lock_irqsave(&g_perf_lock);
+
+  value = pe->pe_count;
+  if (pe->pe_active && perf_is_local(pe))
+    {
+      value += up_pmu_read(pe->pe_counter);
+    }
+
+  spin_unlock_irqrestore(&g_perf_lock, flags);
+
+  memcpy(buffer, &value, sizeof(value));
+  return sizeof(value);
+}
+
+/****************************************************************************
+ * Name: perf_ioctl
+ ****************************************************************************/
+
+static int perf_ioctl(FAR struct file *filep, int cmd, unsigned long arg)
+{
+  FAR struct perf_event_s *pe = filep->f_priv;
+  FAR const struct perf_event_attr_s *attr;
+  irqstate_t flags;
+
+  if (cmd == PERFIOC_SETUP)
+    {
+      attr = (FAR const struct perf_event_attr_s *)(uintptr_t)arg;
+      return perf_setup(filep, attr);
+    }
+
+  if (pe == NULL)
+    {
+      return cmd == PERFIOC_ENABLE || cmd == PERFIOC_DISABLE ||
+             cmd == PERFIOC_RESET ? -EINVAL : -ENOTTY;
+    }
+
+  flags = spin_lock_irqsave(&g_perf_lock);
+
+  /* Changes to a counter running on another CPU take effect at the next
+   * context switch of that CPU.
+   */
+
+  switch (cmd)
+    {
+      case PERFIOC_ENABLE:
+        pe->pe_enabled = true;
+        if (!pe->pe_active && perf_is_local(pe))
+          {
+            perf_start(pe);
+          }
+        break;
+
+      case PERFIOC_DISABLE:
+        pe->pe_enabled = false;
+        if (pe->pe_active && perf_is_local(pe))
+          {
+            perf_stop(pe);
+          }
+        break;
+
+      case PERFIOC_RESET:
+        pe->pe_count = 0;
+        if (pe->pe_active)
+          {
+            if (perf_is_local(pe))
+              {
+                perf_start(pe);
+              }
+            else
+              {
+                pe->pe_discard = true;
+              }
+          }
+        break;
+
+      default:
+        spin_unlock_irqrestore(&g_perf_lock, flags);
+        return -ENOTTY;
+    }
+
+  spin_unlock_irqrestore(&g_perf_lock, flags);
+  return OK;
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: perf_event_suspend
+ *
+ * Description:
+ *   Called by the scheduler when 'tcb' stops running on this CPU.  Saves
+ *   the counters of the thread and applies the pending changes to the
+ *   counters of this CPU.
+ *
+ ****************************************************************************/
+
+void perf_event_suspend(FAR struct tcb_s *tcb)
+{
+  FAR sq_queue_t *cpuq = &g_perf_cpu[this_cpu()];
+  FAR sq_entry_t *node;
+  irqstate_t flags;
+
+  if (sq_empty(&tcb->perf_events) && sq_empty(cpuq))
+    {
+      return;
+    }
+
+  flags = spin_lock_irqsave(&g_perf_lock);
+
+  for (node = sq_peek(&tcb->perf_events); node != NULL; node = node->flink)
+    {
+      FAR struct perf_event_s *pe = (FAR struct perf_event_s *)node;
+
+      if (pe->pe_active)
+        {
+          perf_stop(pe);
+        }
+    }
+
+  /* Fold the CPU counters so that other CPUs see recent values */
+
+  for (node = sq_peek(cpuq); node != NULL; node = node->flink)
+    {
+      FAR struct perf_event_s *pe = (FAR struct perf_event_s *)node;
+
+      if (pe->pe_active)
+        {
+          perf_stop(pe);
+        }
+
+      if (pe->pe_enabled)
+        {
+          perf_start(pe);
+        }
+    }
+
+  spin_unlock_irqrestore(&g_perf_lock, flags);
+}
+
+/****************************************************************************
+ * Name: perf_event_resume
+ *
+ * Description:
+ *   Called by the scheduler when 'tcb' starts running on this CPU.
+ *   Restarts the counters of the thread.
+ *
+ ****************************************************************************/
+
+void perf_event_resume(FAR struct tcb_s *tcb)
+{
+  FAR sq_entry_t *node;
+  irqstate_t flags;
+
+  if (sq_empty(&tcb->perf_events))
+    {
+      return;
+    }
+
+  flags = spin_lock_irqsave(&g_perf_lock);
+
+  for (node = sq_peek(&tcb->perf_events); node != NULL; node = node->flink)
+    {
+      FAR struct perf_event_s *pe = (FAR struct perf_event_s *)node;
+
+      if (pe->pe_enabled && !pe->pe_active)
+        {
+          perf_start(pe);
+        }
+    }
+
+  spin_unlock_irqrestore(&g_perf_lock, flags);
+}
+
+/****************************************************************************
+ * Name: perf_event_release
+ *
+ * Description:
+ *   Called when 'tcb' is released.  Its counters keep their last value
+ *   until the files that hold them are closed.
+ *
+ ****************************************************************************/
+
+void perf_event_release(FAR struct tcb_s *tcb)
+{
+  FAR struct perf_event_s *pe;
+  irqstate_t flags;
+
+  flags = spin_lock_irqsave(&g_perf_lock);
+
+  while ((pe = (FAR struct perf_event_s *)
+               sq_remfirst(&tcb->perf_events)) != NULL)
+    {
+      pe->pe_tcb     = NULL;
+      pe->pe_enabled = false;
+      pe->pe_active  = false;
+    }
+
+  spin_unlock_irqrestore(&g_perf_lock, flags);
+}
+
+/****************************************************************************
+ * Name: perf_event_register
+ *
+ * Description:
+ *   Register /dev/perf
+ *
+ ****************************************************************************/
+
+void perf_event_register(void)
+{
+  register_driver("/dev/perf", &g_perf_fops, 0666, NULL);
+}
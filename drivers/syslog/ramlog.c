@@ -26,7 +26,9 @@
 
 #include <sys/types.h>
 #include <sys/ioctl.h>
+#include <sys/param.h>
 
+#include <stddef.h>
 #include <stdio.h>
 #include <stdint.h>
 #include <stdbool.h>
@@ -41,9 +43,14 @@
 #include <sys/boardctl.h>
 
 #include <nuttx/arch.h>
+#include <nuttx/clock.h>
 #include <nuttx/kmalloc.h>
 #include <nuttx/mutex.h>
 #include <nuttx/semaphore.h>
+#include <nuttx/init.h>
+#include <nuttx/sched.h>
+#include <nuttx/spinlock.h>
+#include <nuttx/streams.h>
 #include <nuttx/fs/fs.h>
 #include <nuttx/fs/ioctl.h>
 #include <nuttx/syslog/ramlog.h>
@@ -51,8 +58,35 @@
 
 #include <nuttx/irq.h>
 
+#include "syslog.h"
+
 #ifdef CONFIG_RAMLOG
 
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+#ifdef CONFIG_RAMLOG_DEFERRED
+#  define RAMLOG_NCPUS          CONFIG_SMP_NCPUS
+#  define RAMLOG_RINGSIZE       (CONFIG_RAMLOG_DEFERRED_BUFSIZE / RAMLOG_NCPUS)
+#  define RAMLOG_RING_BUFFER(r) g_ramlog_records[(r) - g_ramlog_ring]
+#  define RAMLOG_RECORD_HDRSIZE offsetof(struct ramlog_record_s, rr_data)
+#  define RAMLOG_RECORD_MAXDATA \
+     (CONFIG_RAMLOG_DEFERRED_RECSIZE - RAMLOG_RECORD_HDRSIZE)
+
+/* rr_data holds the formatted message, not the arguments */
+
+#  define RAMLOG_RECORD_TEXT    (1 << 0)
+
+/* Longest conversion specification that can be rendered */
+
+#  define RAMLOG_SPEC_MAX       16
+
+#  ifndef SP_DMB
+#    define SP_DMB()
+#  endif
+#endif
+
 /****************************************************************************
  * Private Types
  ****************************************************************************/
@@ -76,6 +110,80 @@ struct ramlog_dev_s
   FAR struct pollfd *rl_fds[CONFIG_RAMLOG_NPOLLWAITERS];
 };
 
+#ifdef CONFIG_RAMLOG_DEFERRED
+/* A message recorded by ramlog_vsyslog().  rr_data holds the arguments
+ * packed one after the other as promoted by va_arg(), strings inline and
+ * NUL terminated.
+ */
+
+struct ramlog_record_s
+{
+  uint16_t             rr_len;       /* Length of the record, header included */
+  uint8_t              rr_priority;  /* Syslog priority */
+  uint8_t              rr_flags;     /* See RAMLOG_RECORD_* */
+  pid_t                rr_pid;       /* Thread that logged the message */
+  struct timespec      rr_time;      /* Time the message was logged */
+  FAR const IPTR char *rr_fmt;       /* Format string */
+  uint8_t              rr_data[1];   /* Packed arguments or text */
+};
+
+/* Records of one CPU.  The CPU is the only producer and adds records with
+ * its interrupts disabled; the reader holding rl_lock is the only
+ * consumer, so no lock is shared between the two.
+ */
+
+struct ramlog_ring_s
+{
+  volatile size_t rg_head;       /* Where the next record is added */
+  volatile size_t rg_tail;       /* Oldest record */
+  volatile size_t rg_dropped;    /* Records lost because the ring was full */
+  size_t          rg_reported;   /* rg_dropped when last reported */
+};
+
+enum ramlog_length_e
+{
+  RAMLOG_LEN_NONE = 0,
+  RAMLOG_LEN_HH,
+  RAMLOG_LEN_H,
+  RAMLOG_LEN_L,
+  RAMLOG_LEN_LL,
+  RAMLOG_LEN_J,
+  RAMLOG_LEN_Z,
+  RAMLOG_LEN_T,
+  RAMLOG_LEN_LD
+};
+
+/* A parsed printf conversion specification */
+
+struct ramlog_spec_s
+{
+  uint8_t len;      /* Length of the specification, '%' included */
+  uint8_t nstar;    /* Number of '*' width and precision arguments */
+  uint8_t length;   /* See enum ramlog_length_e */
+  char    conv;     /* Conversion character */
+  char    ext;      /* Character following %p: S, s, V or 0 */
+};
+
+/* Stream formatting a text record directly into a ring */
+
+struct ramlog_ringstream_s
+{
+  struct lib_outstream_s    common;
+  FAR struct ramlog_ring_s *ring;
+  size_t                    index;   /* Where the next character goes */
+  size_t                    avail;   /* Space left in the ring */
+};
+
+/* Stream rendering records to the text buffer */
+
+struct ramlog_outstream_s
+{
+  struct lib_outstream_s   common;
+  FAR struct ramlog_dev_s *priv;
+  int                      last_ch;
+};
+#endif
+
 /****************************************************************************
  * Private Function Prototypes
  ****************************************************************************/
@@ -88,6 +196,9 @@ static int     ramlog_readnotify(FAR struct ramlog_dev_s *priv);
 static void    ramlog_pollnotify(FAR struct ramlog_dev_s *priv,
                                  pollevent_t eventset);
 static int     ramlog_addchar(FAR struct ramlog_dev_s *priv, char ch);
+#ifdef CONFIG_RAMLOG_DEFERRED
+static bool    ramlog_render(FAR struct ramlog_dev_s *priv, bool flush);
+#endif
 
 /* Character driver methods */
 
@@ -147,6 +258,12 @@ static struct ramlog_dev_s g_sysdev =
 };
 #endif
 
+#ifdef CONFIG_RAMLOG_DEFERRED
+static uint8_t g_ramlog_records[RAMLOG_NCPUS][RAMLOG_RINGSIZE];
+
+static struct ramlog_ring_s g_ramlog_ring[RAMLOG_NCPUS];
+#endif
+
 /****************************************************************************
  * Private Functions
  ****************************************************************************/
@@ -445,6 +562,864 @@ static ssize_t ramlog_addbuf(FAR struct ramlog_dev_s *priv,
   return len;
 }
 
+#ifdef CONFIG_RAMLOG_DEFERRED
+
+/****************************************************************************
+ * Name: ramlog_ring_used
+ ****************************************************************************/
+
+static size_t ramlog_ring_used(FAR struct ramlog_ring_s *ring)
+{
+  return (RAMLOG_RINGSIZE + ring->rg_head - ring->rg_tail) %
+         RAMLOG_RINGSIZE;
+}
+
+/****************************************************************************
+ * Name: ramlog_ring_copyin
+ ****************************************************************************/
+
+static void ramlog_ring_copyin(FAR struct ramlog_ring_s *ring, size_t index,
+                               FAR const void *src, size_t len)
+{
+  size_t ncopy = RAMLOG_RINGSIZE - index;
+
+  if (ncopy > len)
+    {
+      ncopy = len;
+    }
+
+  memcpy(RAMLOG_RING_BUFFER(ring) + index, src, ncopy);
+  memcpy(RAMLOG_RING_BUFFER(ring), (FAR const uint8_t *)src + ncopy,
+         len - ncopy);
+}
+
+/****************************************************************************
+ * Name: ramlog_ring_copyout
+ ****************************************************************************/
+
+static void ramlog_ring_copyout(FAR struct ramlog_ring_s *ring,
+                                size_t index, FAR void *dest, size_t len)
+{
+  size_t ncopy = RAMLOG_RINGSIZE - index;
+
+  if (ncopy > len)
+    {
+      ncopy = len;
+    }
+
+  memcpy(dest, RAMLOG_RING_BUFFER(ring) + index, ncopy);
+  memcpy((FAR uint8_t *)dest + ncopy, RAMLOG_RING_BUFFER(ring),
+         len - ncopy);
+}
+
+/****************************************************************************
+ * Name: ramlog_ringstream_putc
+ *
+ * Description:
+ *   Add a character of an immediately formatted message to the ring.
+ *   Characters that do not fit are only counted, so that the caller can
+ *   tell that the message was too long.
+ *
+ ****************************************************************************/
+
+static void ramlog_ringstream_putc(FAR struct lib_outstream_s *self, int ch)
+{
+  FAR struct ramlog_ringstream_s *stream =
+    (FAR struct ramlog_ringstream_s *)self;
+
+  if (self->nput < stream->avail)
+    {
+      RAMLOG_RING_BUFFER(stream->ring)[stream->index] = ch;
+      stream->index = (stream->index + 1) % RAMLOG_RINGSIZE;
+    }
+
+  self->nput++;
+}
+
+/****************************************************************************
+ * Name: ramlog_ringstream_puts
+ ****************************************************************************/
+
+static int ramlog_ringstream_puts(FAR struct lib_outstream_s *self,
+                                  FAR const void *buf, int len)
+{
+  FAR const char *ptr = buf;
+  int i;
+
+  for (i = 0; i < len; i++)
+    {
+      ramlog_ringstream_putc(self, ptr[i]);
+    }
+
+  return len;
+}
+
+/****************************************************************************
+ * Name: ramlog_parse_spec
+ *
+ * Description:
+ *   Parse the conversion specification starting with the '%' at 'fmt' and
+ *   return a pointer to the character following it.
+ *
+ ****************************************************************************/
+
+static FAR const char *ramlog_parse_spec(FAR const char *fmt,
+                                         FAR struct ramlog_spec_s *spec)
+{
+  FAR const char *start = fmt++;
+
+  memset(spec, 0, sizeof(*spec));
+
+  /* Flags */
+
+  while (*fmt != '\0' && strchr("-+ #0'", *fmt) != NULL)
+    {
+      fmt++;
+    }
+
+  /* Field width and precision */
+
+  if (*fmt == '*')
+    {
+      spec->nstar++;
+      fmt++;
+    }
+
+  while (isdigit(*fmt))
+    {
+      fmt++;
+    }
+
+  if (*fmt == '.')
+    {
+      fmt++;
+      if (*fmt == '*')
+        {
+          spec->nstar++;
+          fmt++;
+        }
+
+      while (isdigit(*fmt))
+        {
+          fmt++;
+        }
+    }
+
+  /* Length modifier */
+
+  switch (*fmt)
+    {
+      case 'h':
+        spec->length = fmt[1] == 'h' ? RAMLOG_LEN_HH : RAMLOG_LEN_H;
+        break;
+
+      case 'l':
+        spec->length = fmt[1] == 'l' ? RAMLOG_LEN_LL : RAMLOG_LEN_L;
+        break;
+
+      case 'j':
+        spec->length = RAMLOG_LEN_J;
+        break;
+
+      case 'z':
+        spec->length = RAMLOG_LEN_Z;
+        break;
+
+      case 't':
+        spec->length = RAMLOG_LEN_T;
+        break;
+
+      case 'L':
+        spec->length = RAMLOG_LEN_LD;
+        break;
+
+      default:
+        break;
+    }
+
+  if (spec->length == RAMLOG_LEN_HH || spec->length == RAMLOG_LEN_LL)
+    {
+      fmt += 2;
+    }
+  else if (spec->length != RAMLOG_LEN_NONE)
+    {
+      fmt++;
+    }
+
+  /* Conversion, including the %pS, %ps and %pV extensions */
+
+  spec->conv = *fmt;
+  if (*fmt != '\0')
+    {
+      fmt++;
+      if (spec->conv == 'p' && (*fmt == 'S' || *fmt == 's' || *fmt == 'V'))
+        {
+          spec->ext = *fmt++;
+        }
+    }
+
+  spec->len = fmt - start;
+  return fmt;
+}
+
+/****************************************************************************
+ * Name: ramlog_pack_value
+ ****************************************************************************/
+
+static bool ramlog_pack_value(FAR uint8_t *data, size_t size,
+                              FAR size_t *next, FAR const void *value,
+                              size_t len)
+{
+  if (*next + len > size)
+    {
+      return false;
+    }
+
+  memcpy(data + *next, value, len);
+  *next += len;
+  return true;
+}
+
+/****************************************************************************
+ * Name: ramlog_pack
+ *
+ * Description:
+ *   Copy the arguments of the message to 'data', without formatting them.
+ *   Strings are copied, everything else is stored as promoted by va_arg().
+ *
+ * Returned Value:
+ *   The number of bytes used on success; -ENOTSUP if the format can not be
+ *   rendered later, -E2BIG if the arguments do not fit.
+ *
+ ****************************************************************************/
+
+static int ramlog_pack(FAR uint8_t *data, size_t size,
+                       FAR const IPTR char *fmt, va_list ap)
+{
+  struct ramlog_spec_s spec;
+  size_t next = 0;
+  bool ok = true;
+  int i;
+
+  while (ok && *fmt != '\0')
+    {
+      if (*fmt != '%')
+        {
+          fmt++;
+          continue;
+        }
+
+      if (fmt[1] == '%')
+        {
+          fmt += 2;
+          continue;
+        }
+
+      fmt = ramlog_parse_spec(fmt, &spec);
+      if (spec.len > RAMLOG_SPEC_MAX || spec.ext == 'V')
+        {
+          return -ENOTSUP;
+        }
+
+      for (i = 0; ok && i < spec.nstar; i++)
+        {
+          int star = va_arg(ap, int);
+          ok = ramlog_pack_value(data, size, &next, &star, sizeof(star));
+        }
+
+      switch (spec.conv)
+        {
+          case 'd':
+          case 'i':
+          case 'u':
+          case 'o':
+          case 'x':
+          case 'X':
+            switch (spec.length)
+              {
+                case RAMLOG_LEN_L:
+                  {
+                    long value = va_arg(ap, long);
+                    ok = ramlog_pack_value(data, size, &next, &value,
+                                           sizeof(value));
+                  }
+                  break;
+
+#ifdef CONFIG_HAVE_LONG_LONG
+                case RAMLOG_LEN_LL:
+                  {
+                    long long value = va_arg(ap, long long);
+                    ok = ramlog_pack_value(data, size, &next, &value,
+                                           sizeof(value));
+                  }
+                  break;
+#endif
+
+                case RAMLOG_LEN_J:
+                  {
+                    intmax_t value = va_arg(ap, intmax_t);
+                    ok = ramlog_pack_value(data, size, &next, &value,
+                                           sizeof(value));
+                  }
+                  break;
+
+                case RAMLOG_LEN_Z:
+                  {
+                    size_t value = va_arg(ap, size_t);
+                    ok = ramlog_pack_value(data, size, &next, &value,
+                                           sizeof(value));
+                  }
+                  break;
+
+                case RAMLOG_LEN_T:
+                  {
+                    ptrdiff_t value = va_arg(ap, ptrdiff_t);
+                    ok = ramlog_pack_value(data, size, &next, &value,
+                                           sizeof(value));
+                  }
+                  break;
+
+                case RAMLOG_LEN_NONE:
+                case RAMLOG_LEN_HH:
+                case RAMLOG_LEN_H:
+                  {
+                    int value = va_arg(ap, int);
+                    ok = ramlog_pack_value(data, size, &next, &value,
+                                           sizeof(value));
+                  }
+                  break;
+
+                default:
+                  return -ENOTSUP;
+              }
+            break;
+
+          case 'c':
+            {
+              int value = va_arg(ap, int);
+              ok = ramlog_pack_value(data, size, &next, &value,
+                                     sizeof(value));
+            }
+            break;
+
+          case 'p':
+            {
+              FAR void *value = va_arg(ap, FAR void *);
+              ok = ramlog_pack_value(data, size, &next, &value,
+                                     sizeof(value));
+            }
+            break;
+
+          case 's':
+            {
+              FAR const char *str = va_arg(ap, FAR const char *);
+              size_t len;
+
+              /* Truncate the string rather than give up on the message */
+
+              if (str == NULL)
+                {
+                  str = "(null)";
+                }
+
+              if (next >= size)
+                {
+                  return -E2BIG;
+                }
+
+              len = strnlen(str, size - next - 1);
+              memcpy(data + next, str, len);
+              data[next + len] = '\0';
+              next += len + 1;
+            }
+            break;
+
+#ifdef CONFIG_HAVE_DOUBLE
+          case 'e':
+          case 'E':
+          case 'f':
+          case 'F':
+          case 'g':
+          case 'G':
+          case 'a':
+          case 'A':
+            if (spec.length == RAMLOG_LEN_LD)
+              {
+#  ifdef CONFIG_HAVE_LONG_DOUBLE
+                long double value = va_arg(ap, long double);
+                ok = ramlog_pack_value(data, size, &next, &value,
+                                       sizeof(value));
+#  else
+                return -ENOTSUP;
+#  endif
+              }
+            else
+              {
+                double value = va_arg(ap, double);
+                ok = ramlog_pack_value(data, size, &next, &value,
+                                       sizeof(value));
+              }
+            break;
+#endif
+
+          default:
+            return -ENOTSUP;
+        }
+    }
+
+  return ok ? (int)next : -E2BIG;
+}
+
+/****************************************************************************
+ * Name: ramlog_unpack_value
+ ****************************************************************************/
+
+static bool ramlog_unpack_value(FAR const uint8_t *data, size_t size,
+                                FAR size_t *next, FAR void *value,
+                                size_t len)
+{
+  if (*next + len > size)
+    {
+      return false;
+    }
+
+  memcpy(value, data + *next, len);
+  *next += len;
+  return true;
+}
+
+/****************************************************************************
+ * Name: ramlog_render_args
+ *
+ * Description:
+ *   Format a message from its format string and the packed arguments.
+ *   Each conversion specification is handed to lib_sprintf() on its own,
+ *   with any '*' replaced by the recorded width or precision.
+ *
+ ****************************************************************************/
+
+static void ramlog_render_args(FAR struct lib_outstream_s *stream,
+                               FAR const IPTR char *fmt,
+                               FAR const uint8_t *data, size_t size)
+{
+  char buf[RAMLOG_SPEC_MAX + 2 * 11 + 1];
+  struct ramlog_spec_s spec;
+  FAR const char *start;
+  FAR char *p;
+  size_t next = 0;
+  bool ok = true;
+  int i;
+
+  while (ok && *fmt != '\0')
+    {
+      if (*fmt != '%')
+        {
+          lib_stream_putc(stream, *fmt++);
+          continue;
+        }
+
+      if (fmt[1] == '%')
+        {
+          lib_stream_putc(stream, '%');
+          fmt += 2;
+          continue;
+        }
+
+      start = fmt;
+      fmt = ramlog_parse_spec(fmt, &spec);
+
+      for (p = buf, i = 0; ok && i < spec.len; i++)
+        {
+          int star;
+
+          if (start[i] != '*')
+            {
+              *p++ = start[i];
+              continue;
+            }
+
+          ok = ramlog_unpack_value(data, size, &next, &star, sizeof(star));
+          p += snprintf(p, buf + sizeof(buf) - p, "%d", star);
+        }
+
+      *p = '\0';
+
+#define RAMLOG_RENDER(type) \
+      do \
+        { \
+          type value; \
+          ok = ok && ramlog_unpack_value(data, size, &next, &value, \
+                                         sizeof(value)); \
+          if (ok) \
+            { \
+              lib_sprintf(stream, buf, value); \
+            } \
+        } \
+      while (0)
+
+      switch (spec.conv)
+        {
+          case 'd':
+          case 'i':
+          case 'u':
+          case 'o':
+          case 'x':
+          case 'X':
+            switch (spec.length)
+              {
+                case RAMLOG_LEN_L:
+                  RAMLOG_RENDER(long);
+                  break;
+
+#ifdef CONFIG_HAVE_LONG_LONG
+                case RAMLOG_LEN_LL:
+                  RAMLOG_RENDER(long long);
+                  break;
+#endif
+
+                case RAMLOG_LEN_J:
+                  RAMLOG_RENDER(intmax_t);
+                  break;
+
+                case RAMLOG_LEN_Z:
+                  RAMLOG_RENDER(size_t);
+                  break;
+
+                case RAMLOG_LEN_T:
+                  RAMLOG_RENDER(ptrdiff_t);
+                  break;
+
+                default:
+                  RAMLOG_RENDER(int);
+                  break;
+              }
+            break;
+
+          case 'c':
+            RAMLOG_RENDER(int);
+            break;
+
+          case 'p':
+            RAMLOG_RENDER(FAR void *);
+            break;
+
+          case 's':
+            if (ok && next < size)
+              {
+                lib_sprintf(stream, buf, (FAR const char *)data + next);
+                next += strnlen((FAR const char *)data + next,
+                                size - next) + 1;
+              }
+            else
+              {
+                ok = false;
+              }
+            break;
+
+#ifdef CONFIG_HAVE_DOUBLE
+          case 'e':
+          case 'E':
+          case 'f':
+          case 'F':
+          case 'g':
+          case 'G':
+          case 'a':
+          case 'A':
+            if (spec.length == RAMLOG_LEN_LD)
+              {
+#  ifdef CONFIG_HAVE_LONG_DOUBLE
+                RAMLOG_RENDER(long double);
+#  endif
+              }
+            else
+              {
+                RAMLOG_RENDER(double);
+              }
+            break;
+#endif
+
+          default:
+            ok = false;
+            break;
+        }
+
+#undef RAMLOG_RENDER
+    }
+}
+
+/****************************************************************************
+ * Name: ramlog_stream_putc
+ ****************************************************************************/
+
+static void ramlog_stream_putc(FAR struct lib_outstream_s *self, int ch)
+{
+  FAR struct ramlog_outstream_s *stream =
+    (FAR struct ramlog_outstream_s *)self;
+
+  ramlog_addchar(stream->priv, ch);
+  stream->last_ch = ch;
+  self->nput++;
+}
+
+/****************************************************************************
+ * Name: ramlog_stream_puts
+ ****************************************************************************/
+
+static int ramlog_stream_puts(FAR struct lib_outstream_s *self,
+                              FAR const void *buf, int len)
+{
+  FAR const char *ptr = buf;
+  int i;
+
+  for (i = 0; i < len; i++)
+    {
+      ramlog_stream_putc(self, ptr[i]);
+    }
+
+  return len;
+}
+
+/****************************************************************************
+ * Name: ramlog_render_record
+ *
+ * Description:
+ *   Render one record to the text buffer, with the same prefix nx_vsyslog()
+ *   would have added.  The record is still in the ring.
+ *
+ ****************************************************************************/
+
+static void ramlog_render_record(FAR struct ramlog_outstream_s *stream,
+                                 int cpu, FAR struct ramlog_ring_s *ring,
+                                 FAR const struct ramlog_record_s *rec)
+{
+  FAR struct lib_outstream_s *s = &stream->common;
+  size_t size = rec->rr_len - RAMLOG_RECORD_HDRSIZE;
+#if CONFIG_TASK_NAME_SIZE > 0 && defined(CONFIG_SYSLOG_PROCESS_NAME)
+  FAR struct tcb_s *tcb = nxsched_get_tcb(rec->rr_pid);
+#endif
+
+  UNUSED(cpu);
+
+#ifdef CONFIG_SYSLOG_TIMESTAMP
+  lib_sprintf(s, "[%5jd.%06ld] ", (uintmax_t)rec->rr_time.tv_sec,
+              rec->rr_time.tv_nsec / NSEC_PER_USEC);
+#endif
+#ifdef CONFIG_SMP
+  lib_sprintf(s, "[CPU%d] ", cpu);
+#endif
+#ifdef CONFIG_SYSLOG_PROCESSID
+  lib_sprintf(s, "[%2d] ", rec->rr_pid);
+#endif
+#ifdef CONFIG_SYSLOG_PRIORITY
+  lib_sprintf(s, "[%6s] ", g_syslog_priority_str[rec->rr_priority]);
+#endif
+#ifdef CONFIG_SYSLOG_PREFIX
+  lib_sprintf(s, "[%s] ", CONFIG_SYSLOG_PREFIX_STRING);
+#endif
+#if CONFIG_TASK_NAME_SIZE > 0 && defined(CONFIG_SYSLOG_PROCESS_NAME)
+  /* The name is looked up now, the thread may be gone or reused */
+
+  lib_sprintf(s, "%s: ", tcb != NULL ? tcb->name : "(null)");
+#endif
+
+  if (rec->rr_flags & RAMLOG_RECORD_TEXT)
+    {
+      /* The text follows the header in the ring, it may be larger than
+       * 'rec' and is copied from the ring directly.
+       */
+
+      size_t index = (ring->rg_tail + RAMLOG_RECORD_HDRSIZE) %
+                     RAMLOG_RINGSIZE;
+
+      while (size > 0)
+        {
+          size_t ncopy = MIN(size, RAMLOG_RINGSIZE - index);
+
+          lib_stream_puts(s, RAMLOG_RING_BUFFER(ring) + index, ncopy);
+          index = (index + ncopy) % RAMLOG_RINGSIZE;
+          size -= ncopy;
+        }
+    }
+  else
+    {
+      ramlog_render_args(s, rec->rr_fmt, rec->rr_data, size);
+    }
+
+  if (stream->last_ch != '\n')
+    {
+      lib_stream_putc(s, '\n');
+    }
+}
+
+/****************************************************************************
+ * Name: ramlog_render
+ *
+ * Description:
+ *   Move the binary records to the text buffer, oldest first across all
+ *   CPUs.  Unless 'flush' is set, stop once the text buffer is half full so
+ *   that rendering does not overrun it.  The caller must hold rl_lock.
+ *
+ * Returned Value:
+ *   True if anything was added to the text buffer.
+ *
+ ****************************************************************************/
+
+static bool ramlog_render(FAR struct ramlog_dev_s *priv, bool flush)
+{
+  union
+    {
+      struct ramlog_record_s rec;
+      uint8_t buf[CONFIG_RAMLOG_DEFERRED_RECSIZE];
+    } u;
+
+  struct ramlog_outstream_s stream;
+  FAR struct ramlog_ring_s *ring;
+  struct ramlog_record_s hdr;
+  struct timespec oldest;
+  bool rendered = false;
+  size_t dropped;
+  size_t used;
+  int next;
+  int cpu;
+
+  stream.common.putc  = ramlog_stream_putc;
+  stream.common.puts  = ramlog_stream_puts;
+  stream.common.flush = lib_noflush;
+  stream.common.nput  = 0;
+  stream.priv         = priv;
+
+  while (flush || ramlog_bufferused(priv) < priv->rl_bufsize / 2)
+    {
+      /* Find the CPU with the oldest pending record */
+
+      next = -1;
+      for (cpu = 0; cpu < RAMLOG_NCPUS; cpu++)
+        {
+          ring = &g_ramlog_ring[cpu];
+
+          dropped = ring->rg_dropped;
+          if (dropped != ring->rg_reported)
+            {
+              lib_sprintf(&stream.common, "ramlog: CPU%d dropped %zu "
+                          "messages\n", cpu, dropped - ring->rg_reported);
+              ring->rg_reported = dropped;
+              rendered = true;
+            }
+
+          if (ramlog_ring_used(ring) < RAMLOG_RECORD_HDRSIZE)
+            {
+              continue;
+            }
+
+          SP_DMB();
+          ramlog_ring_copyout(ring, ring->rg_tail, &hdr,
+                              RAMLOG_RECORD_HDRSIZE);
+          if (next < 0 || clock_timespec_compare(&hdr.rr_time, &oldest) < 0)
+            {
+              oldest = hdr.rr_time;
+              next = cpu;
+            }
+        }
+
+      if (next < 0)
+        {
+          break;
+        }
+
+      /* Take the record out of the ring before rendering it */
+
+      ring = &g_ramlog_ring[next];
+      used = ramlog_ring_used(ring);
+
+      SP_DMB();
+      ramlog_ring_copyout(ring, ring->rg_tail, &u.rec,
+                          RAMLOG_RECORD_HDRSIZE);
+      if (u.rec.rr_len < RAMLOG_RECORD_HDRSIZE || u.rec.rr_len > used ||
+          ((u.rec.rr_flags & RAMLOG_RECORD_TEXT) == 0 &&
+           u.rec.rr_len > sizeof(u)))
+        {
+          /* Corrupted, drop whatever is pending on this CPU */
+
+          ring->rg_tail = ring->rg_head;
+          continue;
+        }
+
+      /* Text is rendered straight from the ring, the arguments are copied
+       * out first.  The record leaves the ring once it is rendered.
+       */
+
+      if ((u.rec.rr_flags & RAMLOG_RECORD_TEXT) == 0)
+        {
+          ramlog_ring_copyout(ring, ring->rg_tail, &u.rec, u.rec.rr_len);
+        }
+
+      stream.last_ch = 0;
+      ramlog_render_record(&stream, next, ring, &u.rec);
+      rendered = true;
+
+      SP_DMB();
+      ring->rg_tail = (ring->rg_tail + u.rec.rr_len) % RAMLOG_RINGSIZE;
+    }
+
+  return rendered;
+}
+
+/****************************************************************************
+ * Name: ramlog_fmt_transient
+ *
+ * Description:
+ *   Return true if the format string lives in memory that may be gone by
+ *   the time the message is rendered, i.e. on the stack or in the heap.
+ *
+ ****************************************************************************/
+
+static bool ramlog_fmt_transient(FAR const IPTR char *fmt)
+{
+  FAR struct tcb_s *tcb = nxsched_self();
+  uintptr_t addr = (uintptr_t)fmt;
+  uintptr_t base;
+
+  /* The stack of the current thread */
+
+  base = (uintptr_t)tcb->stack_base_ptr;
+  if (addr >= base && addr < base + tcb->adj_stack_size)
+    {
+      return true;
+    }
+
+#if defined(CONFIG_ARCH_INTERRUPTSTACK) && CONFIG_ARCH_INTERRUPTSTACK > 3
+  /* The interrupt stack, when logging from an interrupt handler */
+
+  base = up_get_intstackbase();
+  if (addr >= base && addr < base + CONFIG_ARCH_INTERRUPTSTACK)
+    {
+      return true;
+    }
+#endif
+
+#ifdef CONFIG_ARCH_KERNEL_STACK
+  base = (uintptr_t)tcb->xcp.kstack;
+  if (base != 0 && addr >= base &&
+      addr < base + CONFIG_ARCH_KERNEL_STACKSIZE)
+    {
+      return true;
+    }
+#endif
+
+  /* The kernel heap and, if it is separate, the user heap */
+
+#ifdef CONFIG_MM_KERNEL_HEAP
+  if (kmm_heapmember((FAR void *)fmt))
+    {
+      return true;
+    }
+#endif
+
+  return umm_heapmember((FAR void *)fmt);
+}
+
+#endif /* CONFIG_RAMLOG_DEFERRED */
+
 /****************************************************************************
  * Name: ramlog_read
  ****************************************************************************/
@@ -483,6 +1458,16 @@ static ssize_t ramlog_file_read(FAR struct file *filep, FAR char *buffer,
     {
       /* Get the next byte from the buffer */
 
+#ifdef CONFIG_RAMLOG_DEFERRED
+      /* Render the pending records once the text has been read */
+
+      if (priv->rl_head == priv->rl_tail && priv == &g_sysdev &&
+          ramlog_render(priv, false))
+        {
+          continue;
+        }
+#endif
+
       if (priv->rl_head == priv->rl_tail)
         {
           /* The circular buffer is empty. */
@@ -639,6 +1624,13 @@ static int ramlog_file_ioctl(FAR struct file *filep, int cmd,
       return ret;
     }
 
+#ifdef CONFIG_RAMLOG_DEFERRED
+  if (priv == &g_sysdev && priv->rl_head == priv->rl_tail)
+    {
+      ramlog_render(priv, false);
+    }
+#endif
+
   switch (cmd)
     {
       case FIONREAD:
@@ -714,6 +1706,13 @@ static int ramlog_file_poll(FAR struct file *filep, FAR struct pollfd *fds,
 
       eventset = 0;
 
+#ifdef CONFIG_RAMLOG_DEFERRED
+      if (priv == &g_sysdev && priv->rl_head == priv->rl_tail)
+        {
+          ramlog_render(priv, false);
+        }
+#endif
+
       flags = enter_critical_section();
       next_head = priv->rl_head + 1;
       if (next_head >= priv->rl_bufsize)
@@ -898,4 +1897,152 @@ ssize_t ramlog_write(FAR struct syslog_channel_s *channel,
 }
 #endif
 
+/****************************************************************************
+ * Name: ramlog_vsyslog
+ *
+ * Description:
+ *   Record a syslog message without formatting it.  The format string
+ *   pointer, the time and the raw arguments are added to the ring of the
+ *   current CPU, the message is rendered when the RAMLOG is read.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_RAMLOG_DEFERRED
+int ramlog_vsyslog(int priority, FAR const IPTR char *fmt, va_list ap)
+{
+  union
+    {
+      struct ramlog_record_s rec;
+      uint8_t buf[CONFIG_RAMLOG_DEFERRED_RECSIZE];
+    } u;
+
+  struct ramlog_ringstream_s stream;
+  FAR struct ramlog_dev_s *priv = &g_sysdev;
+  FAR struct ramlog_ring_s *ring;
+  int readers_waken = 0;
+  irqstate_t flags;
+  va_list copy;
+  size_t ncopy;
+  size_t head;
+  int len = -ENOTSUP;
+
+  u.rec.rr_priority = priority;
+  u.rec.rr_flags    = 0;
+  u.rec.rr_pid      = nxsched_gettid();
+  u.rec.rr_fmt      = fmt;
+  u.rec.rr_time.tv_sec  = 0;
+  u.rec.rr_time.tv_nsec = 0;
+
+  if (OSINIT_HW_READY())
+    {
+#ifdef CONFIG_SYSLOG_TIMESTAMP_REALTIME
+      clock_gettime(CLOCK_REALTIME, &u.rec.rr_time);
+#else
+      clock_gettime(CLOCK_MONOTONIC, &u.rec.rr_time);
+#endif
+    }
+
+  if (!ramlog_fmt_transient(fmt))
+    {
+      va_copy(copy, ap);
+      len = ramlog_pack(u.rec.rr_data, RAMLOG_RECORD_MAXDATA, fmt, copy);
+      va_end(copy);
+    }
+
+  /* Only this CPU adds to its ring, masking the local interrupts is
+   * enough.
+   */
+
+  flags = up_irq_save();
+
+  ring = &g_ramlog_ring[up_cpu_index()];
+  head = ring->rg_head;
+
+  if (len >= 0)
+    {
+      u.rec.rr_len = RAMLOG_RECORD_HDRSIZE + len;
+      if (RAMLOG_RINGSIZE - 1 - ramlog_ring_used(ring) < u.rec.rr_len)
+        {
+          goto drop;
+        }
+
+      ncopy = u.rec.rr_len;
+    }
+  else
+    {
+      /* The message can not be rendered later.  Format it now, straight
+       * into the free space of the ring after the record header, so that
+       * the length of the message is only limited by the ring.
+       */
+
+      stream.common.putc  = ramlog_ringstream_putc;
+      stream.common.puts  = ramlog_ringstream_puts;
+      stream.common.flush = lib_noflush;
+      stream.common.nput  = 0;
+      stream.ring         = ring;
+      stream.index        = (head + RAMLOG_RECORD_HDRSIZE) % RAMLOG_RINGSIZE;
+      stream.avail        = RAMLOG_RINGSIZE - 1 - ramlog_ring_used(ring);
+
+      if (stream.avail < RAMLOG_RECORD_HDRSIZE)
+        {
+          goto drop;
+        }
+
+      stream.avail = MIN(stream.avail, UINT16_MAX) - RAMLOG_RECORD_HDRSIZE;
+      len = lib_vsprintf(&stream.common, fmt, ap);
+      if (len < 0 || stream.common.nput > stream.avail)
+        {
+          goto drop;
+        }
+
+      u.rec.rr_flags = RAMLOG_RECORD_TEXT;
+      u.rec.rr_len   = RAMLOG_RECORD_HDRSIZE + stream.common.nput;
+      ncopy          = RAMLOG_RECORD_HDRSIZE;
+    }
+
+  /* Add the record, only its header if the text is already there */
+
+  ramlog_ring_copyin(ring, head, &u.rec, ncopy);
+  SP_DMB();
+  ring->rg_head = (head + u.rec.rr_len) % RAMLOG_RINGSIZE;
+
+  up_irq_restore(flags);
+
+#ifndef CONFIG_RAMLOG_NONBLOCKING
+  /* Are there threads waiting for read data? */
+
+  readers_waken = ramlog_readnotify(priv);
+#endif
+
+  if (readers_waken == 0)
+    {
+      ramlog_pollnotify(priv, POLLIN);
+    }
+
+  return u.rec.rr_len - RAMLOG_RECORD_HDRSIZE;
+
+drop:
+  ring->rg_dropped++;
+  up_irq_restore(flags);
+  return -EBUSY;
+}
+
+/****************************************************************************
+ * Name: ramlog_flush
+ *
+ * Description:
+ *   Render all the pending records to the text buffer.  Called on a crash,
+ *   without taking rl_lock.
+ *
+ ****************************************************************************/
+
+int ramlog_flush(FAR struct syslog_channel_s *channel)
+{
+  UNUSED(channel);
+
+  ramlog_render(&g_sysdev, true);
+  return OK;
+}
+#endif
+
 #endif /* CONFIG_RAMLOG */
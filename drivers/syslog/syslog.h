@@ -51,6 +51,12 @@ struct syslog_channel_s; /* Forward reference */
 EXTERN FAR struct syslog_channel_s *g_syslog_channel
                                                 [CONFIG_SYSLOG_MAX_CHANNELS];
 
+/* The names of the syslog priorities, indexed by priority */
+
+#ifdef CONFIG_SYSLOG_PRIORITY
+EXTERN FAR const char * const g_syslog_priority_str[];
+#endif
+
 /****************************************************************************
  * Public Function Prototypes
  ****************************************************************************/
@@ -224,6 +230,19 @@ int syslog_add_intbuffer(int ch);
 int syslog_flush_intbuffer(bool force);
 #endif
 
+/****************************************************************************
+ * Name: syslog_channel_deferred
+ *
+ * Description:
+ *   Return true if the RAMLOG is the only enabled SYSLOG channel, so that
+ *   messages may be recorded by ramlog_vsyslog() without formatting them.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_RAMLOG_DEFERRED
+bool syslog_channel_deferred(void);
+#endif
+
 #undef EXTERN
 #ifdef __cplusplus
 }
@@ -75,7 +75,11 @@ static const struct syslog_channel_ops_s g_ramlog_channel_ops =
 {
   ramlog_putc,
   ramlog_putc,
+#  ifdef CONFIG_RAMLOG_DEFERRED
+  ramlog_flush,
+#  else
   NULL,
+#  endif
   ramlog_write
 };
 
@@ -310,6 +314,50 @@ int syslog_channel(FAR struct syslog_channel_s *channel)
   return -EINVAL;
 }
 
+/****************************************************************************
+ * Name: syslog_channel_deferred
+ *
+ * Description:
+ *   Return true if the RAMLOG is the only enabled SYSLOG channel.  Only
+ *   then may nx_vsyslog() leave the formatting to the RAMLOG reader, any
+ *   other channel (the console in particular) needs the text now.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_RAMLOG_DEFERRED
+bool syslog_channel_deferred(void)
+{
+  bool ramlog = false;
+  int i;
+
+  for (i = 0; i < CONFIG_SYSLOG_MAX_CHANNELS; i++)
+    {
+      FAR struct syslog_channel_s *channel = g_syslog_channel[i];
+
+      if (channel == NULL)
+        {
+          break;
+        }
+
+#  ifdef CONFIG_SYSLOG_IOCTL
+      if (channel->sc_disable)
+        {
+          continue;
+        }
+#  endif
+
+      if (channel != &g_ramlog_channel)
+        {
+          return false;
+        }
+
+      ramlog = true;
+    }
+
+  return ramlog;
+}
+#endif
+
 /****************************************************************************
  * Name: syslog_channel_remove
  *
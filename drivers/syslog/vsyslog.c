@@ -33,6 +33,9 @@
 #include <nuttx/clock.h>
 #include <nuttx/streams.h>
 #include <nuttx/syslog/syslog.h>
+#ifdef CONFIG_RAMLOG_DEFERRED
+#  include <nuttx/syslog/ramlog.h>
+#endif
 
 #include "syslog.h"
 
@@ -54,8 +57,12 @@ static FAR const char * const g_priority_color[] =
   };
 #endif
 
+/****************************************************************************
+ * Public Data
+ ****************************************************************************/
+
 #if defined(CONFIG_SYSLOG_PRIORITY)
-static FAR const char * const g_priority_str[] =
+FAR const char * const g_syslog_priority_str[] =
   {
     "EMERG", "ALERT", "CRIT", "ERROR",
     "WARN", "NOTICE", "INFO", "DEBUG"
@@ -94,6 +101,18 @@ int nx_vsyslog(int priority, FAR const IPTR char *fmt, FAR va_list *ap)
 #  endif
 #endif
 
+#ifdef CONFIG_RAMLOG_DEFERRED
+  /* If nobody but the RAMLOG sees the message, record it unformatted and
+   * let the RAMLOG reader render it.  Otherwise format it as usual, the
+   * RAMLOG then gets the text like any other channel.
+   */
+
+  if (syslog_channel_deferred())
+    {
+      return ramlog_vsyslog(priority, fmt, *ap);
+    }
+#endif
+
   /* Wrap the low-level output in a stream object and let lib_vsprintf
    * do the work.
    */
@@ -233,7 +252,7 @@ int nx_vsyslog(int priority, FAR const IPTR char *fmt, FAR va_list *ap)
 #if defined(CONFIG_SYSLOG_PRIORITY)
   /* Prepend the message priority. */
 
-                             , g_priority_str[priority]
+                             , g_syslog_priority_str[priority]
 #endif
 
 #if defined(CONFIG_SYSLOG_PREFIX)
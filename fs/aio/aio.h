@@ -64,6 +64,11 @@ struct aio_container_s
   FAR struct aiocb *aioc_aiocbp;   /* The contained AIO control block */
   FAR struct file *aioc_filep;     /* File structure to use with the I/O */
   struct work_s aioc_work;         /* Used to defer I/O to the work thread */
+#ifdef CONFIG_FS_AIO_BATCH
+  dq_entry_t aioc_sublink;         /* Link in the submission list */
+  worker_t aioc_worker;            /* Worker performing the I/O */
+  bool aioc_submitted;             /* In the submission list, not started */
+#endif
   pid_t aioc_pid;                  /* ID of the waiting task */
 #ifdef CONFIG_PRIORITY_INHERITANCE
   uint8_t aioc_prio;               /* Priority of the waiting task */
@@ -220,6 +225,28 @@ FAR struct aiocb *aioc_decant(FAR struct aio_container_s *aioc);
 
 int aio_queue(FAR struct aio_container_s *aioc, worker_t worker);
 
+/****************************************************************************
+ * Name: aio_dequeue
+ *
+ * Description:
+ *   Remove an asynchronous I/O that has not yet been started from the low
+ *   priority work queue (or from the submission list if
+ *   CONFIG_FS_AIO_BATCH is enabled).
+ *
+ * Input Parameters:
+ *   aioc - The AIO container to be canceled
+ *
+ * Returned Value:
+ *   Zero (OK) if the I/O was dequeued; -ENOENT if the I/O has already been
+ *   started.
+ *
+ * Assumptions:
+ *   The caller holds the AIO lock.
+ *
+ ****************************************************************************/
+
+int aio_dequeue(FAR struct aio_container_s *aioc);
+
 /****************************************************************************
  * Name: aio_signal
  *
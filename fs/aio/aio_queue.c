@@ -36,10 +36,74 @@
 
 #ifdef CONFIG_FS_AIO
 
+/****************************************************************************
+ * Private Data
+ ****************************************************************************/
+
+#ifdef CONFIG_FS_AIO_BATCH
+/* The list of submitted, but not yet started, asynchronous I/O and the
+ * work items that drain it, one per low priority worker thread so that the
+ * I/O still runs in parallel on all of them.  Both are protected by the AIO
+ * lock.
+ */
+
+static dq_queue_t g_aio_submit;
+static struct work_s g_aio_batchwork[CONFIG_SCHED_LPNTHREADS];
+#endif
+
 /****************************************************************************
  * Private Functions
  ****************************************************************************/
 
+#ifdef CONFIG_FS_AIO_BATCH
+/****************************************************************************
+ * Name: aio_batch_worker
+ *
+ * Description:
+ *   Run on the low priority work queue and perform the asynchronous I/O in
+ *   the submission list, in the order in which it was submitted, until the
+ *   list is empty.  Several instances may run at the same time on
+ *   different worker threads.
+ *
+ ****************************************************************************/
+
+static void aio_batch_worker(FAR void *arg)
+{
+  FAR struct aio_container_s *aioc;
+
+  for (; ; )
+    {
+      if (aio_lock() < 0)
+        {
+          break;
+        }
+
+      aioc = (FAR struct aio_container_s *)dq_remfirst(&g_aio_submit);
+      if (aioc != NULL)
+        {
+          aioc->aioc_submitted = false;
+        }
+
+      aio_unlock();
+
+      if (aioc == NULL)
+        {
+          break;
+        }
+
+      /* The worker decants and frees the container, so it must not be
+       * referenced after this call.
+       */
+
+      aioc->aioc_worker(aioc);
+    }
+}
+#endif
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
 /****************************************************************************
  * Name: aio_queue
  *
@@ -72,9 +136,46 @@ int aio_queue(FAR struct aio_container_s *aioc, worker_t worker)
   lpwork_boostpriority(aioc->aioc_prio);
 #endif
 
+#ifdef CONFIG_FS_AIO_BATCH
+  /* Append the I/O to the submission list and schedule one more batch
+   * worker to drain it, unless all of them are already pending.  A burst
+   * of submissions then wakes up at most one worker thread per batch work
+   * item, and the pending ones pick up all of the I/O queued meanwhile.
+   */
+
+  ret = aio_lock();
+  if (ret >= 0)
+    {
+      int i;
+
+      aioc->aioc_worker    = worker;
+      aioc->aioc_submitted = true;
+      dq_addlast(&aioc->aioc_sublink, &g_aio_submit);
+
+      for (i = 0; i < CONFIG_SCHED_LPNTHREADS; i++)
+        {
+          if (work_available(&g_aio_batchwork[i]))
+            {
+              ret = work_queue(LPWORK, &g_aio_batchwork[i],
+                               aio_batch_worker, NULL, 0);
+              break;
+            }
+        }
+
+      if (ret < 0)
+        {
+          dq_rem(&aioc->aioc_sublink, &g_aio_submit);
+          aioc->aioc_submitted = false;
+        }
+
+      aio_unlock();
+    }
+#else
   /* Schedule the work on the low priority worker thread */
 
   ret = work_queue(LPWORK, &aioc->aioc_work, worker, aioc, 0);
+#endif
+
   if (ret < 0)
     {
       FAR struct aiocb *aiocbp = aioc->aioc_aiocbp;
@@ -96,4 +197,47 @@ int aio_queue(FAR struct aio_container_s *aioc, worker_t worker)
   return ret;
 }
 
+/****************************************************************************
+ * Name: aio_dequeue
+ *
+ * Description:
+ *   Remove an asynchronous I/O that has not yet been started from the low
+ *   priority work queue (or from the submission list if
+ *   CONFIG_FS_AIO_BATCH is enabled).
+ *
+ * Input Parameters:
+ *   aioc - The AIO container to be canceled
+ *
+ * Returned Value:
+ *   Zero (OK) if the I/O was dequeued; -ENOENT if the I/O has already been
+ *   started.
+ *
+ * Assumptions:
+ *   The caller holds the AIO lock.
+ *
+ ****************************************************************************/
+
+int aio_dequeue(FAR struct aio_container_s *aioc)
+{
+#ifdef CONFIG_FS_AIO_BATCH
+  if (!aioc->aioc_submitted)
+    {
+      return -ENOENT;
+    }
+
+  dq_rem(&aioc->aioc_sublink, &g_aio_submit);
+  aioc->aioc_submitted = false;
+
+#ifdef CONFIG_PRIORITY_INHERITANCE
+  /* The worker will never run, so undo the boost made by aio_queue() */
+
+  lpwork_restorepriority(aioc->aioc_prio);
+#endif
+
+  return OK;
+#else
+  return work_cancel(LPWORK, &aioc->aioc_work);
+#endif
+}
+
 #endif /* CONFIG_FS_AIO */
@@ -0,0 +1,134 @@
+/****************************************************************************
+ * fs/aio/lio_submit.c
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <aio.h>
+#include <assert.h>
+#include <errno.h>
+#include <debug.h>
+
+#include <nuttx/fs/fs.h>
+
+#include "aio/aio.h"
+
+#ifdef CONFIG_FS_AIO
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: nx_lio_submit
+ *
+ * Description:
+ *   Submit all of the asynchronous I/O operations of a lio_listio() list in
+ *   a single call.  See include/nuttx/fs/fs.h.
+ *
+ * Input Parameters:
+ *   list    - The list of AIO control blocks, NULL entries are skipped
+ *   nent    - The number of entries in the list
+ *   nqueued - The location to return the number of operations queued
+ *
+ * Returned Value:
+ *   Zero (OK) if every operation was submitted; -EIO if one or more could
+ *   not be, in which case their aio_result holds the reason.
+ *
+ ****************************************************************************/
+
+int nx_lio_submit(FAR struct aiocb * const list[], int nent,
+                  FAR int *nqueued)
+{
+  FAR struct aiocb *aiocbp;
+  int status;
+  int ret = OK;
+  int i;
+
+  DEBUGASSERT(list != NULL && nqueued != NULL);
+
+  *nqueued = 0;
+
+  /* Submit each asynchronous I/O operation in the list, skipping over NULL
+   * entries.
+   */
+
+  for (i = 0; i < nent; i++)
+    {
+      aiocbp = list[i];
+      if (aiocbp == NULL)
+        {
+          continue;
+        }
+
+      switch (aiocbp->aio_lio_opcode)
+        {
+          case LIO_NOP:
+
+            /* Mark the do-nothing operation complete */
+
+            aiocbp->aio_result = OK;
+            break;
+
+          case LIO_READ:
+          case LIO_WRITE:
+            if (aiocbp->aio_lio_opcode == LIO_READ)
+              {
+                status = aio_read(aiocbp);
+              }
+            else
+              {
+                status = aio_write(aiocbp);
+              }
+
+            if (status < 0)
+              {
+                /* Failed to queue the I/O.  Set up the error return. */
+
+                ferr("ERROR: aio_read/write failed: %d\n", get_errno());
+                DEBUGASSERT(get_errno() > 0);
+                aiocbp->aio_result = -get_errno();
+                ret = -EIO;
+              }
+            else
+              {
+                (*nqueued)++;
+              }
+            break;
+
+          default:
+
+            /* Make the invalid operation complete with an error */
+
+            ferr("ERROR: Unrecognized opcode: %d\n",
+                 aiocbp->aio_lio_opcode);
+            aiocbp->aio_result = -EINVAL;
+            ret = -EIO;
+            break;
+        }
+    }
+
+  return ret;
+}
+
+#endif /* CONFIG_FS_AIO */
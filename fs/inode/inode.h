@@ -419,6 +419,91 @@ int pseudofile_create(FAR struct inode **node, FAR const char *path,
 bool inode_is_pseudofile(FAR struct inode *inode);
 #endif
 
+/****************************************************************************
+ * Name: file_readahead
+ *
+ * Description:
+ *   Read from a file that has readahead enabled by posix_fadvise().
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_FS_READAHEAD
+ssize_t file_readahead(FAR struct file *filep, FAR void *buf, size_t nbytes);
+#endif
+
+/****************************************************************************
+ * Name: file_readahead_advise
+ *
+ * Description:
+ *   Apply posix_fadvise() advice to the readahead state of the file.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_FS_READAHEAD
+int file_readahead_advise(FAR struct file *filep, int advice);
+#endif
+
+/****************************************************************************
+ * Name: file_readahead_invalidate
+ *
+ * Description:
+ *   Invalidate the readahead buffers of all the files on an inode.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_FS_READAHEAD
+void file_readahead_invalidate(FAR struct inode *inode);
+#endif
+
+/****************************************************************************
+ * Name: file_readahead_sync
+ *
+ * Description:
+ *   Move the file system back to the caller's position if buffered reads
+ *   left it elsewhere.  Called before any operation other than read() that
+ *   depends on the file system position.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_FS_READAHEAD
+int file_readahead_sync(FAR struct file *filep);
+#endif
+
+/****************************************************************************
+ * Name: file_readahead_seek
+ *
+ * Description:
+ *   Seek a file that has readahead state.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_FS_READAHEAD
+off_t file_readahead_seek(FAR struct file *filep, off_t offset, int whence);
+#endif
+
+/****************************************************************************
+ * Name: file_readahead_release
+ *
+ * Description:
+ *   Free the readahead state of the file, if any.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_FS_READAHEAD
+void file_readahead_release(FAR struct file *filep);
+#endif
+
+/****************************************************************************
+ * Name: epoll_waiting
+ *
+ * Description:
+ *   Check whether a pollfd belongs to an epoll instance that a thread is
+ *   blocked on in epoll_wait().
+ *
+ ****************************************************************************/
+
+bool epoll_waiting(FAR struct pollfd *fds);
+
 #undef EXTERN
 #if defined(__cplusplus)
 }
@@ -26,10 +26,13 @@
 
 #include <errno.h>
 #include <fcntl.h>
+#include <inttypes.h>
+#include <stdlib.h>
 #include <string.h>
 
 #include <nuttx/fs/fs.h>
 #include <nuttx/kmalloc.h>
+#include <nuttx/lib/lib.h>
 #include <nuttx/mtd/mtd.h>
 #include <nuttx/mutex.h>
 
@@ -47,6 +50,11 @@
 #  error littlefs requires CONFIG_C99_BOOL to be selected
 #endif
 
+/* Mount flags parsed from the mount options */
+
+#define LITTLEFS_MOUNT_FORCEFORMAT (1 << 0)
+#define LITTLEFS_MOUNT_AUTOFORMAT  (1 << 1)
+
 /****************************************************************************
  * Private Types
  ****************************************************************************/
@@ -1006,6 +1014,135 @@ static int littlefs_sync_block(FAR const struct lfs_config *c)
   return ret == -ENOTTY ? OK : ret;
 }
 
+/****************************************************************************
+ * Name: littlefs_parse_options
+ *
+ * Description: Parse the comma separated mount options.  The options
+ *  supported are:
+ *
+ *   forceformat      - Format the device before mounting it
+ *   autoformat       - Format the device if it cannot be mounted
+ *   read_size=N      - Minimum size of a read, in bytes
+ *   prog_size=N      - Minimum size of a program, in bytes
+ *   cache_size=N     - Size of the read, program and per-file caches
+ *   lookahead_size=N - Size of the block allocator lookahead bitmap
+ *   block_cycles=N   - Erase cycles before metadata is relocated
+ *
+ *  Larger caches let littlefs transfer several device blocks with a single
+ *  MTD_BREAD()/MTD_BWRITE() call, which mainly speeds up metadata-heavy
+ *  workloads.  The values not given keep the Kconfig defaults already set
+ *  in fs->cfg.
+ *
+ ****************************************************************************/
+
+static int littlefs_parse_options(FAR struct littlefs_mountpt_s *fs,
+                                  FAR const char *data,
+                                  FAR unsigned int *flags)
+{
+  FAR struct lfs_config *cfg = &fs->cfg;
+  FAR char *options;
+  FAR char *saveptr;
+  FAR char *ptr;
+  FAR char *value;
+  unsigned long num;
+  int ret = OK;
+
+  *flags = 0;
+  if (data == NULL)
+    {
+      return OK;
+    }
+
+  options = strdup(data);
+  if (options == NULL)
+    {
+      return -ENOMEM;
+    }
+
+  ptr = strtok_r(options, ",", &saveptr);
+  while (ptr != NULL && ret == OK)
+    {
+      value = strchr(ptr, '=');
+      if (value == NULL)
+        {
+          if (strcmp(ptr, "forceformat") == 0)
+            {
+              *flags |= LITTLEFS_MOUNT_FORCEFORMAT;
+            }
+          else if (strcmp(ptr, "autoformat") == 0)
+            {
+              *flags |= LITTLEFS_MOUNT_AUTOFORMAT;
+            }
+          else
+            {
+              ret = -EINVAL;
+            }
+        }
+      else
+        {
+          *value++ = '\0';
+          num = strtoul(value, NULL, 0);
+
+          if (strcmp(ptr, "read_size") == 0)
+            {
+              cfg->read_size = num;
+            }
+          else if (strcmp(ptr, "prog_size") == 0)
+            {
+              cfg->prog_size = num;
+            }
+          else if (strcmp(ptr, "cache_size") == 0)
+            {
+              cfg->cache_size = num;
+            }
+          else if (strcmp(ptr, "lookahead_size") == 0)
+            {
+              cfg->lookahead_size = num;
+            }
+          else if (strcmp(ptr, "block_cycles") == 0)
+            {
+              cfg->block_cycles = (int32_t)strtol(value, NULL, 0);
+            }
+          else
+            {
+              ret = -EINVAL;
+            }
+        }
+
+      ptr = strtok_r(NULL, ",", &saveptr);
+    }
+
+  lib_free(options);
+
+  if (ret < 0)
+    {
+      ferr("ERROR: Invalid mount option: %s\n", (FAR const char *)data);
+      return ret;
+    }
+
+  /* The device can only transfer whole blocks and littlefs requires the
+   * cache to be a multiple of the read and program sizes and a factor of
+   * the block size.
+   */
+
+  if (cfg->read_size == 0 || cfg->prog_size == 0 || cfg->cache_size == 0 ||
+      cfg->read_size % fs->geo.blocksize != 0 ||
+      cfg->prog_size % fs->geo.blocksize != 0 ||
+      cfg->cache_size % cfg->read_size != 0 ||
+      cfg->cache_size % cfg->prog_size != 0 ||
+      cfg->block_size % cfg->cache_size != 0 ||
+      cfg->lookahead_size == 0 || cfg->lookahead_size % 8 != 0)
+    {
+      ferr("ERROR: Invalid littlefs geometry: read %" PRIu32
+           " prog %" PRIu32 " cache %" PRIu32 " lookahead %" PRIu32 "\n",
+           cfg->read_size, cfg->prog_size, cfg->cache_size,
+           cfg->lookahead_size);
+      return -EINVAL;
+    }
+
+  return OK;
+}
+
 /****************************************************************************
  * Name: littlefs_bind
  ****************************************************************************/
@@ -1014,6 +1151,7 @@ static int littlefs_bind(FAR struct inode *driver, FAR const void *data,
                          FAR void **handle)
 {
   FAR struct littlefs_mountpt_s *fs;
+  unsigned int flags;
   int ret;
 
   /* Open the block driver */
@@ -1114,13 +1252,21 @@ static int littlefs_bind(FAR struct inode *driver, FAR const void *data,
   fs->cfg.lookahead_size = CONFIG_FS_LITTLEFS_LOOKAHEAD_SIZE;
 #endif
 
+  /* Apply the per-mount tuning given with -o */
+
+  ret = littlefs_parse_options(fs, data, &flags);
+  if (ret < 0)
+    {
+      goto errout_with_fs;
+    }
+
   /* Then get information about the littlefs filesystem on the devices
    * managed by this driver.
    */
 
   /* Force format the device if -o forceformat */
 
-  if (data && strcmp(data, "forceformat") == 0)
+  if ((flags & LITTLEFS_MOUNT_FORCEFORMAT) != 0)
     {
       ret = littlefs_convert_result(lfs_format(&fs->lfs, &fs->cfg));
       if (ret < 0)
@@ -1134,7 +1280,7 @@ static int littlefs_bind(FAR struct inode *driver, FAR const void *data,
     {
       /* Auto format the device if -o autoformat */
 
-      if (ret != -EFAULT || !data || strcmp(data, "autoformat"))
+      if (ret != -EFAULT || (flags & LITTLEFS_MOUNT_AUTOFORMAT) == 0)
         {
           goto errout_with_fs;
         }
@@ -66,7 +66,8 @@ static int file_mmap_(FAR struct file *filep, FAR void *start,
      prot,
      flags,
      { NULL }, /* priv.p */
-     NULL      /* munmap */
+     NULL,     /* munmap */
+     NULL      /* msync */
     };
 
   /* Since only a tiny subset of mmap() functionality, we have to verify many
@@ -0,0 +1,137 @@
+/****************************************************************************
+ * fs/mmap/fs_msync.c
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+#include <nuttx/mm/map.h>
+
+#include <sys/types.h>
+#include <sys/mman.h>
+
+#include <stdint.h>
+#include <errno.h>
+#include <debug.h>
+
+#include <nuttx/sched.h>
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: file_msync
+ *
+ * Description:
+ *   Equivalent to the standard msync() function except it does not set
+ *   the errno variable.
+ *
+ ****************************************************************************/
+
+int file_msync(FAR void *start, size_t length, int flags)
+{
+  FAR struct mm_map_entry_s *entry = NULL;
+  FAR struct mm_map_s *mm = get_current_mm();
+  int ret;
+
+  /* MS_SYNC and MS_ASYNC are mutually exclusive */
+
+  if ((flags & ~(MS_ASYNC | MS_SYNC | MS_INVALIDATE)) != 0 ||
+      (flags & (MS_ASYNC | MS_SYNC)) == (MS_ASYNC | MS_SYNC))
+    {
+      return -EINVAL;
+    }
+
+  ret = mm_map_lock();
+  if (ret < 0)
+    {
+      return ret;
+    }
+
+  /* Synchronize every mapping overlapping the range.  The mappings are not
+   * sorted, so the whole list has to be walked.
+   */
+
+  ret = -ENOMEM;
+  while ((entry = mm_map_next(mm, entry)) != NULL)
+    {
+      if ((uintptr_t)entry->vaddr >= (uintptr_t)start + length ||
+          (uintptr_t)entry->vaddr + entry->length <= (uintptr_t)start)
+        {
+          continue;
+        }
+
+      ret = entry->msync != NULL ?
+            entry->msync(entry, start, length, flags) : OK;
+      if (ret < 0)
+        {
+          break;
+        }
+    }
+
+  mm_map_unlock();
+  return ret;
+}
+
+/****************************************************************************
+ * Name: msync
+ *
+ * Description:
+ *   msync() flushes changes made to the in-core copy of a file that was
+ *   mapped into memory using mmap() back to the filesystem.  Only the
+ *   part of the file that corresponds to the memory area starting at
+ *   'start' and having length 'length' is updated.
+ *
+ *   Mappings that are coherent with the backing object by construction
+ *   (XIP mappings of ROMFS, shared memory, anonymous mappings) have nothing
+ *   to synchronize.  File mappings emulated by CONFIG_FS_RAMMAP write the
+ *   RAM image back to the file if the mapping is MAP_SHARED and writable.
+ *
+ * Input Parameters:
+ *   start   The start address of the range to synchronize.
+ *   length  The length of the range to synchronize.
+ *   flags   MS_ASYNC or MS_SYNC, optionally with MS_INVALIDATE.
+ *
+ * Returned Value:
+ *   On success, msync() returns 0, on failure -1, and errno is set
+ *   appropriately.
+ *
+ *     EINVAL
+ *       flags has invalid bits set, or both MS_SYNC and MS_ASYNC are set.
+ *     ENOMEM
+ *       The indicated memory (or part of it) was not mapped.
+ *
+ ****************************************************************************/
+
+int msync(FAR void *start, size_t length, int flags)
+{
+  int ret;
+
+  ret = file_msync(start, length, flags);
+  if (ret < 0)
+    {
+      set_errno(-ret);
+      ret = ERROR;
+    }
+
+  return ret;
+}
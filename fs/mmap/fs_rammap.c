@@ -28,8 +28,10 @@
 #include <assert.h>
 #include <debug.h>
 #include <errno.h>
+#include <fcntl.h>
 #include <string.h>
 #include <unistd.h>
+#include <sys/mman.h>
 
 #include <nuttx/fs/fs.h>
 #include <nuttx/kmalloc.h>
@@ -40,21 +42,168 @@
 #ifdef CONFIG_FS_RAMMAP
 
 /****************************************************************************
- * Public Data
+ * Pre-processor Definitions
  ****************************************************************************/
 
+/* The private data of a RAM mapping holds the write back state (only for
+ * shared, writable mappings) with the bit 0 used to remember whether the
+ * region came from the kernel or the user heap.
+ */
+
+#define RAMMAP_KERNEL          ((uintptr_t)1)
+#define RAMMAP_ISKERNEL(e)     (((uintptr_t)(e)->priv.p & RAMMAP_KERNEL) != 0)
+#define RAMMAP_WRFILE(e)       ((FAR struct rammap_wrfile_s *) \
+                                ((uintptr_t)(e)->priv.p & ~RAMMAP_KERNEL))
+#define RAMMAP_FILEP(e)        ((FAR struct file *)RAMMAP_WRFILE(e))
+
+/****************************************************************************
+ * Private Types
+ ****************************************************************************/
+
+/* The write back state of a shared, writable mapping */
+
+struct rammap_wrfile_s
+{
+  struct file file;  /* The duplicated backing file; must be first */
+  size_t      nread; /* Bytes of the mapping read from the file at map
+                      * time.  The zeros past the end of file are never
+                      * written back.
+                      */
+};
+
 /****************************************************************************
  * Private Functions
  ****************************************************************************/
 
+/****************************************************************************
+ * Name: rammap_writeback
+ *
+ * Description:
+ *   Write the in-memory image of a shared, writable mapping in the range
+ *   [start, start + length) back to the backing file.  The range is
+ *   clipped to the part of the file that was mapped, so that the file
+ *   does not grow to the length of the mapping.
+ *
+ *   Modifications are not tracked: the whole range is written back,
+ *   including the bytes that the process never touched.  Those overwrite
+ *   any write() made to the same range of the file since it was mapped.
+ *
+ ****************************************************************************/
+
+static int rammap_writeback(FAR struct mm_map_entry_s *entry,
+                            FAR void *start, size_t length)
+{
+  FAR struct rammap_wrfile_s *wrfile = RAMMAP_WRFILE(entry);
+  FAR const uint8_t *wrbuffer = start;
+  ssize_t nwritten;
+  off_t offset;
+  size_t pos;
+
+  if (wrfile == NULL)
+    {
+      /* Private or read-only mapping, nothing to write back */
+
+      return OK;
+    }
+
+  pos = (uintptr_t)start - (uintptr_t)entry->vaddr;
+  if (pos >= wrfile->nread)
+    {
+      return OK;
+    }
+
+  if (length > wrfile->nread - pos)
+    {
+      length = wrfile->nread - pos;
+    }
+
+  offset = entry->offset + pos;
+
+  while (length > 0)
+    {
+      nwritten = file_pwrite(&wrfile->file, wrbuffer, length, offset);
+      if (nwritten < 0)
+        {
+          if (nwritten == -EINTR)
+            {
+              continue;
+            }
+
+          ferr("ERROR: Write back failed: offset=%zu ret=%zd\n",
+               (size_t)offset, nwritten);
+          return nwritten;
+        }
+      else if (nwritten == 0)
+        {
+          break;
+        }
+
+      wrbuffer += nwritten;
+      offset   += nwritten;
+      length   -= nwritten;
+    }
+
+  return OK;
+}
+
+/****************************************************************************
+ * Name: msync_rammap
+ ****************************************************************************/
+
+static int msync_rammap(FAR struct mm_map_entry_s *entry, FAR void *start,
+                        size_t length, int flags)
+{
+  FAR struct file *filep = RAMMAP_FILEP(entry);
+  uintptr_t end = (uintptr_t)start + length;
+  int ret;
+
+  if (filep == NULL || (flags & MS_INVALIDATE) != 0)
+    {
+      return OK;
+    }
+
+  /* Clip the range to the mapped region */
+
+  if ((uintptr_t)start < (uintptr_t)entry->vaddr)
+    {
+      start = entry->vaddr;
+    }
+
+  if (end > (uintptr_t)entry->vaddr + entry->length)
+    {
+      end = (uintptr_t)entry->vaddr + entry->length;
+    }
+
+  if (end <= (uintptr_t)start)
+    {
+      return OK;
+    }
+
+  ret = rammap_writeback(entry, start, end - (uintptr_t)start);
+  if (ret >= 0 && (flags & MS_SYNC) != 0)
+    {
+      ret = file_fsync(filep);
+      if (ret == -EINVAL || ret == -ENOTTY)
+        {
+          /* The file system does not support fsync */
+
+          ret = OK;
+        }
+    }
+
+  return ret;
+}
+
 static int unmap_rammap(FAR struct task_group_s *group,
                         FAR struct mm_map_entry_s *entry,
                         FAR void *start,
                         size_t length)
 {
+  FAR struct file *filep = RAMMAP_FILEP(entry);
   FAR void *newaddr;
   off_t offset;
-  bool kernel = entry->priv.i;
+  bool kernel = RAMMAP_ISKERNEL(entry);
+  int wbret;
   int ret = OK;
 
   /* Get the offset from the beginning of the region and the actual number
@@ -77,10 +226,25 @@ static int unmap_rammap(FAR struct task_group_s *group,
 
   length = entry->length - offset;
 
+  /* Flush the modifications of the unmapped range to the backing file.
+   * The mapping is released even if this fails, otherwise it would leak,
+   * e.g. when the task group exits; the error is reported to the caller.
+   */
+
+  wbret = rammap_writeback(entry, start, length);
+
   /* Are we unmapping the entire region (offset == 0)? */
 
   if (length >= entry->length)
     {
+      /* Release the backing file */
+
+      if (filep != NULL)
+        {
+          file_close(filep);
+          kmm_free(filep);
+        }
+
       /* Free the region */
 
       if (kernel)
@@ -117,7 +281,7 @@ static int unmap_rammap(FAR struct task_group_s *group,
       entry->length = length;
     }
 
-  return ret;
+  return wbret < 0 ? wbret : ret;
 }
 
 /****************************************************************************
@@ -152,9 +316,10 @@ static int unmap_rammap(FAR struct task_group_s *group,
 int rammap(FAR struct file *filep, FAR struct mm_map_entry_s *entry,
            bool kernel)
 {
+  FAR struct rammap_wrfile_s *wrfile = NULL;
   FAR uint8_t *rdbuffer;
   ssize_t nread;
-  off_t fpos;
+  off_t offset;
   int ret;
   size_t length = entry->length;
 
@@ -171,36 +336,53 @@ int rammap(FAR struct file *filep, FAR struct mm_map_entry_s *entry,
    * Not very useful!
    */
 
+  /* A shared, writable mapping keeps its own reference to the file so that
+   * the modifications can be written back by msync() and munmap(), even
+   * after the caller has closed the file descriptor.
+   */
+
+  if ((entry->flags & MAP_SHARED) != 0 && (entry->prot & PROT_WRITE) != 0)
+    {
+      if ((filep->f_oflags & O_WROK) == 0)
+        {
+          ferr("ERROR: Shared writable mapping of read-only file\n");
+          return -EACCES;
+        }
+
+      wrfile = kmm_zalloc(sizeof(struct rammap_wrfile_s));
+      if (wrfile == NULL)
+        {
+          return -ENOMEM;
+        }
+
+      ret = file_dup2(filep, &wrfile->file);
+      if (ret < 0)
+        {
+          kmm_free(wrfile);
+          return ret;
+        }
+    }
+
   /* Allocate a region of memory of the specified size */
 
   rdbuffer = kernel ? kmm_malloc(length) : kumm_malloc(length);
   if (!rdbuffer)
     {
       ferr("ERROR: Region allocation failed, length: %zu\n", length);
-      return -ENOMEM;
+      ret = -ENOMEM;
+      goto errout_with_file;
     }
 
   entry->vaddr = rdbuffer; /* save the buffer firstly */
 
-  /* Seek to the specified file offset */
-
-  fpos = file_seek(filep, entry->offset, SEEK_SET);
-  if (fpos < 0)
-    {
-      /* Seek failed... errno has already been set, but EINVAL is probably
-       * the correct response.
-       */
-
-      ferr("ERROR: Seek to position %zu failed\n", (size_t)entry->offset);
-      ret = fpos;
-      goto errout_with_region;
-    }
-
-  /* Read the file data into the memory region */
+  /* Read the file data into the memory region.  Use positional reads so
+   * that the file position of the caller is left untouched.
+   */
 
+  offset = entry->offset;
   while (length > 0)
     {
-      nread = file_read(filep, rdbuffer, length);
+      nread = file_pread(filep, rdbuffer, length, offset);
       if (nread < 0)
         {
           /* Handle the special case where the read was interrupted by a
@@ -212,11 +394,13 @@ int rammap(FAR struct file *filep, FAR struct mm_map_entry_s *entry,
               /* All other read errors are bad. */
 
               ferr("ERROR: Read failed: offset=%zu ret=%zd\n",
-                   (size_t)entry->offset, nread);
+                   (size_t)offset, nread);
 
               ret = nread;
               goto errout_with_region;
             }
+
+          continue;
         }
 
       /* Check for end of file. */
@@ -229,17 +413,26 @@ int rammap(FAR struct file *filep, FAR struct mm_map_entry_s *entry,
       /* Increment number of bytes read */
 
       rdbuffer += nread;
+      offset   += nread;
       length   -= nread;
     }
 
-  /* Zero any memory beyond the amount read from the file */
+  /* Zero any memory beyond the amount read from the file, and remember
+   * not to write it back.
+   */
 
   memset(rdbuffer, 0, length);
+  if (wrfile != NULL)
+    {
+      wrfile->nread = entry->length - length;
+    }
 
   /* Add the buffer to the list of regions */
 
-  entry->priv.i = kernel;
+  entry->priv.p = (FAR void *)((uintptr_t)wrfile |
+                               (kernel ? RAMMAP_KERNEL : 0));
   entry->munmap = unmap_rammap;
+  entry->msync  = msync_rammap;
 
   ret = mm_map_add(get_current_mm(), entry);
   if (ret < 0)
@@ -259,6 +452,13 @@ errout_with_region:
       kumm_free(entry->vaddr);
     }
 
+errout_with_file:
+  if (wrfile != NULL)
+    {
+      file_close(&wrfile->file);
+      kmm_free(wrfile);
+    }
+
   return ret;
 }
 
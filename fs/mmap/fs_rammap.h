@@ -30,8 +30,9 @@
  * - All of the file must be present in memory.  This limits the size of
  *   files that may be memory mapped (especially on MCUs with no significant
  *   RAM resources).
- * - All mapped files are read-only.  You can write to the in-memory image,
- *   but the file contents will not change.
+ * - Private mappings are read-only.  You can write to the in-memory image,
+ *   but the file contents will not change.  Shared, writable mappings are
+ *   written back to the file by msync() and munmap().
  * - There are not access privileges.
  */
 
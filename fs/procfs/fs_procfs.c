@@ -59,15 +59,20 @@ extern const struct procfs_operations g_critmon_operations;
 extern const struct procfs_operations g_fdt_operations;
 extern const struct procfs_operations g_iobinfo_operations;
 extern const struct procfs_operations g_irq_operations;
+extern const struct procfs_operations g_latency_operations;
+extern const struct procfs_operations g_lockstat_operations;
 extern const struct procfs_operations g_meminfo_operations;
 extern const struct procfs_operations g_memdump_operations;
 extern const struct procfs_operations g_mempool_operations;
 extern const struct procfs_operations g_module_operations;
+extern const struct procfs_operations g_mutexspin_operations;
 extern const struct procfs_operations g_pm_operations;
 extern const struct procfs_operations g_proc_operations;
+extern const struct procfs_operations g_syscalls_operations;
 extern const struct procfs_operations g_tcbinfo_operations;
 extern const struct procfs_operations g_uptime_operations;
 extern const struct procfs_operations g_version_operations;
+extern const struct procfs_operations g_wqueue_operations;
 
 /* This is not good.  These are implemented in other sub-systems.  Having to
  * deal with them here is not a good coupling. What is really needed is a
@@ -143,6 +148,14 @@ static const struct procfs_entry_s g_procfs_entries[] =
   { "irqs",         &g_irq_operations,      PROCFS_FILE_TYPE   },
 #endif
 
+#ifdef CONFIG_SCHED_LATENCYMONITOR
+  { "latency",      &g_latency_operations,  PROCFS_FILE_TYPE   },
+#endif
+
+#ifdef CONFIG_SCHED_LOCKSTAT
+  { "lockstat",     &g_lockstat_operations, PROCFS_FILE_TYPE   },
+#endif
+
 #ifndef CONFIG_FS_PROCFS_EXCLUDE_MEMINFO
 #  ifndef CONFIG_FS_PROCFS_EXCLUDE_MEMDUMP
   { "memdump",      &g_memdump_operations,  PROCFS_FILE_TYPE   },
@@ -158,6 +171,10 @@ static const struct procfs_entry_s g_procfs_entries[] =
   { "modules",      &g_module_operations,   PROCFS_FILE_TYPE   },
 #endif
 
+#ifdef CONFIG_MUTEX_SPIN
+  { "mutexspin",    &g_mutexspin_operations, PROCFS_FILE_TYPE  },
+#endif
+
 #if defined(CONFIG_NET) && !defined(CONFIG_FS_PROCFS_EXCLUDE_NET)
   { "net",          &g_net_operations,      PROCFS_DIR_TYPE    },
 #  if defined(CONFIG_NET_ROUTE) && !defined(CONFIG_FS_PROCFS_EXCLUDE_ROUTE)
@@ -181,6 +198,10 @@ static const struct procfs_entry_s g_procfs_entries[] =
   { "self/**",      &g_proc_operations,     PROCFS_UNKOWN_TYPE },
 #endif
 
+#ifdef CONFIG_SCHED_SYSCALLSTAT
+  { "syscalls",     &g_syscalls_operations, PROCFS_FILE_TYPE   },
+#endif
+
 #if defined(CONFIG_ARCH_HAVE_TCBINFO) && !defined(CONFIG_FS_PROCFS_EXCLUDE_TCBINFO)
   { "tcbinfo",      &g_tcbinfo_operations,  PROCFS_FILE_TYPE   },
 #endif
@@ -192,6 +213,10 @@ static const struct procfs_entry_s g_procfs_entries[] =
 #ifndef CONFIG_FS_PROCFS_EXCLUDE_VERSION
   { "version",      &g_version_operations,  PROCFS_FILE_TYPE   },
 #endif
+
+#ifdef CONFIG_SCHED_WORKQUEUE_STATS
+  { "wqueue",       &g_wqueue_operations,   PROCFS_FILE_TYPE   },
+#endif
 };
 
 #ifdef CONFIG_FS_PROCFS_REGISTER
@@ -0,0 +1,403 @@
+/****************************************************************************
+ * fs/procfs/fs_procfslatency.c
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <sys/types.h>
+#include <sys/stat.h>
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <inttypes.h>
+#include <string.h>
+#include <fcntl.h>
+#include <assert.h>
+#include <errno.h>
+#include <debug.h>
+
+#include <nuttx/irq.h>
+#include <nuttx/sched.h>
+#include <nuttx/kmalloc.h>
+#include <nuttx/fs/fs.h>
+#include <nuttx/fs/procfs.h>
+
+#if !defined(CONFIG_DISABLE_MOUNTPOINT) && defined(CONFIG_FS_PROCFS) && \
+     defined(CONFIG_SCHED_LATENCYMONITOR)
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+/* Output format, one line per non-empty bucket followed by a summary.  The
+ * first column is the lower bound of the bucket in nanoseconds.
+ *
+ *   NSEC              IRQ     WAKEUP       WDOG
+ *   DDDDDDDDDD DDDDDDDDDD DDDDDDDDDD DDDDDDDDDD
+ *   ...
+ *   p50        DDDDDDDDDD DDDDDDDDDD DDDDDDDDDD
+ *   p99        DDDDDDDDDD DDDDDDDDDD DDDDDDDDDD
+ *   p99.9      DDDDDDDDDD DDDDDDDDDD DDDDDDDDDD
+ *   max        DDDDDDDDDD DDDDDDDDDD DDDDDDDDDD
+ */
+
+#define LATENCY_LINELEN   64
+#define LATENCY_NHISTS    3
+
+/* Lines following the buckets */
+
+#define LATENCY_NSUMMARY  4
+
+/****************************************************************************
+ * Private Types
+ ****************************************************************************/
+
+/* This structure describes one open "file".  The histograms are copied
+ * when the file is opened so that all reads return consistent data.
+ */
+
+struct latency_file_s
+{
+  struct procfs_file_s base;                  /* Base open file structure */
+  struct latency_hist_s hist[LATENCY_NHISTS]; /* IRQ, wakeup, wdog */
+  char line[LATENCY_LINELEN];                 /* Formatted line */
+};
+
+/****************************************************************************
+ * Private Function Prototypes
+ ****************************************************************************/
+
+static int     latency_open(FAR struct file *filep, FAR const char *relpath,
+                            int oflags, mode_t mode);
+static int     latency_close(FAR struct file *filep);
+static ssize_t latency_read(FAR struct file *filep, FAR char *buffer,
+                            size_t buflen);
+static ssize_t latency_write(FAR struct file *filep,
+                             FAR const char *buffer, size_t buflen);
+static int     latency_dup(FAR const struct file *oldp,
+                           FAR struct file *newp);
+static int     latency_stat(FAR const char *relpath, FAR struct stat *buf);
+
+/****************************************************************************
+ * Public Data
+ ****************************************************************************/
+
+/* See fs_mount.c -- this structure is explicitly externed there.
+ * We use the old-fashioned kind of initializers so that this will compile
+ * with any compiler.
+ */
+
+const struct procfs_operations g_latency_operations =
+{
+  latency_open,       /* open */
+  latency_close,      /* close */
+  latency_read,       /* read */
+  latency_write,      /* write */
+
+  latency_dup,        /* dup */
+
+  NULL,               /* opendir */
+  NULL,               /* closedir */
+  NULL,               /* readdir */
+  NULL,               /* rewinddir */
+
+  latency_stat        /* stat */
+};
+
+/****************************************************************************
+ * Private Data
+ ****************************************************************************/
+
+static const unsigned int g_latency_permille[LATENCY_NSUMMARY - 1] =
+{
+  500, 990, 999
+};
+
+static FAR const char * const g_latency_summary[LATENCY_NSUMMARY] =
+{
+  "p50", "p99", "p99.9", "max"
+};
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: latency_merge
+ *
+ * Description:
+ *   Add the histogram 'src' to 'dest'.
+ *
+ ****************************************************************************/
+
+static void latency_merge(FAR struct latency_hist_s *dest,
+                          FAR const struct latency_hist_s *src)
+{
+  int i;
+
+  for (i = 0; i < LATENCY_NBUCKETS; i++)
+    {
+      dest->count[i] += src->count[i];
+    }
+
+  if (src->max > dest->max)
+    {
+      dest->max = src->max;
+    }
+}
+
+/****************************************************************************
+ * Name: latency_line
+ *
+ * Description:
+ *   Format the line 'index' of the output, skipping empty buckets.
+ *
+ * Returned Value:
+ *   The length of the line, or zero past the last line.
+ *
+ ****************************************************************************/
+
+static size_t latency_line(FAR struct latency_file_s *attr, int index)
+{
+  FAR struct latency_hist_s *hist = attr->hist;
+  uint64_t value[LATENCY_NHISTS];
+  int i;
+
+  if (index < LATENCY_NBUCKETS)
+    {
+      if (hist[0].count[index] == 0 && hist[1].count[index] == 0 &&
+          hist[2].count[index] == 0)
+        {
+          return 0;
+        }
+
+      return procfs_snprintf(attr->line, LATENCY_LINELEN,
+                             "%-10" PRIu64 " %10" PRIu32 " %10" PRIu32
+                             " %10" PRIu32 "\n",
+                             index > 0 ? UINT64_C(1) << index : 0,
+                             hist[0].count[index], hist[1].count[index],
+                             hist[2].count[index]);
+    }
+
+  index -= LATENCY_NBUCKETS;
+  for (i = 0; i < LATENCY_NHISTS; i++)
+    {
+      value[i] = index < LATENCY_NSUMMARY - 1 ?
+                 nxsched_latency_percentile(&hist[i],
+                                            g_latency_permille[index]) :
+                 hist[i].max;
+    }
+
+  return procfs_snprintf(attr->line, LATENCY_LINELEN,
+                         "%-10s %10" PRIu64 " %10" PRIu64 " %10" PRIu64
+                         "\n", g_latency_summary[index],
+                         value[0], value[1], value[2]);
+}
+
+/****************************************************************************
+ * Name: latency_open
+ ****************************************************************************/
+
+static int latency_open(FAR struct file *filep, FAR const char *relpath,
+                        int oflags, mode_t mode)
+{
+  FAR struct latency_file_s *attr;
+  irqstate_t flags;
+  int cpu;
+
+  finfo("Open '%s'\n", relpath);
+
+  /* Allocate a container to hold the file attributes */
+
+  attr = kmm_zalloc(sizeof(struct latency_file_s));
+  if (!attr)
+    {
+      ferr("ERROR: Failed to allocate file attributes\n");
+      return -ENOMEM;
+    }
+
+  /* Take a snapshot of the histograms */
+
+  flags = enter_critical_section();
+  for (cpu = 0; cpu < CONFIG_SMP_NCPUS; cpu++)
+    {
+      latency_merge(&attr->hist[0], &g_irq_latency[cpu]);
+      latency_merge(&attr->hist[1], &g_wakeup_latency[cpu]);
+    }
+
+  latency_merge(&attr->hist[2], &g_wdog_latency);
+  leave_critical_section(flags);
+
+  /* Save the attributes as the open-specific state in filep->f_priv */
+
+  filep->f_priv = (FAR void *)attr;
+  return OK;
+}
+
+/****************************************************************************
+ * Name: latency_close
+ ****************************************************************************/
+
+static int latency_close(FAR struct file *filep)
+{
+  FAR struct latency_file_s *attr;
+
+  /* Recover our private data from the struct file instance */
+
+  attr = (FAR struct latency_file_s *)filep->f_priv;
+  DEBUGASSERT(attr);
+
+  /* Release the file attributes structure */
+
+  kmm_free(attr);
+  filep->f_priv = NULL;
+  return OK;
+}
+
+/****************************************************************************
+ * Name: latency_read
+ ****************************************************************************/
+
+static ssize_t latency_read(FAR struct file *filep, FAR char *buffer,
+                            size_t buflen)
+{
+  FAR struct latency_file_s *attr;
+  size_t linesize;
+  size_t copysize;
+  size_t totalsize;
+  off_t offset;
+  int index;
+
+  finfo("buffer=%p buflen=%d\n", buffer, (int)buflen);
+
+  /* Recover our private data from the struct file instance */
+
+  attr = (FAR struct latency_file_s *)filep->f_priv;
+  DEBUGASSERT(attr);
+
+  offset   = filep->f_pos;
+  linesize = procfs_snprintf(attr->line, LATENCY_LINELEN,
+                             "%-10s %10s %10s %10s\n",
+                             "NSEC", "IRQ", "WAKEUP", "WDOG");
+  totalsize = procfs_memcpy(attr->line, linesize, buffer, buflen, &offset);
+
+  for (index = 0;
+       index < LATENCY_NBUCKETS + LATENCY_NSUMMARY && totalsize < buflen;
+       index++)
+    {
+      linesize = latency_line(attr, index);
+      if (linesize > 0)
+        {
+          copysize   = procfs_memcpy(attr->line, linesize,
+                                     buffer + totalsize, buflen - totalsize,
+                                     &offset);
+          totalsize += copysize;
+        }
+    }
+
+  filep->f_pos += totalsize;
+  return totalsize;
+}
+
+/****************************************************************************
+ * Name: latency_write
+ *
+ * Description:
+ *   Writing anything to the file clears the histograms.
+ *
+ ****************************************************************************/
+
+static ssize_t latency_write(FAR struct file *filep,
+                             FAR const char *buffer, size_t buflen)
+{
+  irqstate_t flags;
+
+  flags = enter_critical_section();
+  memset(g_irq_latency, 0, sizeof(g_irq_latency));
+  memset(g_wakeup_latency, 0, sizeof(g_wakeup_latency));
+  memset(&g_wdog_latency, 0, sizeof(g_wdog_latency));
+  leave_critical_section(flags);
+
+  return buflen;
+}
+
+/****************************************************************************
+ * Name: latency_dup
+ *
+ * Description:
+ *   Duplicate open file data in the new file structure.
+ *
+ ****************************************************************************/
+
+static int latency_dup(FAR const struct file *oldp, FAR struct file *newp)
+{
+  FAR struct latency_file_s *oldattr;
+  FAR struct latency_file_s *newattr;
+
+  finfo("Dup %p->%p\n", oldp, newp);
+
+  /* Recover our private data from the old struct file instance */
+
+  oldattr = (FAR struct latency_file_s *)oldp->f_priv;
+  DEBUGASSERT(oldattr);
+
+  /* Allocate a new container to hold the task and attribute selection */
+
+  newattr = kmm_malloc(sizeof(struct latency_file_s));
+  if (!newattr)
+    {
+      ferr("ERROR: Failed to allocate file attributes\n");
+      return -ENOMEM;
+    }
+
+  /* The copy the file attributes from the old attributes to the new */
+
+  memcpy(newattr, oldattr, sizeof(struct latency_file_s));
+
+  /* Save the new attributes in the new file structure */
+
+  newp->f_priv = (FAR void *)newattr;
+  return OK;
+}
+
+/****************************************************************************
+ * Name: latency_stat
+ *
+ * Description: Return information about a file or directory
+ *
+ ****************************************************************************/
+
+static int latency_stat(FAR const char *relpath, FAR struct stat *buf)
+{
+  /* "latency" is the name for a read/write file */
+
+  memset(buf, 0, sizeof(struct stat));
+  buf->st_mode = S_IFREG | S_IROTH | S_IRGRP | S_IRUSR | S_IWUSR;
+  return OK;
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+#endif /* !CONFIG_DISABLE_MOUNTPOINT && CONFIG_FS_PROCFS && CONFIG_SCHED_LATENCYMONITOR */
@@ -0,0 +1,379 @@
+/****************************************************************************
+ * fs/procfs/fs_procfslockstat.c
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <sys/types.h>
+#include <sys/stat.h>
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdlib.h>
+#include <inttypes.h>
+#include <string.h>
+#include <fcntl.h>
+#include <time.h>
+#include <assert.h>
+#include <errno.h>
+#include <debug.h>
+
+#include <nuttx/clock.h>
+#include <nuttx/kmalloc.h>
+#include <nuttx/lockstat.h>
+#include <nuttx/fs/fs.h>
+#include <nuttx/fs/procfs.h>
+
+#if !defined(CONFIG_DISABLE_MOUNTPOINT) && defined(CONFIG_FS_PROCFS) && \
+     defined(CONFIG_SCHED_LOCKSTAT)
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+/* Output format, one line per lock class, the classes that waited the
+ * longest first.  Times are in microseconds.
+ *
+ *   CLASS      TYPE   ACQUIRED  CONTENDED    WAIT MAXWAIT    HOLD MAXHOLD
+ *   XXXXXXXXXX mutex DDDDDDDDD DDDDDDDDDD DDDDDDD DDDDDDD DDDDDDD DDDDDDD
+ *
+ * followed on the same line by up to LOCKSTAT_NWAITERS "PID:WAIT" pairs.
+ */
+
+#define LOCKSTAT_LINELEN  192
+#define LOCKSTAT_NCLASSES CONFIG_SCHED_LOCKSTAT_NCLASSES
+
+/****************************************************************************
+ * Private Types
+ ****************************************************************************/
+
+/* This structure describes one open "file".  The classes are copied when
+ * the file is opened so that all reads return consistent data.
+ */
+
+struct lockstat_file_s
+{
+  struct procfs_file_s base;        /* Base open file structure */
+  int nclasses;                     /* Number of classes in the snapshot */
+  struct lockstat_class_s classes[LOCKSTAT_NCLASSES];
+  char line[LOCKSTAT_LINELEN];      /* Formatted line */
+};
+
+/****************************************************************************
+ * Private Function Prototypes
+ ****************************************************************************/
+
+static int     lockstat_open(FAR struct file *filep, FAR const char *relpath,
+                             int oflags, mode_t mode);
+static int     lockstat_close(FAR struct file *filep);
+static ssize_t lockstat_read(FAR struct file *filep, FAR char *buffer,
+                             size_t buflen);
+static ssize_t lockstat_write(FAR struct file *filep,
+                              FAR const char *buffer, size_t buflen);
+static int     lockstat_dup(FAR const struct file *oldp,
+                            FAR struct file *newp);
+static int     lockstat_stat(FAR const char *relpath, FAR struct stat *buf);
+
+/****************************************************************************
+ * Public Data
+ ****************************************************************************/
+
+/* See fs_mount.c -- this structure is explicitly externed there.
+ * We use the old-fashioned kind of initializers so that this will compile
+ * with any compiler.
+ */
+
+const struct procfs_operations g_lockstat_operations =
+{
+  lockstat_open,      /* open */
+  lockstat_close,     /* close */
+  lockstat_read,      /* read */
+  lockstat_write,     /* write */
+
+  lockstat_dup,       /* dup */
+
+  NULL,               /* opendir */
+  NULL,               /* closedir */
+  NULL,               /* readdir */
+  NULL,               /* rewinddir */
+
+  lockstat_stat       /* stat */
+};
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: lockstat_usec
+ *
+ * Description:
+ *   Convert a perf_gettime() interval to microseconds.
+ *
+ ****************************************************************************/
+
+static uint64_t lockstat_usec(clock_t elapsed)
+{
+  struct timespec ts;
+
+  perf_convert(elapsed, &ts);
+  return (uint64_t)ts.tv_sec * USEC_PER_SEC + ts.tv_nsec / NSEC_PER_USEC;
+}
+
+/****************************************************************************
+ * Name: lockstat_compare
+ *
+ * Description:
+ *   qsort() comparison, the class that waited the longest comes first.
+ *
+ ****************************************************************************/
+
+static int lockstat_compare(FAR const void *a, FAR const void *b)
+{
+  FAR const struct lockstat_class_s *cls1 = a;
+  FAR const struct lockstat_class_s *cls2 = b;
+
+  if (cls1->wait_time != cls2->wait_time)
+    {
+      return cls1->wait_time < cls2->wait_time ? 1 : -1;
+    }
+
+  return cls1->nacquired < cls2->nacquired ? 1 :
+         cls1->nacquired > cls2->nacquired ? -1 : 0;
+}
+
+/****************************************************************************
+ * Name: lockstat_line
+ *
+ * Description:
+ *   Format the line of the class 'cls'.
+ *
+ ****************************************************************************/
+
+static size_t lockstat_line(FAR struct lockstat_file_s *attr,
+                            FAR const struct lockstat_class_s *cls)
+{
+  size_t linesize;
+  int i;
+
+  linesize = procfs_snprintf(attr->line, LOCKSTAT_LINELEN, "%-10p",
+                             cls->key);
+  linesize += procfs_snprintf(attr->line + linesize,
+                              LOCKSTAT_LINELEN - linesize,
+                              " %-5s %9" PRIu32 " %10" PRIu32
+                              " %7" PRIu64 " %7" PRIu64
+                              " %7" PRIu64 " %7" PRIu64,
+                              cls->type == LOCKSTAT_MUTEX ?
+                              "mutex" : "spin",
+                              cls->nacquired, cls->ncontended,
+                              lockstat_usec(cls->wait_time),
+                              lockstat_usec(cls->wait_max),
+                              lockstat_usec(cls->hold_time),
+                              lockstat_usec(cls->hold_max));
+
+  for (i = 0; i < LOCKSTAT_NWAITERS; i++)
+    {
+      if (cls->waiters[i].wait_time > 0)
+        {
+          linesize += procfs_snprintf(attr->line + linesize,
+                                      LOCKSTAT_LINELEN - linesize,
+                                      " %d:%" PRIu64,
+                                      (int)cls->waiters[i].pid,
+                                      lockstat_usec(
+                                        cls->waiters[i].wait_time));
+        }
+    }
+
+  linesize += procfs_snprintf(attr->line + linesize,
+                              LOCKSTAT_LINELEN - linesize, "\n");
+  return linesize;
+}
+
+/****************************************************************************
+ * Name: lockstat_open
+ ****************************************************************************/
+
+static int lockstat_open(FAR struct file *filep, FAR const char *relpath,
+                         int oflags, mode_t mode)
+{
+  FAR struct lockstat_file_s *attr;
+
+  finfo("Open '%s'\n", relpath);
+
+  /* Allocate a container to hold the file attributes */
+
+  attr = kmm_zalloc(sizeof(struct lockstat_file_s));
+  if (!attr)
+    {
+      ferr("ERROR: Failed to allocate file attributes\n");
+      return -ENOMEM;
+    }
+
+  /* Take a snapshot of the classes */
+
+  attr->nclasses = lockstat_snapshot(attr->classes, LOCKSTAT_NCLASSES);
+  qsort(attr->classes, attr->nclasses, sizeof(struct lockstat_class_s),
+        lockstat_compare);
+
+  /* Save the attributes as the open-specific state in filep->f_priv */
+
+  filep->f_priv = (FAR void *)attr;
+  return OK;
+}
+
+/****************************************************************************
+ * Name: lockstat_close
+ ****************************************************************************/
+
+static int lockstat_close(FAR struct file *filep)
+{
+  FAR struct lockstat_file_s *attr;
+
+  /* Recover our private data from the struct file instance */
+
+  attr = (FAR struct lockstat_file_s *)filep->f_priv;
+  DEBUGASSERT(attr);
+
+  /* Release the file attributes structure */
+
+  kmm_free(attr);
+  filep->f_priv = NULL;
+  return OK;
+}
+
+/****************************************************************************
+ * Name: lockstat_read
+ ****************************************************************************/
+
+static ssize_t lockstat_read(FAR struct file *filep, FAR char *buffer,
+                             size_t buflen)
+{
+  FAR struct lockstat_file_s *attr;
+  size_t linesize;
+  size_t copysize;
+  size_t totalsize;
+  off_t offset;
+  int index;
+
+  finfo("buffer=%p buflen=%d\n", buffer, (int)buflen);
+
+  /* Recover our private data from the struct file instance */
+
+  attr = (FAR struct lockstat_file_s *)filep->f_priv;
+  DEBUGASSERT(attr);
+
+  offset   = filep->f_pos;
+  linesize = procfs_snprintf(attr->line, LOCKSTAT_LINELEN,
+                             "%-10s %-5s %9s %10s %7s %7s %7s %7s %s\n",
+                             "CLASS", "TYPE", "ACQUIRED", "CONTENDED",
+                             "WAIT", "MAXWAIT", "HOLD", "MAXHOLD",
+                             "WAITERS");
+  totalsize = procfs_memcpy(attr->line, linesize, buffer, buflen, &offset);
+
+  for (index = 0; index < attr->nclasses && totalsize < buflen; index++)
+    {
+      linesize   = lockstat_line(attr, &attr->classes[index]);
+      copysize   = procfs_memcpy(attr->line, linesize, buffer + totalsize,
+                                 buflen - totalsize, &offset);
+      totalsize += copysize;
+    }
+
+  filep->f_pos += totalsize;
+  return totalsize;
+}
+
+/****************************************************************************
+ * Name: lockstat_write
+ *
+ * Description:
+ *   Writing anything to the file clears the statistics.
+ *
+ ****************************************************************************/
+
+static ssize_t lockstat_write(FAR struct file *filep,
+                              FAR const char *buffer, size_t buflen)
+{
+  lockstat_reset();
+  return buflen;
+}
+
+/****************************************************************************
+ * Name: lockstat_dup
+ *
+ * Description:
+ *   Duplicate open file data in the new file structure.
+ *
+ ****************************************************************************/
+
+static int lockstat_dup(FAR const struct file *oldp, FAR struct file *newp)
+{
+  FAR struct lockstat_file_s *oldattr;
+  FAR struct lockstat_file_s *newattr;
+
+  finfo("Dup %p->%p\n", oldp, newp);
+
+  /* Recover our private data from the old struct file instance */
+
+  oldattr = (FAR struct lockstat_file_s *)oldp->f_priv;
+  DEBUGASSERT(oldattr);
+
+  /* Allocate a new container to hold the task and attribute selection */
+
+  newattr = kmm_malloc(sizeof(struct lockstat_file_s));
+  if (!newattr)
+    {
+      ferr("ERROR: Failed to allocate file attributes\n");
+      return -ENOMEM;
+    }
+
+  /* The copy the file attributes from the old attributes to the new */
+
+  memcpy(newattr, oldattr, sizeof(struct lockstat_file_s));
+
+  /* Save the new attributes in the new file structure */
+
+  newp->f_priv = (FAR void *)newattr;
+  return OK;
+}
+
+/****************************************************************************
+ * Name: lockstat_stat
+ *
+ * Description: Return information about a file or directory
+ *
+ ****************************************************************************/
+
+static int lockstat_stat(FAR const char *relpath, FAR struct stat *buf)
+{
+  /* "lockstat" is the name for a read/write file */
+
+  memset(buf, 0, sizeof(struct stat));
+  buf->st_mode = S_IFREG | S_IROTH | S_IRGRP | S_IRUSR | S_IWUSR;
+  return OK;
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+#endif /* !CONFIG_DISABLE_MOUNTPOINT && CONFIG_FS_PROCFS && CONFIG_SCHED_LOCKSTAT */
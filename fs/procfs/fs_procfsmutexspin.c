@@ -0,0 +1,295 @@
+/****************************************************************************
+ * fs/procfs/fs_procfsmutexspin.c
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <sys/types.h>
+#include <sys/stat.h>
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <inttypes.h>
+#include <string.h>
+#include <fcntl.h>
+#include <assert.h>
+#include <errno.h>
+#include <debug.h>
+
+#include <nuttx/irq.h>
+#include <nuttx/kmalloc.h>
+#include <nuttx/mutex.h>
+#include <nuttx/fs/fs.h>
+#include <nuttx/fs/procfs.h>
+
+#if !defined(CONFIG_DISABLE_MOUNTPOINT) && defined(CONFIG_FS_PROCFS) && \
+     defined(CONFIG_MUTEX_SPIN)
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+/* Output format, one line per CPU:
+ *
+ *   CPU        SPIN      BLOCK
+ *   DDD  DDDDDDDDDD DDDDDDDDDD
+ */
+
+#define MUTEXSPIN_LINELEN 32
+
+/****************************************************************************
+ * Private Types
+ ****************************************************************************/
+
+/* This structure describes one open "file".  The counters are copied when
+ * the file is opened so that all reads return consistent data.
+ */
+
+struct mutexspin_file_s
+{
+  struct procfs_file_s base;                  /* Base open file structure */
+  struct mutex_spin_s stat[CONFIG_SMP_NCPUS]; /* Counters of each CPU */
+  char line[MUTEXSPIN_LINELEN];               /* Formatted line */
+};
+
+/****************************************************************************
+ * Private Function Prototypes
+ ****************************************************************************/
+
+static int     mutexspin_open(FAR struct file *filep,
+                              FAR const char *relpath,
+                              int oflags, mode_t mode);
+static int     mutexspin_close(FAR struct file *filep);
+static ssize_t mutexspin_read(FAR struct file *filep, FAR char *buffer,
+                              size_t buflen);
+static ssize_t mutexspin_write(FAR struct file *filep,
+                               FAR const char *buffer, size_t buflen);
+static int     mutexspin_dup(FAR const struct file *oldp,
+                             FAR struct file *newp);
+static int     mutexspin_stat(FAR const char *relpath,
+                              FAR struct stat *buf);
+
+/****************************************************************************
+ * Public Data
+ ****************************************************************************/
+
+/* See fs_mount.c -- this structure is explicitly externed there.
+ * We use the old-fashioned kind of initializers so that this will compile
+ * with any compiler.
+ */
+
+const struct procfs_operations g_mutexspin_operations =
+{
+  mutexspin_open,     /* open */
+  mutexspin_close,    /* close */
+  mutexspin_read,     /* read */
+  mutexspin_write,    /* write */
+
+  mutexspin_dup,      /* dup */
+
+  NULL,               /* opendir */
+  NULL,               /* closedir */
+  NULL,               /* readdir */
+  NULL,               /* rewinddir */
+
+  mutexspin_stat      /* stat */
+};
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: mutexspin_open
+ ****************************************************************************/
+
+static int mutexspin_open(FAR struct file *filep, FAR const char *relpath,
+                          int oflags, mode_t mode)
+{
+  FAR struct mutexspin_file_s *attr;
+  irqstate_t flags;
+
+  finfo("Open '%s'\n", relpath);
+
+  /* Allocate a container to hold the file attributes */
+
+  attr = kmm_zalloc(sizeof(struct mutexspin_file_s));
+  if (!attr)
+    {
+      ferr("ERROR: Failed to allocate file attributes\n");
+      return -ENOMEM;
+    }
+
+  /* Take a snapshot of the counters */
+
+  flags = enter_critical_section();
+  memcpy(attr->stat, g_mutex_spin, sizeof(g_mutex_spin));
+  leave_critical_section(flags);
+
+  /* Save the attributes as the open-specific state in filep->f_priv */
+
+  filep->f_priv = (FAR void *)attr;
+  return OK;
+}
+
+/****************************************************************************
+ * Name: mutexspin_close
+ ****************************************************************************/
+
+static int mutexspin_close(FAR struct file *filep)
+{
+  FAR struct mutexspin_file_s *attr;
+
+  /* Recover our private data from the struct file instance */
+
+  attr = (FAR struct mutexspin_file_s *)filep->f_priv;
+  DEBUGASSERT(attr);
+
+  /* Release the file attributes structure */
+
+  kmm_free(attr);
+  filep->f_priv = NULL;
+  return OK;
+}
+
+/****************************************************************************
+ * Name: mutexspin_read
+ ****************************************************************************/
+
+static ssize_t mutexspin_read(FAR struct file *filep, FAR char *buffer,
+                              size_t buflen)
+{
+  FAR struct mutexspin_file_s *attr;
+  size_t linesize;
+  size_t copysize;
+  size_t totalsize;
+  off_t offset;
+  int cpu;
+
+  finfo("buffer=%p buflen=%d\n", buffer, (int)buflen);
+
+  /* Recover our private data from the struct file instance */
+
+  attr = (FAR struct mutexspin_file_s *)filep->f_priv;
+  DEBUGASSERT(attr);
+
+  offset   = filep->f_pos;
+  linesize = procfs_snprintf(attr->line, MUTEXSPIN_LINELEN,
+                             "%-3s %11s %10s\n", "CPU", "SPIN", "BLOCK");
+  totalsize = procfs_memcpy(attr->line, linesize, buffer, buflen, &offset);
+
+  for (cpu = 0; cpu < CONFIG_SMP_NCPUS && totalsize < buflen; cpu++)
+    {
+      linesize   = procfs_snprintf(attr->line, MUTEXSPIN_LINELEN,
+                                   "%-3d %11" PRIu32 " %10" PRIu32 "\n",
+                                   cpu, attr->stat[cpu].nspin,
+                                   attr->stat[cpu].nblock);
+      copysize   = procfs_memcpy(attr->line, linesize, buffer + totalsize,
+                                 buflen - totalsize, &offset);
+      totalsize += copysize;
+    }
+
+  filep->f_pos += totalsize;
+  return totalsize;
+}
+
+/****************************************************************************
+ * Name: mutexspin_write
+ *
+ * Description:
+ *   Writing anything to the file clears the counters.
+ *
+ ****************************************************************************/
+
+static ssize_t mutexspin_write(FAR struct file *filep,
+                               FAR const char *buffer, size_t buflen)
+{
+  irqstate_t flags;
+
+  flags = enter_critical_section();
+  memset(g_mutex_spin, 0, sizeof(g_mutex_spin));
+  leave_critical_section(flags);
+
+  return buflen;
+}
+
+/****************************************************************************
+ * Name: mutexspin_dup
+ *
+ * Description:
+ *   Duplicate open file data in the new file structure.
+ *
+ ****************************************************************************/
+
+static int mutexspin_dup(FAR const struct file *oldp, FAR struct file *newp)
+{
+  FAR struct mutexspin_file_s *oldattr;
+  FAR struct mutexspin_file_s *newattr;
+
+  finfo("Dup %p->%p\n", oldp, newp);
+
+  /* Recover our private data from the old struct file instance */
+
+  oldattr = (FAR struct mutexspin_file_s *)oldp->f_priv;
+  DEBUGASSERT(oldattr);
+
+  /* Allocate a new container to hold the task and attribute selection */
+
+  newattr = kmm_malloc(sizeof(struct mutexspin_file_s));
+  if (!newattr)
+    {
+      ferr("ERROR: Failed to allocate file attributes\n");
+      return -ENOMEM;
+    }
+
+  /* The copy the file attributes from the old attributes to the new */
+
+  memcpy(newattr, oldattr, sizeof(struct mutexspin_file_s));
+
+  /* Save the new attributes in the new file structure */
+
+  newp->f_priv = (FAR void *)newattr;
+  return OK;
+}
+
+/****************************************************************************
+ * Name: mutexspin_stat
+ *
+ * Description: Return information about a file or directory
+ *
+ ****************************************************************************/
+
+static int mutexspin_stat(FAR const char *relpath, FAR struct stat *buf)
+{
+  /* "mutexspin" is the name for a read/write file */
+
+  memset(buf, 0, sizeof(struct stat));
+  buf->st_mode = S_IFREG | S_IROTH | S_IRGRP | S_IRUSR | S_IWUSR;
+  return OK;
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+#endif /* !CONFIG_DISABLE_MOUNTPOINT && CONFIG_FS_PROCFS && CONFIG_MUTEX_SPIN */
@@ -26,6 +26,7 @@
 
 #include <sys/types.h>
 #include <sys/stat.h>
+#include <sys/param.h>
 
 #include <stdint.h>
 #include <stdbool.h>
@@ -90,6 +91,15 @@ enum proc_node_e
 #ifdef CONFIG_SCHED_CRITMONITOR
   PROC_CRITMON,                       /* Critical section monitor */
 #endif
+#ifdef CONFIG_SCHED_LATENCYMONITOR
+  PROC_LATENCY,                       /* Wakeup latency histogram */
+#endif
+#ifdef CONFIG_SCHED_SCHEDSTAT
+  PROC_SCHEDSTAT,                     /* Scheduler statistics */
+#endif
+#ifdef CONFIG_SCHED_SYSCALLSTAT
+  PROC_SYSCALLS,                      /* System call statistics */
+#endif
 #if CONFIG_MM_BACKTRACE >= 0
   PROC_HEAP,                          /* Task heap info */
 #endif
@@ -181,6 +191,21 @@ static ssize_t proc_critmon(FAR struct proc_file_s *procfile,
                  FAR struct tcb_s *tcb, FAR char *buffer, size_t buflen,
                  off_t offset);
 #endif
+#ifdef CONFIG_SCHED_LATENCYMONITOR
+static ssize_t proc_latency(FAR struct proc_file_s *procfile,
+                 FAR struct tcb_s *tcb, FAR char *buffer, size_t buflen,
+                 off_t offset);
+#endif
+#ifdef CONFIG_SCHED_SCHEDSTAT
+static ssize_t proc_schedstat(FAR struct proc_file_s *procfile,
+                 FAR struct tcb_s *tcb, FAR char *buffer, size_t buflen,
+                 off_t offset);
+#endif
+#ifdef CONFIG_SCHED_SYSCALLSTAT
+static ssize_t proc_syscalls(FAR struct proc_file_s *procfile,
+                 FAR struct tcb_s *tcb, FAR char *buffer, size_t buflen,
+                 off_t offset);
+#endif
 #if CONFIG_MM_BACKTRACE >= 0
 static ssize_t proc_heap(FAR struct proc_file_s *procfile,
                          FAR struct tcb_s *tcb, FAR char *buffer,
@@ -292,6 +317,27 @@ static const struct proc_node_s g_critmon =
 };
 #endif
 
+#ifdef CONFIG_SCHED_LATENCYMONITOR
+static const struct proc_node_s g_latency =
+{
+  "latency",       "latency", (uint8_t)PROC_LATENCY,     DTYPE_FILE        /* Wakeup latency histogram */
+};
+#endif
+
+#ifdef CONFIG_SCHED_SCHEDSTAT
+static const struct proc_node_s g_schedstat =
+{
+  "schedstat",     "schedstat", (uint8_t)PROC_SCHEDSTAT, DTYPE_FILE        /* Scheduler statistics */
+};
+#endif
+
+#ifdef CONFIG_SCHED_SYSCALLSTAT
+static const struct proc_node_s g_syscalls =
+{
+  "syscalls",      "syscalls", (uint8_t)PROC_SYSCALLS,   DTYPE_FILE        /* System call statistics */
+};
+#endif
+
 #if CONFIG_MM_BACKTRACE >= 0
 static const struct proc_node_s g_heap =
 {
@@ -346,6 +392,15 @@ static FAR const struct proc_node_s * const g_nodeinfo[] =
 #ifdef CONFIG_SCHED_CRITMONITOR
   &g_critmon,      /* Critical section Monitor */
 #endif
+#ifdef CONFIG_SCHED_LATENCYMONITOR
+  &g_latency,      /* Wakeup latency histogram */
+#endif
+#ifdef CONFIG_SCHED_SCHEDSTAT
+  &g_schedstat,    /* Scheduler statistics */
+#endif
+#ifdef CONFIG_SCHED_SYSCALLSTAT
+  &g_syscalls,     /* System call statistics */
+#endif
 #if CONFIG_MM_BACKTRACE >= 0
   &g_heap,         /* Task heap info */
 #endif
@@ -375,6 +430,15 @@ static const struct proc_node_s * const g_level0info[] =
 #ifdef CONFIG_SCHED_CRITMONITOR
   &g_critmon,      /* Critical section monitor */
 #endif
+#ifdef CONFIG_SCHED_LATENCYMONITOR
+  &g_latency,      /* Wakeup latency histogram */
+#endif
+#ifdef CONFIG_SCHED_SCHEDSTAT
+  &g_schedstat,    /* Scheduler statistics */
+#endif
+#ifdef CONFIG_SCHED_SYSCALLSTAT
+  &g_syscalls,     /* System call statistics */
+#endif
 #if CONFIG_MM_BACKTRACE >= 0
   &g_heap,         /* Task heap info */
 #endif
@@ -870,6 +934,233 @@ static ssize_t proc_critmon(FAR struct proc_file_s *procfile,
 }
 #endif
 
+/****************************************************************************
+ * Name: proc_latency
+ ****************************************************************************/
+
+#ifdef CONFIG_SCHED_LATENCYMONITOR
+static ssize_t proc_latency(FAR struct proc_file_s *procfile,
+                            FAR struct tcb_s *tcb, FAR char *buffer,
+                            size_t buflen, off_t offset)
+{
+  static const unsigned int permille[] =
+  {
+    500, 990, 999
+  };
+
+  static FAR const char * const label[] =
+  {
+    "p50", "p99", "p99.9"
+  };
+
+  struct latency_hist_s hist;
+  irqstate_t flags;
+  size_t linesize;
+  size_t copysize;
+  size_t totalsize;
+  int i;
+
+  flags = enter_critical_section();
+  memcpy(&hist, &tcb->wakeup_latency, sizeof(hist));
+  leave_critical_section(flags);
+
+  /* One line per non-empty bucket, starting with the lower bound of the
+   * bucket in nanoseconds, followed by the percentiles.
+   */
+
+  linesize  = procfs_snprintf(procfile->line, STATUS_LINELEN,
+                              "%-10s %10s\n", "NSEC", "WAKEUP");
+  totalsize = procfs_memcpy(procfile->line, linesize, buffer, buflen,
+                            &offset);
+
+  for (i = 0; i < LATENCY_NBUCKETS && totalsize < buflen; i++)
+    {
+      if (hist.count[i] == 0)
+        {
+          continue;
+        }
+
+      linesize   = procfs_snprintf(procfile->line, STATUS_LINELEN,
+                                   "%-10" PRIu64 " %10" PRIu32 "\n",
+                                   i > 0 ? UINT64_C(1) << i : 0,
+                                   hist.count[i]);
+      copysize   = procfs_memcpy(procfile->line, linesize,
+                                 buffer + totalsize, buflen - totalsize,
+                                 &offset);
+      totalsize += copysize;
+    }
+
+  for (i = 0; i < nitems(permille) + 1 && totalsize < buflen; i++)
+    {
+      linesize   = procfs_snprintf(procfile->line, STATUS_LINELEN,
+                                   "%-10s %10" PRIu64 "\n",
+                                   i < nitems(permille) ? label[i] : "max",
+                                   i < nitems(permille) ?
+                                   nxsched_latency_percentile(&hist,
+                                                              permille[i]) :
+                                   hist.max);
+      copysize   = procfs_memcpy(procfile->line, linesize,
+                                 buffer + totalsize, buflen - totalsize,
+                                 &offset);
+      totalsize += copysize;
+    }
+
+  return totalsize;
+}
+#endif
+
+/****************************************************************************
+ * Name: proc_schedstat
+ ****************************************************************************/
+
+#ifdef CONFIG_SCHED_SCHEDSTAT
+static ssize_t proc_schedstat(FAR struct proc_file_s *procfile,
+                              FAR struct tcb_s *tcb, FAR char *buffer,
+                              size_t buflen, off_t offset)
+{
+  static FAR const char * const timelabel[] =
+  {
+    "ExecTime:", "WaitTime:", "WaitMax:"
+  };
+
+  static FAR const char * const countlabel[] =
+  {
+    "Switches:", "Voluntary:", "Involuntary:", "Preempted:"
+#ifdef CONFIG_SMP
+    , "Migrations:"
+#endif
+  };
+
+  struct schedstat_s stat;
+  struct timespec ts;
+  clock_t times[nitems(timelabel)];
+  uint32_t counts[nitems(countlabel)];
+  irqstate_t flags;
+  size_t linesize;
+  size_t copysize;
+  size_t totalsize = 0;
+  int i;
+
+  flags = enter_critical_section();
+  memcpy(&stat, &tcb->schedstat, sizeof(stat));
+
+  /* Include the time of the current run or wait */
+
+  if (stat.stamp != 0)
+    {
+      if (tcb->task_state == TSTATE_TASK_RUNNING)
+        {
+          stat.exec_time += perf_gettime() - stat.stamp;
+        }
+      else
+        {
+          stat.wait_time += perf_gettime() - stat.stamp;
+        }
+    }
+
+  leave_critical_section(flags);
+
+  times[0]  = stat.exec_time;
+  times[1]  = stat.wait_time;
+  times[2]  = stat.wait_max;
+
+  counts[0] = stat.nr_run;
+  counts[1] = stat.nr_vcsw;
+  counts[2] = stat.nr_ivcsw;
+  counts[3] = stat.nr_preempt;
+#ifdef CONFIG_SMP
+  counts[4] = stat.nr_migrate;
+#endif
+
+  for (i = 0; i < nitems(timelabel) && totalsize < buflen; i++)
+    {
+      perf_convert(times[i], &ts);
+      linesize   = procfs_snprintf(procfile->line, STATUS_LINELEN,
+                                   "%-13s%lu.%09lu\n", timelabel[i],
+                                   (unsigned long)ts.tv_sec,
+                                   (unsigned long)ts.tv_nsec);
+      copysize   = procfs_memcpy(procfile->line, linesize,
+                                 buffer + totalsize, buflen - totalsize,
+                                 &offset);
+      totalsize += copysize;
+    }
+
+  for (i = 0; i < nitems(countlabel) && totalsize < buflen; i++)
+    {
+      linesize   = procfs_snprintf(procfile->line, STATUS_LINELEN,
+                                   "%-13s%" PRIu32 "\n", countlabel[i],
+                                   counts[i]);
+      copysize   = procfs_memcpy(procfile->line, linesize,
+                                 buffer + totalsize, buflen - totalsize,
+                                 &offset);
+      totalsize += copysize;
+    }
+
+  return totalsize;
+}
+#endif
+
+/****************************************************************************
+ * Name: proc_syscalls
+ ****************************************************************************/
+
+#ifdef CONFIG_SCHED_SYSCALLSTAT
+static ssize_t proc_syscalls(FAR struct proc_file_s *procfile,
+                             FAR struct tcb_s *tcb, FAR char *buffer,
+                             size_t buflen, off_t offset)
+{
+  struct timespec ts[2];
+  irqstate_t flags;
+  uint32_t count;
+  clock_t time;
+  clock_t max;
+  size_t linesize;
+  size_t copysize;
+  size_t totalsize;
+
+  flags = enter_critical_section();
+  count = tcb->syscall_count;
+  time  = tcb->syscall_time;
+  max   = tcb->syscall_max;
+  leave_critical_section(flags);
+
+  perf_convert(time, &ts[0]);
+  perf_convert(max, &ts[1]);
+
+  linesize   = procfs_snprintf(procfile->line, STATUS_LINELEN,
+                               "%-13s%" PRIu32 "\n", "Count:", count);
+  copysize   = procfs_memcpy(procfile->line, linesize, buffer, buflen,
+                             &offset);
+  totalsize  = copysize;
+
+  if (totalsize < buflen)
+    {
+      linesize   = procfs_snprintf(procfile->line, STATUS_LINELEN,
+                                   "%-13s%lu.%09lu\n", "Time:",
+                                   (unsigned long)ts[0].tv_sec,
+                                   (unsigned long)ts[0].tv_nsec);
+      copysize   = procfs_memcpy(procfile->line, linesize,
+                                 buffer + totalsize, buflen - totalsize,
+                                 &offset);
+      totalsize += copysize;
+    }
+
+  if (totalsize < buflen)
+    {
+      linesize   = procfs_snprintf(procfile->line, STATUS_LINELEN,
+                                   "%-13s%lu.%09lu\n", "MaxTime:",
+                                   (unsigned long)ts[1].tv_sec,
+                                   (unsigned long)ts[1].tv_nsec);
+      copysize   = procfs_memcpy(procfile->line, linesize,
+                                 buffer + totalsize, buflen - totalsize,
+                                 &offset);
+      totalsize += copysize;
+    }
+
+  return totalsize;
+}
+#endif
+
 /****************************************************************************
  * Name: proc_heap
  ****************************************************************************/
@@ -1531,6 +1822,21 @@ static ssize_t proc_read(FAR struct file *filep, FAR char *buffer,
       ret = proc_critmon(procfile, tcb, buffer, buflen, filep->f_pos);
       break;
 #endif
+#ifdef CONFIG_SCHED_LATENCYMONITOR
+    case PROC_LATENCY: /* Wakeup latency histogram */
+      ret = proc_latency(procfile, tcb, buffer, buflen, filep->f_pos);
+      break;
+#endif
+#ifdef CONFIG_SCHED_SCHEDSTAT
+    case PROC_SCHEDSTAT: /* Scheduler statistics */
+      ret = proc_schedstat(procfile, tcb, buffer, buflen, filep->f_pos);
+      break;
+#endif
+#ifdef CONFIG_SCHED_SYSCALLSTAT
+    case PROC_SYSCALLS: /* System call statistics */
+      ret = proc_syscalls(procfile, tcb, buffer, buflen, filep->f_pos);
+      break;
+#endif
 #if CONFIG_MM_BACKTRACE >= 0
     case PROC_HEAP: /* Task heap info */
       ret = proc_heap(procfile, tcb, buffer, buflen, filep->f_pos);
@@ -1609,6 +1915,50 @@ static ssize_t proc_write(FAR struct file *filep, FAR const char *buffer,
                                    filep->f_pos);
         break;
 #endif
+#ifdef CONFIG_SCHED_LATENCYMONITOR
+      case PROC_LATENCY:
+
+        /* Writing anything clears the histogram */
+
+        memset(&tcb->wakeup_latency, 0, sizeof(tcb->wakeup_latency));
+        ret = buflen;
+        break;
+#endif
+#ifdef CONFIG_SCHED_SCHEDSTAT
+      case PROC_SCHEDSTAT:
+        {
+          irqstate_t flags;
+          clock_t stamp;
+
+          /* Writing anything clears the counters.  Keep the time stamp
+           * of a running or waiting thread.
+           */
+
+          flags = enter_critical_section();
+          stamp = tcb->schedstat.stamp;
+          memset(&tcb->schedstat, 0, sizeof(tcb->schedstat));
+          tcb->schedstat.stamp = stamp;
+          leave_critical_section(flags);
+          ret = buflen;
+        }
+        break;
+#endif
+#ifdef CONFIG_SCHED_SYSCALLSTAT
+      case PROC_SYSCALLS:
+        {
+          irqstate_t flags;
+
+          /* Writing anything clears the counters */
+
+          flags = enter_critical_section();
+          tcb->syscall_count = 0;
+          tcb->syscall_time  = 0;
+          tcb->syscall_max   = 0;
+          leave_critical_section(flags);
+          ret = buflen;
+        }
+        break;
+#endif
 
       default:
         ret = -EINVAL;
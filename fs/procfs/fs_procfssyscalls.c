@@ -0,0 +1,352 @@
+/****************************************************************************
+ * fs/procfs/fs_procfssyscalls.c
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <sys/types.h>
+#include <sys/stat.h>
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <inttypes.h>
+#include <string.h>
+#include <fcntl.h>
+#include <time.h>
+#include <assert.h>
+#include <errno.h>
+#include <debug.h>
+
+#include <nuttx/clock.h>
+#include <nuttx/sched.h>
+#include <nuttx/kmalloc.h>
+#include <nuttx/fs/fs.h>
+#include <nuttx/fs/procfs.h>
+
+#include <syscall.h>
+
+#if !defined(CONFIG_DISABLE_MOUNTPOINT) && defined(CONFIG_FS_PROCFS) && \
+     defined(CONFIG_SCHED_SYSCALLSTAT)
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+/* Output format, one line per system call that was called:
+ *
+ *   NAME CALLS TOTAL AVG MAX P50 P99
+ *
+ * Times are in microseconds, the percentiles being upper bounds taken from
+ * the histogram.
+ */
+
+#define SYSCALLS_LINELEN  96
+
+/****************************************************************************
+ * Private Types
+ ****************************************************************************/
+
+/* This structure describes one open "file".  The statistics are copied
+ * when the file is opened so that all reads return consistent data.
+ */
+
+struct syscalls_file_s
+{
+  struct procfs_file_s base;                 /* Base open file structure */
+  struct syscallstat_s stats[SYS_nsyscalls]; /* Indexed by syscall number */
+  char line[SYSCALLS_LINELEN];               /* Formatted line */
+};
+
+/****************************************************************************
+ * Private Function Prototypes
+ ****************************************************************************/
+
+static int     syscalls_open(FAR struct file *filep, FAR const char *relpath,
+                             int oflags, mode_t mode);
+static int     syscalls_close(FAR struct file *filep);
+static ssize_t syscalls_read(FAR struct file *filep, FAR char *buffer,
+                             size_t buflen);
+static ssize_t syscalls_write(FAR struct file *filep,
+                              FAR const char *buffer, size_t buflen);
+static int     syscalls_dup(FAR const struct file *oldp,
+                            FAR struct file *newp);
+static int     syscalls_stat(FAR const char *relpath, FAR struct stat *buf);
+
+/****************************************************************************
+ * Public Data
+ ****************************************************************************/
+
+/* See fs_mount.c -- this structure is explicitly externed there.
+ * We use the old-fashioned kind of initializers so that this will compile
+ * with any compiler.
+ */
+
+const struct procfs_operations g_syscalls_operations =
+{
+  syscalls_open,      /* open */
+  syscalls_close,     /* close */
+  syscalls_read,      /* read */
+  syscalls_write,     /* write */
+
+  syscalls_dup,       /* dup */
+
+  NULL,               /* opendir */
+  NULL,               /* closedir */
+  NULL,               /* readdir */
+  NULL,               /* rewinddir */
+
+  syscalls_stat       /* stat */
+};
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: syscalls_usec
+ *
+ * Description:
+ *   Convert a perf_gettime() interval to microseconds.
+ *
+ ****************************************************************************/
+
+static uint64_t syscalls_usec(clock_t elapsed)
+{
+  struct timespec ts;
+
+  perf_convert(elapsed, &ts);
+  return (uint64_t)ts.tv_sec * USEC_PER_SEC + ts.tv_nsec / NSEC_PER_USEC;
+}
+
+/****************************************************************************
+ * Name: syscalls_percentile
+ *
+ * Description:
+ *   Return an upper bound, in microseconds, of the duration below which
+ *   'permille' thousandths of the calls fall.
+ *
+ ****************************************************************************/
+
+static uint64_t syscalls_percentile(FAR const struct syscallstat_s *stat,
+                                    unsigned int permille)
+{
+  uint64_t target = ((uint64_t)stat->count * permille + 999) / 1000;
+  uint64_t total = 0;
+  uint64_t bound;
+  uint64_t max = syscalls_usec(stat->max);
+  int i;
+
+  for (i = 0; i < SYSCALLSTAT_NBUCKETS - 1; i++)
+    {
+      total += stat->hist[i];
+      if (total >= target)
+        {
+          break;
+        }
+    }
+
+  bound = i < SYSCALLSTAT_NBUCKETS - 1 ? (UINT64_C(1) << (i + 1)) - 1 : max;
+  return bound < max ? bound : max;
+}
+
+/****************************************************************************
+ * Name: syscalls_open
+ ****************************************************************************/
+
+static int syscalls_open(FAR struct file *filep, FAR const char *relpath,
+                         int oflags, mode_t mode)
+{
+  FAR struct syscalls_file_s *attr;
+
+  finfo("Open '%s'\n", relpath);
+
+  /* Allocate a container to hold the file attributes */
+
+  attr = kmm_zalloc(sizeof(struct syscalls_file_s));
+  if (!attr)
+    {
+      ferr("ERROR: Failed to allocate file attributes\n");
+      return -ENOMEM;
+    }
+
+  /* Take a snapshot of the statistics */
+
+  nxsched_syscall_snapshot(attr->stats, SYS_nsyscalls);
+
+  /* Save the attributes as the open-specific state in filep->f_priv */
+
+  filep->f_priv = (FAR void *)attr;
+  return OK;
+}
+
+/****************************************************************************
+ * Name: syscalls_close
+ ****************************************************************************/
+
+static int syscalls_close(FAR struct file *filep)
+{
+  FAR struct syscalls_file_s *attr;
+
+  /* Recover our private data from the struct file instance */
+
+  attr = (FAR struct syscalls_file_s *)filep->f_priv;
+  DEBUGASSERT(attr);
+
+  /* Release the file attributes structure */
+
+  kmm_free(attr);
+  filep->f_priv = NULL;
+  return OK;
+}
+
+/****************************************************************************
+ * Name: syscalls_read
+ ****************************************************************************/
+
+static ssize_t syscalls_read(FAR struct file *filep, FAR char *buffer,
+                             size_t buflen)
+{
+  FAR struct syscalls_file_s *attr;
+  FAR struct syscallstat_s *stat;
+  size_t linesize;
+  size_t copysize;
+  size_t totalsize;
+  off_t offset;
+  int nr;
+
+  finfo("buffer=%p buflen=%d\n", buffer, (int)buflen);
+
+  /* Recover our private data from the struct file instance */
+
+  attr = (FAR struct syscalls_file_s *)filep->f_priv;
+  DEBUGASSERT(attr);
+
+  offset   = filep->f_pos;
+  linesize = procfs_snprintf(attr->line, SYSCALLS_LINELEN,
+                             "%-20s %10s %10s %8s %8s %8s %8s\n",
+                             "NAME", "CALLS", "TOTAL", "AVG", "MAX",
+                             "P50", "P99");
+  totalsize = procfs_memcpy(attr->line, linesize, buffer, buflen, &offset);
+
+  for (nr = 0; nr < SYS_nsyscalls && totalsize < buflen; nr++)
+    {
+      stat = &attr->stats[nr];
+      if (stat->count == 0)
+        {
+          continue;
+        }
+
+      linesize   = procfs_snprintf(attr->line, SYSCALLS_LINELEN,
+                                   "%-20s %10" PRIu32 " %10" PRIu64
+                                   " %8" PRIu64 " %8" PRIu64
+                                   " %8" PRIu64 " %8" PRIu64 "\n",
+                                   g_funcnames[nr], stat->count,
+                                   syscalls_usec(stat->time),
+                                   syscalls_usec(stat->time / stat->count),
+                                   syscalls_usec(stat->max),
+                                   syscalls_percentile(stat, 500),
+                                   syscalls_percentile(stat, 990));
+      copysize   = procfs_memcpy(attr->line, linesize, buffer + totalsize,
+                                 buflen - totalsize, &offset);
+      totalsize += copysize;
+    }
+
+  filep->f_pos += totalsize;
+  return totalsize;
+}
+
+/****************************************************************************
+ * Name: syscalls_write
+ *
+ * Description:
+ *   Writing anything to the file clears the statistics.
+ *
+ ****************************************************************************/
+
+static ssize_t syscalls_write(FAR struct file *filep,
+                              FAR const char *buffer, size_t buflen)
+{
+  nxsched_syscall_reset();
+  return buflen;
+}
+
+/****************************************************************************
+ * Name: syscalls_dup
+ *
+ * Description:
+ *   Duplicate open file data in the new file structure.
+ *
+ ****************************************************************************/
+
+static int syscalls_dup(FAR const struct file *oldp, FAR struct file *newp)
+{
+  FAR struct syscalls_file_s *oldattr;
+  FAR struct syscalls_file_s *newattr;
+
+  finfo("Dup %p->%p\n", oldp, newp);
+
+  /* Recover our private data from the old struct file instance */
+
+  oldattr = (FAR struct syscalls_file_s *)oldp->f_priv;
+  DEBUGASSERT(oldattr);
+
+  /* Allocate a new container to hold the task and attribute selection */
+
+  newattr = kmm_malloc(sizeof(struct syscalls_file_s));
+  if (!newattr)
+    {
+      ferr("ERROR: Failed to allocate file attributes\n");
+      return -ENOMEM;
+    }
+
+  /* The copy the file attributes from the old attributes to the new */
+
+  memcpy(newattr, oldattr, sizeof(struct syscalls_file_s));
+
+  /* Save the new attributes in the new file structure */
+
+  newp->f_priv = (FAR void *)newattr;
+  return OK;
+}
+
+/****************************************************************************
+ * Name: syscalls_stat
+ *
+ * Description: Return information about a file or directory
+ *
+ ****************************************************************************/
+
+static int syscalls_stat(FAR const char *relpath, FAR struct stat *buf)
+{
+  /* "syscalls" is the name for a read/write file */
+
+  memset(buf, 0, sizeof(struct stat));
+  buf->st_mode = S_IFREG | S_IROTH | S_IRGRP | S_IRUSR | S_IWUSR;
+  return OK;
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+#endif /* !CONFIG_DISABLE_MOUNTPOINT && CONFIG_FS_PROCFS && CONFIG_SCHED_SYSCALLSTAT */
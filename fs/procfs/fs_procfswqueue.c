@@ -0,0 +1,362 @@
+/****************************************************************************
+ * fs/procfs/fs_procfswqueue.c
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <sys/param.h>
+#include <sys/types.h>
+#include <sys/stat.h>
+
+#include <stdint.h>
+#include <inttypes.h>
+#include <string.h>
+#include <fcntl.h>
+#include <assert.h>
+#include <errno.h>
+#include <debug.h>
+
+#include <nuttx/clock.h>
+#include <nuttx/kmalloc.h>
+#include <nuttx/wqueue.h>
+#include <nuttx/fs/fs.h>
+#include <nuttx/fs/procfs.h>
+
+#if !defined(CONFIG_DISABLE_MOUNTPOINT) && defined(CONFIG_FS_PROCFS) && \
+     defined(CONFIG_SCHED_WORKQUEUE_STATS)
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+/* Output format, one line per kernel work queue.  Times are in
+ * microseconds, WAIT and RUN are averages.
+ *
+ *   QUEUE       QUEUED        RUN PENDING MAXPEND    WAIT MAXWAIT ...
+ *   XXXXXXX DDDDDDDDDD DDDDDDDDDD DDDDDDD DDDDDDD DDDDDDD DDDDDDD ...
+ *
+ * followed by the RUN, MAXRUN and STOLEN columns.  STOLEN is the work
+ * that the per-CPU worker threads took from the queue of another CPU.
+ */
+
+#define WQUEUE_LINELEN  104
+#define WQUEUE_NQUEUES  nitems(g_wqueue_queues)
+
+/****************************************************************************
+ * Private Types
+ ****************************************************************************/
+
+/* This structure names one kernel work queue */
+
+struct wqueue_queue_s
+{
+  int qid;                        /* Work queue ID */
+  FAR const char *name;           /* Name of its worker threads */
+};
+
+/* This structure describes one open "file".  The statistics are copied
+ * when the file is opened so that all reads return consistent data.
+ */
+
+struct wqueue_file_s
+{
+  struct procfs_file_s base;      /* Base open file structure */
+  struct work_stat_s stat[3];     /* Statistics of each queue */
+  char line[WQUEUE_LINELEN];      /* Formatted line */
+};
+
+/****************************************************************************
+ * Private Function Prototypes
+ ****************************************************************************/
+
+static int     wqueue_open(FAR struct file *filep, FAR const char *relpath,
+                           int oflags, mode_t mode);
+static int     wqueue_close(FAR struct file *filep);
+static ssize_t wqueue_read(FAR struct file *filep, FAR char *buffer,
+                           size_t buflen);
+static ssize_t wqueue_write(FAR struct file *filep, FAR const char *buffer,
+                            size_t buflen);
+static int     wqueue_dup(FAR const struct file *oldp,
+                          FAR struct file *newp);
+static int     wqueue_stat(FAR const char *relpath, FAR struct stat *buf);
+
+/****************************************************************************
+ * Private Data
+ ****************************************************************************/
+
+/* The kernel work queues */
+
+static const struct wqueue_queue_s g_wqueue_queues[] =
+{
+#ifdef CONFIG_SCHED_HPWORK
+  { HPWORK, "hpwork" },
+#endif
+#ifdef CONFIG_SCHED_LPWORK
+  { LPWORK, "lpwork" },
+#endif
+#ifdef CONFIG_SCHED_CPUWORK
+  { CPUWORK, "cpuwork" },
+#endif
+};
+
+/****************************************************************************
+ * Public Data
+ ****************************************************************************/
+
+/* See fs_mount.c -- this structure is explicitly externed there.
+ * We use the old-fashioned kind of initializers so that this will compile
+ * with any compiler.
+ */
+
+const struct procfs_operations g_wqueue_operations =
+{
+  wqueue_open,        /* open */
+  wqueue_close,       /* close */
+  wqueue_read,        /* read */
+  wqueue_write,       /* write */
+
+  wqueue_dup,         /* dup */
+
+  NULL,               /* opendir */
+  NULL,               /* closedir */
+  NULL,               /* readdir */
+  NULL,               /* rewinddir */
+
+  wqueue_stat         /* stat */
+};
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: wqueue_usec
+ *
+ * Description:
+ *   Convert a perf_gettime() interval to microseconds.
+ *
+ ****************************************************************************/
+
+static uint64_t wqueue_usec(uint64_t elapsed)
+{
+  struct timespec ts;
+
+  perf_convert((clock_t)elapsed, &ts);
+  return (uint64_t)ts.tv_sec * USEC_PER_SEC + ts.tv_nsec / NSEC_PER_USEC;
+}
+
+/****************************************************************************
+ * Name: wqueue_open
+ ****************************************************************************/
+
+static int wqueue_open(FAR struct file *filep, FAR const char *relpath,
+                       int oflags, mode_t mode)
+{
+  FAR struct wqueue_file_s *attr;
+  int i;
+
+  finfo("Open '%s'\n", relpath);
+
+  /* Allocate a container to hold the file attributes */
+
+  attr = kmm_zalloc(sizeof(struct wqueue_file_s));
+  if (!attr)
+    {
+      ferr("ERROR: Failed to allocate file attributes\n");
+      return -ENOMEM;
+    }
+
+  /* Take a snapshot of the statistics */
+
+  for (i = 0; i < WQUEUE_NQUEUES; i++)
+    {
+      work_getstat(g_wqueue_queues[i].qid, &attr->stat[i]);
+    }
+
+  /* Save the attributes as the open-specific state in filep->f_priv */
+
+  filep->f_priv = (FAR void *)attr;
+  return OK;
+}
+
+/****************************************************************************
+ * Name: wqueue_close
+ ****************************************************************************/
+
+static int wqueue_close(FAR struct file *filep)
+{
+  FAR struct wqueue_file_s *attr;
+
+  /* Recover our private data from the struct file instance */
+
+  attr = (FAR struct wqueue_file_s *)filep->f_priv;
+  DEBUGASSERT(attr);
+
+  /* Release the file attributes structure */
+
+  kmm_free(attr);
+  filep->f_priv = NULL;
+  return OK;
+}
+
+/****************************************************************************
+ * Name: wqueue_read
+ ****************************************************************************/
+
+static ssize_t wqueue_read(FAR struct file *filep, FAR char *buffer,
+                           size_t buflen)
+{
+  FAR struct wqueue_file_s *attr;
+  FAR struct work_stat_s *stat;
+  size_t linesize;
+  size_t copysize;
+  size_t totalsize;
+  uint32_t nrun;
+  off_t offset;
+  int i;
+
+  finfo("buffer=%p buflen=%d\n", buffer, (int)buflen);
+
+  /* Recover our private data from the struct file instance */
+
+  attr = (FAR struct wqueue_file_s *)filep->f_priv;
+  DEBUGASSERT(attr);
+
+  offset    = filep->f_pos;
+  linesize  = procfs_snprintf(attr->line, WQUEUE_LINELEN,
+                              "%-7s %10s %10s %7s %7s %7s %7s %7s %7s"
+                              " %7s\n",
+                              "QUEUE", "QUEUED", "RUN", "PENDING",
+                              "MAXPEND", "WAIT", "MAXWAIT", "RUN",
+                              "MAXRUN", "STOLEN");
+  totalsize = procfs_memcpy(attr->line, linesize, buffer, buflen, &offset);
+
+  for (i = 0; i < WQUEUE_NQUEUES && totalsize < buflen; i++)
+    {
+      stat = &attr->stat[i];
+      nrun = stat->nrun > 0 ? stat->nrun : 1;
+
+      linesize   = procfs_snprintf(attr->line, WQUEUE_LINELEN,
+                                   "%-7s %10" PRIu32 " %10" PRIu32
+                                   " %7" PRIu32 " %7" PRIu32
+                                   " %7" PRIu64 " %7" PRIu64
+                                   " %7" PRIu64 " %7" PRIu64
+                                   " %7" PRIu32 "\n",
+                                   g_wqueue_queues[i].name, stat->nqueued,
+                                   stat->nrun, stat->npending,
+                                   stat->maxpending,
+                                   wqueue_usec(stat->wait_time / nrun),
+                                   wqueue_usec(stat->wait_max),
+                                   wqueue_usec(stat->run_time / nrun),
+                                   wqueue_usec(stat->run_max),
+                                   stat->nstolen);
+      copysize   = procfs_memcpy(attr->line, linesize, buffer + totalsize,
+                                 buflen - totalsize, &offset);
+      totalsize += copysize;
+    }
+
+  filep->f_pos += totalsize;
+  return totalsize;
+}
+
+/****************************************************************************
+ * Name: wqueue_write
+ *
+ * Description:
+ *   Writing anything to the file clears the statistics.
+ *
+ ****************************************************************************/
+
+static ssize_t wqueue_write(FAR struct file *filep, FAR const char *buffer,
+                            size_t buflen)
+{
+  int i;
+
+  for (i = 0; i < WQUEUE_NQUEUES; i++)
+    {
+      work_resetstat(g_wqueue_queues[i].qid);
+    }
+
+  return buflen;
+}
+
+/****************************************************************************
+ * Name: wqueue_dup
+ *
+ * Description:
+ *   Duplicate open file data in the new file structure.
+ *
+ ****************************************************************************/
+
+static int wqueue_dup(FAR const struct file *oldp, FAR struct file *newp)
+{
+  FAR struct wqueue_file_s *oldattr;
+  FAR struct wqueue_file_s *newattr;
+
+  finfo("Dup %p->%p\n", oldp, newp);
+
+  /* Recover our private data from the old struct file instance */
+
+  oldattr = (FAR struct wqueue_file_s *)oldp->f_priv;
+  DEBUGASSERT(oldattr);
+
+  /* Allocate a new container to hold the task and attribute selection */
+
+  newattr = kmm_malloc(sizeof(struct wqueue_file_s));
+  if (!newattr)
+    {
+      ferr("ERROR: Failed to allocate file attributes\n");
+      return -ENOMEM;
+    }
+
+  /* The copy the file attributes from the old attributes to the new */
+
+  memcpy(newattr, oldattr, sizeof(struct wqueue_file_s));
+
+  /* Save the new attributes in the new file structure */
+
+  newp->f_priv = (FAR void *)newattr;
+  return OK;
+}
+
+/****************************************************************************
+ * Name: wqueue_stat
+ *
+ * Description: Return information about a file or directory
+ *
+ ****************************************************************************/
+
+static int wqueue_stat(FAR const char *relpath, FAR struct stat *buf)
+{
+  /* "wqueue" is the name for a read/write file */
+
+  memset(buf, 0, sizeof(struct stat));
+  buf->st_mode = S_IFREG | S_IROTH | S_IRGRP | S_IRUSR | S_IWUSR;
+  return OK;
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+#endif /* CONFIG_FS_PROCFS && CONFIG_SCHED_WORKQUEUE_STATS */
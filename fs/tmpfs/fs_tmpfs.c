@@ -24,9 +24,11 @@
 
 #include <nuttx/config.h>
 
+#include <sys/param.h>
 #include <sys/stat.h>
 #include <sys/statfs.h>
 #include <stdint.h>
+#include <stdlib.h>
 #include <string.h>
 #include <fcntl.h>
 #include <errno.h>
@@ -36,6 +38,7 @@
 #include <nuttx/kmalloc.h>
 #include <nuttx/fs/fs.h>
 #include <nuttx/fs/ioctl.h>
+#include <nuttx/lib/lib.h>
 
 #include "fs_tmpfs.h"
 
@@ -49,9 +52,14 @@
 #  warning CONFIG_FS_TMPFS_DIRECTORY_FREEGUARD needs to be > ALLOCGUARD
 #endif
 
-#if CONFIG_FS_TMPFS_FILE_FREEGUARD <= CONFIG_FS_TMPFS_FILE_ALLOCGUARD
-#  warning CONFIG_FS_TMPFS_FILE_FREEGUARD needs to be > ALLOCGUARD
-#endif
+/* Minimum number of entries of a file page table */
+
+#define TMPFS_MINPAGES 4
+
+/* Return the page at the given index or NULL if it is a hole */
+
+#define tmpfs_get_page(tfo, i) \
+           ((i) < (tfo)->tfo_npages ? (tfo)->tfo_pages[i] : NULL)
 
 #define tmpfs_lock(fs) \
            nxrmutex_lock(&fs->tfs_lock)
@@ -89,7 +97,12 @@ struct tmpfs_dir_s
 
 static int  tmpfs_realloc_directory(FAR struct tmpfs_directory_s *tdo,
               unsigned int nentries);
-static int  tmpfs_realloc_file(FAR struct tmpfs_file_s *tfo,
+static int  tmpfs_reserve(FAR struct tmpfs_s *fs, ssize_t nbytes);
+static int  tmpfs_alloc_page(FAR struct tmpfs_file_s *tfo,
+              size_t index, FAR uint8_t **page);
+static void tmpfs_free_pages(FAR struct tmpfs_file_s *tfo, size_t first);
+static void tmpfs_free_filedata(FAR struct tmpfs_file_s *tfo);
+static int  tmpfs_resize_file(FAR struct tmpfs_file_s *tfo,
               size_t newsize);
 static void tmpfs_release_lockedobject(FAR struct tmpfs_object_s *to);
 static void tmpfs_release_lockedfile(FAR struct tmpfs_file_s *tfo);
@@ -100,7 +113,7 @@ static int  tmpfs_remove_dirent(FAR struct tmpfs_directory_s *tdo,
               FAR const char *name);
 static int  tmpfs_add_dirent(FAR struct tmpfs_directory_s *tdo,
               FAR struct tmpfs_object_s *to, FAR const char *name);
-static FAR struct tmpfs_file_s *tmpfs_alloc_file(void);
+static FAR struct tmpfs_file_s *tmpfs_alloc_file(FAR struct tmpfs_s *fs);
 static int  tmpfs_create_file(FAR struct tmpfs_s *fs,
               FAR const char *relpath, FAR struct tmpfs_file_s **tfo);
 static FAR struct tmpfs_directory_s *tmpfs_alloc_directory(void);
@@ -258,66 +271,335 @@ static int tmpfs_realloc_directory(FAR struct tmpfs_directory_s *tdo,
 }
 
 /****************************************************************************
- * Name: tmpfs_realloc_file
+ * Name: tmpfs_reserve
+ *
+ * Description:
+ *   Account for nbytes of file pages being allocated (nbytes > 0) or freed
+ *   (nbytes < 0), enforcing the size limit of the file system.
+ *
  ****************************************************************************/
 
-static int tmpfs_realloc_file(FAR struct tmpfs_file_s *tfo,
-                              size_t newsize)
+static int tmpfs_reserve(FAR struct tmpfs_s *fs, ssize_t nbytes)
 {
-  FAR uint8_t *newdata;
-  size_t allocsize;
-  size_t delta;
+  size_t used;
 
-  /* Are we growing or shrinking the object? */
+  if (nbytes <= 0)
+    {
+      atomic_fetch_sub(&fs->tfs_used, (size_t)-nbytes);
+      return OK;
+    }
 
-  if (newsize <= tfo->tfo_alloc)
+  used = atomic_load(&fs->tfs_used);
+  do
     {
-      /* Shrinking ... Shrink unconditionally if the size is shrinking to
-       * zero.
-       */
+      if (fs->tfs_maxsize > 0 && used + nbytes > fs->tfs_maxsize)
+        {
+          return -ENOSPC;
+        }
+    }
+  while (!atomic_compare_exchange_weak(&fs->tfs_used, &used,
+                                       used + nbytes));
+
+  return OK;
+}
+
+/****************************************************************************
+ * Name: tmpfs_grow_pages
+ *
+ * Description:
+ *   Make sure that the page table has an entry for page number 'index'.
+ *   The page table grows geometrically so that appending is amortized
+ *   O(1) and never copies the file data itself.
+ *
+ ****************************************************************************/
+
+static int tmpfs_grow_pages(FAR struct tmpfs_file_s *tfo, size_t index)
+{
+  FAR uint8_t **newpages;
+  size_t npages;
+
+  if (index < tfo->tfo_npages)
+    {
+      return OK;
+    }
+
+  npages = tfo->tfo_npages > 0 ? tfo->tfo_npages : TMPFS_MINPAGES;
+  while (npages <= index)
+    {
+      npages <<= 1;
+    }
+
+  newpages = kmm_realloc(tfo->tfo_pages, npages * sizeof(FAR uint8_t *));
+  if (newpages == NULL)
+    {
+      return -ENOMEM;
+    }
+
+  memset(&newpages[tfo->tfo_npages], 0,
+         (npages - tfo->tfo_npages) * sizeof(FAR uint8_t *));
+
+  tfo->tfo_alloc += (npages - tfo->tfo_npages) * sizeof(FAR uint8_t *);
+  tfo->tfo_pages  = newpages;
+  tfo->tfo_npages = npages;
+  return OK;
+}
+
+/****************************************************************************
+ * Name: tmpfs_alloc_page
+ *
+ * Description:
+ *   Return the page holding the file data at offset
+ *   index * TMPFS_PAGESIZE.  If the page is a hole, a zeroed page is
+ *   allocated, growing the page table as needed.
+ *
+ ****************************************************************************/
+
+static int tmpfs_alloc_page(FAR struct tmpfs_file_s *tfo,
+                            size_t index, FAR uint8_t **page)
+{
+  int ret;
+
+  *page = tmpfs_get_page(tfo, index);
+  if (*page != NULL)
+    {
+      return OK;
+    }
+
+  ret = tmpfs_grow_pages(tfo, index);
+  if (ret < 0)
+    {
+      return ret;
+    }
+
+  ret = tmpfs_reserve(tfo->tfo_fs, TMPFS_PAGESIZE);
+  if (ret < 0)
+    {
+      return ret;
+    }
+
+  *page = kmm_zalloc(TMPFS_PAGESIZE);
+  if (*page == NULL)
+    {
+      tmpfs_reserve(tfo->tfo_fs, -TMPFS_PAGESIZE);
+      return -ENOMEM;
+    }
 
-      if (newsize > 0)
+  tfo->tfo_alloc       += TMPFS_PAGESIZE;
+  tfo->tfo_pages[index] = *page;
+  return OK;
+}
+
+/****************************************************************************
+ * Name: tmpfs_contig_pages
+ *
+ * Description:
+ *   Make the pages [first, first + npages) of the file contiguous in
+ *   memory so that they can be mapped, allocating the holes.  The pages
+ *   already in tfo_contig are kept there; otherwise, if the file is not
+ *   mapped, all of them are moved into one new block.  A file that is
+ *   mapped cannot move its pages, so a range which is not already
+ *   contiguous fails with -ENOMEM.
+ *
+ ****************************************************************************/
+
+static int tmpfs_contig_pages(FAR struct tmpfs_file_s *tfo,
+                              size_t first, size_t npages)
+{
+  FAR uint8_t *block;
+  size_t cend = tfo->tfo_cfirst + tfo->tfo_ncontig;
+  size_t last = first + npages;
+  size_t nheld = 0;
+  size_t i;
+  int ret;
+
+  if (tfo->tfo_ncontig > 0 && first >= tfo->tfo_cfirst && last <= cend)
+    {
+      return OK;
+    }
+
+  if (tfo->tfo_nmaps > 0)
+    {
+      ferr("ERROR: Pages of a mapped file cannot be moved\n");
+      return -ENOMEM;
+    }
+
+  /* The new block also covers the old one, if any */
+
+  if (tfo->tfo_ncontig > 0)
+    {
+      first = MIN(first, tfo->tfo_cfirst);
+      last  = MAX(last, cend);
+    }
+
+  npages = last - first;
+  ret = tmpfs_grow_pages(tfo, last - 1);
+  if (ret < 0)
+    {
+      return ret;
+    }
+
+  /* A single page needs no copy, it becomes the block itself */
+
+  if (npages == 1 && tfo->tfo_ncontig == 0)
+    {
+      ret = tmpfs_alloc_page(tfo, first, &block);
+      if (ret >= 0)
         {
-          /* Otherwise, don't realloc unless the object has shrunk by a
-           * lot.
-           */
+          tfo->tfo_contig  = block;
+          tfo->tfo_cfirst  = first;
+          tfo->tfo_ncontig = 1;
+        }
 
-          delta = tfo->tfo_alloc - newsize;
-          if (delta <= CONFIG_FS_TMPFS_FILE_FREEGUARD)
-            {
-              /* Hasn't shrunk enough.. Return doing nothing for now */
+      return ret;
+    }
 
-              tfo->tfo_size = newsize;
-              return OK;
+  for (i = first; i < last; i++)
+    {
+      if (tfo->tfo_pages[i] != NULL)
+        {
+          nheld++;
+        }
+    }
+
+  ret = tmpfs_reserve(tfo->tfo_fs, (npages - nheld) * TMPFS_PAGESIZE);
+  if (ret < 0)
+    {
+      return ret;
+    }
+
+  block = kmm_zalloc(npages * TMPFS_PAGESIZE);
+  if (block == NULL)
+    {
+      tmpfs_reserve(tfo->tfo_fs, -(ssize_t)((npages - nheld) *
+                                            TMPFS_PAGESIZE));
+      return -ENOMEM;
+    }
+
+  /* Move the data into the block and free the single pages */
+
+  for (i = first; i < last; i++)
+    {
+      FAR uint8_t *page = tfo->tfo_pages[i];
+
+      if (page != NULL)
+        {
+          memcpy(block + (i - first) * TMPFS_PAGESIZE, page,
+                 TMPFS_PAGESIZE);
+          if (i < tfo->tfo_cfirst || i >= cend)
+            {
+              kmm_free(page);
             }
         }
+
+      tfo->tfo_pages[i] = block + (i - first) * TMPFS_PAGESIZE;
     }
 
-  /* Added some additional amount to the new size to account frequent
-   * reallocations.
-   */
+  kmm_free(tfo->tfo_contig);
+
+  tfo->tfo_alloc  += (npages - nheld) * TMPFS_PAGESIZE;
+  tfo->tfo_contig  = block;
+  tfo->tfo_cfirst  = first;
+  tfo->tfo_ncontig = npages;
+  return OK;
+}
 
-  allocsize = newsize + CONFIG_FS_TMPFS_FILE_ALLOCGUARD;
-  if (allocsize < newsize)
+/****************************************************************************
+ * Name: tmpfs_free_pages
+ *
+ * Description:
+ *   Free all of the pages of the file starting with page number 'first'.
+ *   The pages of the contiguous block may be mapped, they are only
+ *   cleared.
+ *
+ ****************************************************************************/
+
+static void tmpfs_free_pages(FAR struct tmpfs_file_s *tfo, size_t first)
+{
+  size_t nfreed = 0;
+  size_t i;
+
+  for (i = first; i < tfo->tfo_npages; i++)
     {
-      /* There must have been an integer overflow */
+      if (i >= tfo->tfo_cfirst &&
+          i < tfo->tfo_cfirst + tfo->tfo_ncontig)
+        {
+          memset(tfo->tfo_pages[i], 0, TMPFS_PAGESIZE);
+        }
+      else if (tfo->tfo_pages[i] != NULL)
+        {
+          kmm_free(tfo->tfo_pages[i]);
+          tfo->tfo_pages[i] = NULL;
+          nfreed++;
+        }
+    }
 
-      return -ENOMEM;
+  if (nfreed > 0)
+    {
+      tfo->tfo_alloc -= nfreed * TMPFS_PAGESIZE;
+      tmpfs_reserve(tfo->tfo_fs, -(ssize_t)(nfreed * TMPFS_PAGESIZE));
     }
+}
 
-  /* Realloc the file object */
+/****************************************************************************
+ * Name: tmpfs_free_filedata
+ ****************************************************************************/
+
+static void tmpfs_free_filedata(FAR struct tmpfs_file_s *tfo)
+{
+  DEBUGASSERT(tfo->tfo_nmaps == 0);
 
-  newdata = kmm_realloc(tfo->tfo_data, allocsize);
-  if (newdata == NULL)
+  tmpfs_free_pages(tfo, 0);
+  if (tfo->tfo_ncontig > 0)
     {
-      return -ENOMEM;
+      kmm_free(tfo->tfo_contig);
+      tmpfs_reserve(tfo->tfo_fs,
+                    -(ssize_t)(tfo->tfo_ncontig * TMPFS_PAGESIZE));
+    }
+
+  kmm_free(tfo->tfo_pages);
+
+  tfo->tfo_pages   = NULL;
+  tfo->tfo_npages  = 0;
+  tfo->tfo_contig  = NULL;
+  tfo->tfo_cfirst  = 0;
+  tfo->tfo_ncontig = 0;
+  tfo->tfo_alloc   = 0;
+}
+
+/****************************************************************************
+ * Name: tmpfs_resize_file
+ *
+ * Description:
+ *   Change the size of the file.  Growing the file only creates a hole;
+ *   shrinking it frees the pages past the new end of file and clears the
+ *   tail of the last page so that stale data does not reappear if the
+ *   file grows again.
+ *
+ ****************************************************************************/
+
+static int tmpfs_resize_file(FAR struct tmpfs_file_s *tfo,
+                             size_t newsize)
+{
+  FAR uint8_t *page;
+  size_t offset;
+
+  if (newsize == 0 && tfo->tfo_nmaps == 0)
+    {
+      tmpfs_free_filedata(tfo);
     }
+  else if (newsize < tfo->tfo_size)
+    {
+      tmpfs_free_pages(tfo, TMPFS_NPAGES(newsize));
 
-  /* Return the new address of the reallocated file object */
+      offset = newsize % TMPFS_PAGESIZE;
+      page   = tmpfs_get_page(tfo, newsize / TMPFS_PAGESIZE);
+      if (offset > 0 && page != NULL)
+        {
+          memset(page + offset, 0, TMPFS_PAGESIZE - offset);
+        }
+    }
 
-  tfo->tfo_alloc = allocsize;
-  tfo->tfo_size  = newsize;
-  tfo->tfo_data  = newdata;
+  tfo->tfo_size = newsize;
   return OK;
 }
 
@@ -358,7 +640,7 @@ static void tmpfs_release_lockedfile(FAR struct tmpfs_file_s *tfo)
     {
       tmpfs_unlock_file(tfo);
       nxrmutex_destroy(&tfo->tfo_lock);
-      kmm_free(tfo->tfo_data);
+      tmpfs_free_filedata(tfo);
       kmm_free(tfo);
     }
 
@@ -533,7 +815,7 @@ static int tmpfs_add_dirent(FAR struct tmpfs_directory_s *tdo,
  * Name: tmpfs_alloc_file
  ****************************************************************************/
 
-static FAR struct tmpfs_file_s *tmpfs_alloc_file(void)
+static FAR struct tmpfs_file_s *tmpfs_alloc_file(FAR struct tmpfs_s *fs)
 {
   FAR struct tmpfs_file_s *tfo;
 
@@ -549,12 +831,18 @@ static FAR struct tmpfs_file_s *tmpfs_alloc_file(void)
    * locked with one reference count.
    */
 
-  tfo->tfo_alloc = 0;
-  tfo->tfo_type  = TMPFS_REGULAR;
-  tfo->tfo_refs  = 1;
-  tfo->tfo_flags = 0;
-  tfo->tfo_size  = 0;
-  tfo->tfo_data  = NULL;
+  tfo->tfo_alloc   = 0;
+  tfo->tfo_type    = TMPFS_REGULAR;
+  tfo->tfo_refs    = 1;
+  tfo->tfo_flags   = 0;
+  tfo->tfo_size    = 0;
+  tfo->tfo_npages  = 0;
+  tfo->tfo_pages   = NULL;
+  tfo->tfo_contig  = NULL;
+  tfo->tfo_cfirst  = 0;
+  tfo->tfo_ncontig = 0;
+  tfo->tfo_nmaps   = 0;
+  tfo->tfo_fs      = fs;
 
   nxrmutex_init(&tfo->tfo_lock);
   tmpfs_lock_file(tfo);
@@ -642,7 +930,7 @@ static int tmpfs_create_file(FAR struct tmpfs_s *fs,
    * one reference count.
    */
 
-  newtfo = tmpfs_alloc_file();
+  newtfo = tmpfs_alloc_file(fs);
   if (newtfo == NULL)
     {
       ret = -ENOMEM;
@@ -1105,7 +1393,11 @@ static int tmpfs_statfs_callout(FAR struct tmpfs_directory_s *tdo,
 
       tmptfo             = (FAR struct tmpfs_file_s *)to;
       tmpbuf->tsf_alloc += sizeof(struct tmpfs_file_s);
-      tmpbuf->tsf_avail += to->to_alloc - tmptfo->tfo_size;
+      if (to->to_alloc > tmptfo->tfo_size)
+        {
+          tmpbuf->tsf_avail += to->to_alloc - tmptfo->tfo_size;
+        }
+
       tmpbuf->tsf_files++;
     }
   else /* if (to->to_type == TMPFS_DIRECTORY) */
@@ -1181,7 +1473,7 @@ static int tmpfs_free_callout(FAR struct tmpfs_directory_s *tdo,
           return TMPFS_UNLINKED;
         }
 
-      kmm_free(tfo->tfo_data);
+      tmpfs_free_filedata(tfo);
     }
   else /* if (to->to_type == TMPFS_DIRECTORY) */
     {
@@ -1354,7 +1646,7 @@ static int tmpfs_open(FAR struct file *filep, FAR const char *relpath,
 
           if (tfo->tfo_size > 0)
             {
-              ret = tmpfs_realloc_file(tfo, 0);
+              ret = tmpfs_resize_file(tfo, 0);
               if (ret < 0)
                 {
                   goto errout_with_filelock;
@@ -1500,18 +1792,36 @@ static ssize_t tmpfs_read(FAR struct file *filep, FAR char *buffer,
       nread  = endpos - startpos;
     }
 
-  /* Copy data from the memory object to the user buffer */
+  /* Copy data from the file pages to the user buffer.  Holes read back
+   * as zeroes.
+   */
 
-  if (tfo->tfo_data != NULL)
-    {
-      memcpy(buffer, &tfo->tfo_data[startpos], nread);
-      filep->f_pos += nread;
-    }
-  else
+  while (startpos < endpos)
     {
-      DEBUGASSERT(tfo->tfo_size == 0 && nread == 0);
+      FAR uint8_t *page = tmpfs_get_page(tfo, startpos / TMPFS_PAGESIZE);
+      size_t offset = startpos % TMPFS_PAGESIZE;
+      size_t ncopy = TMPFS_PAGESIZE - offset;
+
+      if (ncopy > (size_t)(endpos - startpos))
+        {
+          ncopy = endpos - startpos;
+        }
+
+      if (page != NULL)
+        {
+          memcpy(buffer, page + offset, ncopy);
+        }
+      else
+        {
+          memset(buffer, 0, ncopy);
+        }
+
+      buffer   += ncopy;
+      startpos += ncopy;
     }
 
+  filep->f_pos += nread;
+
   /* Release the lock on the file */
 
   tmpfs_unlock_file(tfo);
@@ -1526,7 +1836,7 @@ static ssize_t tmpfs_write(FAR struct file *filep, FAR const char *buffer,
                            size_t buflen)
 {
   FAR struct tmpfs_file_s *tfo;
-  ssize_t nwritten;
+  size_t nwritten;
   off_t startpos;
   off_t endpos;
   int ret;
@@ -1547,41 +1857,56 @@ static ssize_t tmpfs_write(FAR struct file *filep, FAR const char *buffer,
       return ret;
     }
 
-  /* Handle attempts to write beyond the end of the file */
+  /* Copy data from the user buffer to the file pages, allocating the
+   * pages as needed.  Writing past the end of the file leaves a hole
+   * between the old end of file and the start of the write.
+   */
 
   startpos = filep->f_pos;
-  nwritten = buflen;
   endpos   = startpos + buflen;
+  nwritten = 0;
 
-  if (endpos > tfo->tfo_size)
+  while (startpos < endpos)
     {
-      /* Reallocate the file to handle the write past the end of the file. */
+      FAR uint8_t *page;
+      size_t offset = startpos % TMPFS_PAGESIZE;
+      size_t ncopy = TMPFS_PAGESIZE - offset;
+
+      if (ncopy > (size_t)(endpos - startpos))
+        {
+          ncopy = endpos - startpos;
+        }
 
-      ret = tmpfs_realloc_file(tfo, (size_t)endpos);
+      ret = tmpfs_alloc_page(tfo, startpos / TMPFS_PAGESIZE, &page);
       if (ret < 0)
         {
-          goto errout_with_lock;
+          break;
         }
+
+      memcpy(page + offset, buffer + nwritten, ncopy);
+      nwritten += ncopy;
+      startpos += ncopy;
     }
 
-  /* Copy data from the memory object to the user buffer */
+  /* Return a partial write if the file system ran out of space */
 
-  if (tfo->tfo_data != NULL)
+  if (nwritten > 0)
     {
-      memcpy(&tfo->tfo_data[startpos], buffer, nwritten);
-      filep->f_pos += nwritten;
+      if (startpos > tfo->tfo_size)
+        {
+          tfo->tfo_size = startpos;
+        }
+
+      filep->f_pos = startpos;
+      ret = nwritten;
     }
-  else
+  else if (buflen == 0)
     {
-      DEBUGASSERT(tfo->tfo_size == 0 && nwritten == 0);
+      ret = 0;
     }
 
   /* Release the lock on the file */
 
-  tmpfs_unlock_file(tfo);
-  return nwritten;
-
-errout_with_lock:
   tmpfs_unlock_file(tfo);
   return (ssize_t)ret;
 }
@@ -1660,7 +1985,9 @@ static int tmpfs_unmap(FAR struct task_group_s *group,
       ret = mm_map_remove(get_group_mm(group), entry);
       if (ret >= 0)
         {
-          ret = tmpfs_release_file(tfo);
+          tmpfs_lock_file(tfo);
+          tfo->tfo_nmaps--;
+          tmpfs_release_lockedfile(tfo);
         }
     }
 
@@ -1672,7 +1999,7 @@ static int tmpfs_unmap(FAR struct task_group_s *group,
     {
       entry->length = offset;
       tmpfs_lock_file(tfo);
-      ret = tmpfs_realloc_file(tfo, offset);
+      ret = tmpfs_resize_file(tfo, entry->offset + offset);
       tmpfs_unlock_file(tfo);
     }
 
@@ -1695,17 +2022,38 @@ static int tmpfs_mmap(FAR struct file *filep, FAR struct mm_map_entry_s *map)
   if (map->offset >= 0 && map->offset < tfo->tfo_size &&
       map->length && map->offset + map->length <= tfo->tfo_size)
     {
-      map->vaddr = tfo->tfo_data + map->offset;
+      size_t first = map->offset / TMPFS_PAGESIZE;
+      size_t last = (map->offset + map->length - 1) / TMPFS_PAGESIZE;
+
+      /* Map the file pages themselves so that the mapping is shared with
+       * read(), write() and other mappings of the file.  That needs the
+       * mapped pages to be contiguous.
+       */
+
+      ret = tmpfs_lock_file(tfo);
+      if (ret < 0)
+        {
+          return ret;
+        }
+
+      ret = tmpfs_contig_pages(tfo, first, last - first + 1);
+      if (ret < 0)
+        {
+          tmpfs_unlock_file(tfo);
+          return ret;
+        }
+
+      map->vaddr  = tfo->tfo_pages[first] + map->offset % TMPFS_PAGESIZE;
       map->priv.p = tfo;
       map->munmap = tmpfs_unmap;
       ret = mm_map_add(get_current_mm(), map);
-
       if (ret >= 0)
         {
-          tmpfs_lock_file(tfo);
           tfo->tfo_refs++;
-          tmpfs_unlock_file(tfo);
+          tfo->tfo_nmaps++;
         }
+
+      tmpfs_unlock_file(tfo);
     }
 
   return ret;
@@ -1805,7 +2153,6 @@ static int tmpfs_fstat(FAR const struct file *filep, FAR struct stat *buf)
 static int tmpfs_truncate(FAR struct file *filep, off_t length)
 {
   FAR struct tmpfs_file_s *tfo;
-  size_t oldsize;
   int ret;
 
   finfo("filep: %p length: %ld\n", filep, (long)length);
@@ -1823,36 +2170,14 @@ static int tmpfs_truncate(FAR struct file *filep, off_t length)
       return ret;
     }
 
-  /* Get the old size of the file.  Do nothing if the file size is not
-   * changing.
+  /* Resize the file.  Extending the file only creates a hole, no memory
+   * is allocated until the new range is written.
    */
 
-  oldsize = tfo->tfo_size;
-  if (oldsize != length)
-    {
-      /* The size is changing.. up or down.  Reallocate the file memory. */
-
-      ret = tmpfs_realloc_file(tfo, (size_t)length);
-      if (ret < 0)
-        {
-          goto errout_with_lock;
-        }
-
-      /* If the size has increased, then we need to zero the newly added
-       * memory.
-       */
-
-      if (length > oldsize)
-        {
-          memset(&tfo->tfo_data[oldsize], 0, length - oldsize);
-        }
-
-      ret = OK;
-    }
+  ret = tmpfs_resize_file(tfo, (size_t)length);
 
   /* Release the lock on the file */
 
-errout_with_lock:
   tmpfs_unlock_file(tfo);
   return ret;
 }
@@ -2045,6 +2370,82 @@ static int tmpfs_rewinddir(FAR struct inode *mountpt,
   return OK;
 }
 
+/****************************************************************************
+ * Name: tmpfs_parse_options
+ *
+ * Description:
+ *   Parse the comma separated mount options.  The only option supported
+ *   is size=N[k|m], the maximum number of bytes of file data the file
+ *   system may hold.  Without it the file system is only limited by the
+ *   available heap.
+ *
+ ****************************************************************************/
+
+static int tmpfs_parse_options(FAR struct tmpfs_s *fs, FAR const char *data)
+{
+  FAR char *options;
+  FAR char *saveptr;
+  FAR char *ptr;
+  FAR char *end;
+  unsigned long size;
+  int shift;
+  int ret = OK;
+
+  if (data == NULL)
+    {
+      return OK;
+    }
+
+  options = strdup(data);
+  if (options == NULL)
+    {
+      return -ENOMEM;
+    }
+
+  ptr = strtok_r(options, ",", &saveptr);
+  while (ptr != NULL && ret == OK)
+    {
+      if (strncmp(ptr, "size=", 5) == 0)
+        {
+          size = strtoul(ptr + 5, &end, 0);
+          if (*end == 'k' || *end == 'K')
+            {
+              shift = 10;
+              end++;
+            }
+          else if (*end == 'm' || *end == 'M')
+            {
+              shift = 20;
+              end++;
+            }
+          else
+            {
+              shift = 0;
+            }
+
+          /* Reject garbage and sizes that do not fit in size_t */
+
+          if (*end != '\0' || size > (SIZE_MAX >> shift))
+            {
+              ret = -EINVAL;
+            }
+
+          size <<= shift;
+
+          fs->tfs_maxsize = size;
+        }
+      else
+        {
+          fwarn("WARNING: Ignoring mount option: %s\n", ptr);
+        }
+
+      ptr = strtok_r(NULL, ",", &saveptr);
+    }
+
+  lib_free(options);
+  return ret;
+}
+
 /****************************************************************************
  * Name: tmpfs_bind
  ****************************************************************************/
@@ -2054,6 +2455,7 @@ static int tmpfs_bind(FAR struct inode *blkdriver, FAR const void *data,
 {
   FAR struct tmpfs_directory_s *tdo;
   FAR struct tmpfs_s *fs;
+  int ret;
 
   finfo("blkdriver: %p data: %p handle: %p\n", blkdriver, data, handle);
   DEBUGASSERT(blkdriver == NULL && handle != NULL);
@@ -2066,6 +2468,13 @@ static int tmpfs_bind(FAR struct inode *blkdriver, FAR const void *data,
       return -ENOMEM;
     }
 
+  ret = tmpfs_parse_options(fs, data);
+  if (ret < 0)
+    {
+      kmm_free(fs);
+      return ret;
+    }
+
   /* Create a root file system.  This is like a single directory entry in
    * the file system structure.
    */
@@ -2196,6 +2605,21 @@ static int tmpfs_statfs(FAR struct inode *mountpt, FAR struct statfs *buf)
   buf->f_files    = tmpbuf.tsf_files;
   buf->f_ffree    = tmpbuf.tsf_ffree;
 
+  /* A size limited file system reports the limit and the file data space
+   * left below it.
+   */
+
+  if (fs->tfs_maxsize > 0)
+    {
+      size_t used = atomic_load(&fs->tfs_used);
+
+      buf->f_blocks = fs->tfs_maxsize / CONFIG_FS_TMPFS_BLOCKSIZE;
+      buf->f_bfree  = used < fs->tfs_maxsize ?
+                      (fs->tfs_maxsize - used) /
+                      CONFIG_FS_TMPFS_BLOCKSIZE : 0;
+      buf->f_bavail = buf->f_bfree;
+    }
+
   /* Release the lock on the file system */
 
   tmpfs_unlock(fs);
@@ -2288,7 +2712,7 @@ static int tmpfs_unlink(FAR struct inode *mountpt, FAR const char *relpath)
   else
     {
       nxrmutex_destroy(&tfo->tfo_lock);
-      kmm_free(tfo->tfo_data);
+      tmpfs_free_filedata(tfo);
       kmm_free(tfo);
     }
 
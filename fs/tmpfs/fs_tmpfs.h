@@ -27,6 +27,7 @@
 
 #include <nuttx/config.h>
 
+#include <stdatomic.h>
 #include <stdint.h>
 
 #include <nuttx/fs/fs.h>
@@ -40,6 +41,11 @@
 
 #define TFO_FLAG_UNLINKED (1 << 0)  /* Bit 0: File is unlinked */
 
+/* File data is stored in pages of this size */
+
+#define TMPFS_PAGESIZE    CONFIG_FS_TMPFS_PAGESIZE
+#define TMPFS_NPAGES(s)   (((s) + TMPFS_PAGESIZE - 1) / TMPFS_PAGESIZE)
+
 /****************************************************************************
  * Public Types
  ****************************************************************************/
@@ -107,8 +113,21 @@ struct tmpfs_directory_s
  * state.  The file memory object also serves as the open file object,
  * saving an allocation.  This has the negative side effect that no per-
  * open state can be retained (such as open flags).
+ *
+ * The file data is held in TMPFS_PAGESIZE pages referenced by a page table
+ * which grows geometrically, so appending to a file never copies the data
+ * already written.  A NULL page table entry is a hole that reads as zeros.
+ *
+ * mmap() needs the mapped range to be contiguous in memory.  The pages
+ * [tfo_cfirst, tfo_cfirst + tfo_ncontig) are therefore moved into the one
+ * allocation tfo_contig when they are first mapped, and the page table
+ * entries point into it.  These pages are never freed or moved while the
+ * file is mapped (tfo_nmaps > 0), so that all mappings and read()/write()
+ * share the same data.
  */
 
+struct tmpfs_s;
+
 struct tmpfs_file_s
 {
   /* First fields must match common TMPFS object layout */
@@ -121,9 +140,15 @@ struct tmpfs_file_s
 
   /* Remaining fields are unique to a directory object */
 
-  uint8_t       tfo_flags; /* See TFO_FLAG_* definitions */
-  size_t        tfo_size;  /* Valid file size */
-  FAR uint8_t  *tfo_data;  /* File data starts here */
+  uint8_t              tfo_flags;   /* See TFO_FLAG_* definitions */
+  size_t               tfo_size;    /* Valid file size */
+  size_t               tfo_npages;  /* Number of entries in the page table */
+  FAR uint8_t        **tfo_pages;   /* Page table, NULL entries are holes */
+  FAR uint8_t         *tfo_contig;  /* Contiguous block of mapped pages */
+  size_t               tfo_cfirst;  /* Index of the first page in tfo_contig */
+  size_t               tfo_ncontig; /* Number of pages in tfo_contig */
+  size_t               tfo_nmaps;   /* Number of live mappings of tfo_contig */
+  FAR struct tmpfs_s  *tfo_fs;      /* File system that owns the pages */
 };
 
 /* This structure represents one instance of a TMPFS file system */
@@ -134,6 +159,13 @@ struct tmpfs_s
 
   FAR struct tmpfs_dirent_s tfs_root;
   rmutex_t tfs_lock;
+
+  /* Memory used by file pages and the limit set by the "size=" mount
+   * option (zero if unlimited).
+   */
+
+  atomic_size_t tfs_used;
+  size_t   tfs_maxsize;
 };
 
 /* This is the type used the tmpfs_statfs_callout to accumulate memory
@@ -78,6 +78,12 @@ int file_close(FAR struct file *filep)
 
       inode_release(inode);
 
+#ifdef CONFIG_FS_READAHEAD
+      /* Free the readahead buffer */
+
+      file_readahead_release(filep);
+#endif
+
       /* Reset the user file struct instance so that it cannot be reused. */
 
       memset(filep, 0, sizeof(*filep));
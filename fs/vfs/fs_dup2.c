@@ -76,6 +76,18 @@ int file_dup3(FAR struct file *filep1, FAR struct file *filep2, int flags)
       return OK;
     }
 
+#ifdef CONFIG_FS_READAHEAD
+  /* The file system dup() copies its own position, which readahead may
+   * have left ahead of f_pos.
+   */
+
+  ret = file_readahead_sync(filep1);
+  if (ret < 0)
+    {
+      return ret;
+    }
+
+#endif
   /* Increment the reference count on the contained inode */
 
   inode = filep1->f_inode;
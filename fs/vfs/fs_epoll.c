@@ -39,6 +39,7 @@
 #include <nuttx/list.h>
 #include <nuttx/mutex.h>
 #include <nuttx/signal.h>
+#include <nuttx/spinlock.h>
 
 #include "inode/inode.h"
 
@@ -49,8 +50,12 @@
 struct epoll_node_s
 {
   struct list_node         node;
+  struct list_node         rnode;    /* Link in the ready list */
   epoll_data_t             data;
-  bool                     notified;
+  bool                     notified; /* The node is in the ready list */
+  pollevent_t              revents;  /* Events notified since the node was
+                                      * last reported, under rlock.
+                                      */
   struct pollfd            pfd;
   FAR struct epoll_head_s *eph;
 };
@@ -84,6 +89,14 @@ struct epoll_head_s
                                    * first node, used to free the malloced
                                    * memory in epoll_do_close().
                                    */
+  struct list_node      ready;    /* The ready list, store all the epoll
+                                   * node notified since they were last
+                                   * reported, linked by rnode.  It is filled
+                                   * from the poll callback, possibly in an
+                                   * interrupt handler, so it is protected by
+                                   * rlock instead of the mutex.
+                                   */
+  spinlock_t            rlock;
 };
 
 typedef struct epoll_head_s epoll_head_t;
@@ -243,6 +256,8 @@ static int epoll_do_create(int size, int flags)
   list_initialize(&eph->oneshot);
   list_initialize(&eph->extend);
   list_initialize(&eph->free);
+  list_initialize(&eph->ready);
+  spin_initialize(&eph->rlock, SP_UNLOCKED);
   for (i = 0; i < size; i++)
     {
       list_add_tail(&eph->free, &epn[i].node);
@@ -264,6 +279,39 @@ static int epoll_do_create(int size, int flags)
   return fd;
 }
 
+/****************************************************************************
+ * Name: epoll_unready
+ *
+ * Description:
+ *   Remove an epoll node from the ready list if it is there and forget its
+ *   pending events.  The pollfd must be torn down or about to be set up
+ *   again, otherwise it could be queued again at any time.
+ *
+ * Input Parameters:
+ *   eph       - The epoll head pointer
+ *   epn       - The epoll node pointer
+ *
+ * Returned Value:
+ *   None
+ *
+ ****************************************************************************/
+
+static void epoll_unready(FAR epoll_head_t *eph, FAR epoll_node_t *epn)
+{
+  irqstate_t flags;
+
+  flags = spin_lock_irqsave(&eph->rlock);
+  if (epn->notified)
+    {
+      list_delete(&epn->rnode);
+      epn->notified = false;
+    }
+
+  epn->revents     = 0;
+  epn->pfd.revents = 0;
+  spin_unlock_irqrestore(&eph->rlock, flags);
+}
+
 /****************************************************************************
  * Name: epoll_setup
  *
@@ -296,8 +344,7 @@ static int epoll_setup(FAR epoll_head_t *eph)
        * cover the situation several poll event pending on one fd.
        */
 
-      epn->notified    = false;
-      epn->pfd.revents = 0;
+      epoll_unready(eph, epn);
       ret = poll_fdsetup(epn->pfd.fd, &epn->pfd, true);
       if (ret < 0)
         {
@@ -318,8 +365,13 @@ static int epoll_setup(FAR epoll_head_t *eph)
  * Name: epoll_teardown
  *
  * Description:
- *   Teardown all the notifed fd and check the notified fd's event with user
- *   expected event.
+ *   Report the fds of the ready list.  Only the notified fds are visited,
+ *   so the cost does not depend on the number of fds registered.  Level
+ *   triggered fds are torn down, to be set up again by the next
+ *   epoll_wait() which checks whether they are still ready.  Edge
+ *   triggered fds stay set up and are reported again only when notified
+ *   again.  EPOLLONESHOT fds are torn down until re-armed by epoll_ctl().
+ *   The fds that do not fit in the events array stay in the ready list.
  *
  * Input Parameters:
  *   eph       - The epoll head pointer
@@ -335,38 +387,51 @@ static int epoll_setup(FAR epoll_head_t *eph)
 static int epoll_teardown(FAR epoll_head_t *eph, FAR struct epoll_event *evs,
                           int maxevents)
 {
-  FAR epoll_node_t *tepn;
   FAR epoll_node_t *epn;
+  pollevent_t revents;
+  irqstate_t flags;
   int i = 0;
 
   nxmutex_lock(&eph->lock);
 
-  list_for_every_entry_safe(&eph->setup, epn, tepn, epoll_node_t, node)
+  while (i < maxevents)
     {
-      /* Only check the notifed fd */
+      /* Take the oldest notified fd and its pending events */
+
+      flags = spin_lock_irqsave(&eph->rlock);
+      if (list_is_empty(&eph->ready))
+        {
+          spin_unlock_irqrestore(&eph->rlock, flags);
+          break;
+        }
+
+      epn = container_of(list_remove_head(&eph->ready),
+                         epoll_node_t, rnode);
+      epn->notified = false;
+      revents       = epn->revents;
+      epn->revents  = 0;
+      spin_unlock_irqrestore(&eph->rlock, flags);
+
+      if (revents != 0)
+        {
+          evs[i].data     = epn->data;
+          evs[i++].events = revents;
+        }
 
-      if (!epn->notified)
+      if ((epn->pfd.events & (EPOLLET | EPOLLONESHOT)) == EPOLLET)
         {
           continue;
         }
 
-      /* Teradown all the notified fd */
+      /* Teardown the level triggered and oneshot fd */
 
       poll_fdsetup(epn->pfd.fd, &epn->pfd, false);
+      epoll_unready(eph, epn);
       list_delete(&epn->node);
 
-      if (epn->pfd.revents != 0 && i < maxevents)
+      if (revents != 0 && (epn->pfd.events & EPOLLONESHOT) != 0)
         {
-          evs[i].data     = epn->data;
-          evs[i++].events = epn->pfd.revents;
-          if ((epn->pfd.events & EPOLLONESHOT) != 0)
-            {
-              list_add_tail(&eph->oneshot, &epn->node);
-            }
-          else
-            {
-              list_add_tail(&eph->teardown, &epn->node);
-            }
+          list_add_tail(&eph->oneshot, &epn->node);
         }
       else
         {
@@ -396,15 +461,34 @@ static int epoll_teardown(FAR epoll_head_t *eph, FAR struct epoll_event *evs,
 static void epoll_default_cb(FAR struct pollfd *fds)
 {
   FAR epoll_node_t *epn = fds->arg;
+  FAR epoll_head_t *eph = epn->eph;
+  pollevent_t revents;
+  irqstate_t flags;
   int semcount = 0;
 
-  epn->notified = true;
-  if (fds->revents != 0)
+  /* Move the events to the node, where epoll_teardown() takes them under
+   * the same lock, and queue the node once, however many times it is
+   * notified before it is reported.
+   */
+
+  flags = spin_lock_irqsave(&eph->rlock);
+  revents       = fds->revents;
+  fds->revents  = 0;
+  epn->revents |= revents;
+  if (!epn->notified)
+    {
+      epn->notified = true;
+      list_add_tail(&eph->ready, &epn->rnode);
+    }
+
+  spin_unlock_irqrestore(&eph->rlock, flags);
+
+  if (revents != 0)
     {
-      nxsem_get_value(&epn->eph->sem, &semcount);
+      nxsem_get_value(&eph->sem, &semcount);
       if (semcount < 1)
         {
-          nxsem_post(&epn->eph->sem);
+          nxsem_post(&eph->sem);
         }
     }
 }
@@ -413,6 +497,35 @@ static void epoll_default_cb(FAR struct pollfd *fds)
  * Public Functions
  ****************************************************************************/
 
+/****************************************************************************
+ * Name: epoll_waiting
+ *
+ * Description:
+ *   Check whether a pollfd belongs to an epoll instance that a thread is
+ *   blocked on in epoll_wait().  See poll_notify().
+ *
+ * Input Parameters:
+ *   fds - The pollfd
+ *
+ * Returned Value:
+ *   True if a thread waits for the epoll instance of the pollfd.
+ *
+ ****************************************************************************/
+
+bool epoll_waiting(FAR struct pollfd *fds)
+{
+  FAR epoll_node_t *epn = fds->arg;
+  int semcount = 0;
+
+  if (fds->cb != epoll_default_cb)
+    {
+      return false;
+    }
+
+  nxsem_get_value(&epn->eph->sem, &semcount);
+  return semcount < 0;
+}
+
 /****************************************************************************
  * Name: epoll_create
  *
@@ -497,6 +610,13 @@ int epoll_ctl(int epfd, int op, int fd, FAR struct epoll_event *ev)
       case EPOLL_CTL_ADD:
         finfo("%p CTL ADD: fd=%d ev=%08" PRIx32 "\n", eph, fd, ev->events);
 
+        if ((ev->events & (EPOLLEXCLUSIVE | EPOLLONESHOT)) ==
+            (EPOLLEXCLUSIVE | EPOLLONESHOT))
+          {
+            ret = -EINVAL;
+            goto err;
+          }
+
         /* Check repetition */
 
         list_for_every_entry(&eph->setup, epn, epoll_node_t, node)
@@ -555,6 +675,7 @@ int epoll_ctl(int epfd, int op, int fd, FAR struct epoll_event *ev)
         epn->eph         = eph;
         epn->data        = ev->data;
         epn->notified    = false;
+        epn->revents     = 0;
         epn->pfd.events  = ev->events | POLLALWAYS;
         epn->pfd.fd      = fd;
         epn->pfd.arg     = epn;
@@ -578,6 +699,7 @@ int epoll_ctl(int epfd, int op, int fd, FAR struct epoll_event *ev)
             if (epn->pfd.fd == fd)
               {
                 poll_fdsetup(fd, &epn->pfd, false);
+                epoll_unready(eph, epn);
                 list_delete(&epn->node);
                 list_add_tail(&eph->free, &epn->node);
                 goto out;
@@ -608,6 +730,15 @@ int epoll_ctl(int epfd, int op, int fd, FAR struct epoll_event *ev)
 
       case EPOLL_CTL_MOD:
         finfo("%p CTL MOD: fd=%d ev=%08" PRIx32 "\n", eph, fd, ev->events);
+
+        /* EPOLLEXCLUSIVE may only be given to EPOLL_CTL_ADD */
+
+        if ((ev->events & EPOLLEXCLUSIVE) != 0)
+          {
+            ret = -EINVAL;
+            goto err;
+          }
+
         list_for_every_entry(&eph->setup, epn, epoll_node_t, node)
           {
             if (epn->pfd.fd == fd)
@@ -615,12 +746,11 @@ int epoll_ctl(int epfd, int op, int fd, FAR struct epoll_event *ev)
                 if (epn->pfd.events != (ev->events | POLLALWAYS))
                   {
                     poll_fdsetup(fd, &epn->pfd, false);
+                    epoll_unready(eph, epn);
 
-                    epn->notified    = false;
                     epn->data        = ev->data;
                     epn->pfd.events  = ev->events | POLLALWAYS;
                     epn->pfd.fd      = fd;
-                    epn->pfd.revents = 0;
 
                     ret = poll_fdsetup(fd, &epn->pfd, true);
                     if (ret < 0)
@@ -639,11 +769,11 @@ int epoll_ctl(int epfd, int op, int fd, FAR struct epoll_event *ev)
               {
                 if (epn->pfd.events != (ev->events | POLLALWAYS))
                   {
-                    epn->notified    = false;
+                    epoll_unready(eph, epn);
+
                     epn->data        = ev->data;
                     epn->pfd.events  = ev->events | POLLALWAYS;
                     epn->pfd.fd      = fd;
-                    epn->pfd.revents = 0;
 
                     ret = poll_fdsetup(fd, &epn->pfd, true);
                     if (ret < 0)
@@ -663,11 +793,11 @@ int epoll_ctl(int epfd, int op, int fd, FAR struct epoll_event *ev)
           {
             if (epn->pfd.fd == fd)
               {
-                epn->notified    = false;
+                epoll_unready(eph, epn);
+
                 epn->data        = ev->data;
                 epn->pfd.events  = ev->events | POLLALWAYS;
                 epn->pfd.fd      = fd;
-                epn->pfd.revents = 0;
 
                 ret = poll_fdsetup(fd, &epn->pfd, true);
                 if (ret < 0)
@@ -722,11 +852,17 @@ retry:
       goto err;
     }
 
-  /* Wait the poll ready */
+  /* Wait the poll ready, unless some fds are still in the ready list,
+   * e.g. edge triggered fds that did not fit in the last epoll_wait().
+   */
 
   nxsig_procmask(SIG_SETMASK, sigmask, &oldsigmask);
 
-  if (timeout == 0)
+  if (!list_is_empty(&eph->ready))
+    {
+      ret = OK;
+    }
+  else if (timeout == 0)
     {
       ret = -ETIMEDOUT;
     }
@@ -803,9 +939,15 @@ retry:
       goto err;
     }
 
-  /* Wait the poll ready */
+  /* Wait the poll ready, unless some fds are still in the ready list,
+   * e.g. edge triggered fds that did not fit in the last epoll_wait().
+   */
 
-  if (timeout == 0)
+  if (!list_is_empty(&eph->ready))
+    {
+      ret = OK;
+    }
+  else if (timeout == 0)
     {
       ret = -ETIMEDOUT;
     }
@@ -321,7 +321,9 @@ static ssize_t eventfd_do_read(FAR struct file *filep, FAR char *buffer,
     }
 
 #ifdef CONFIG_EVENT_FD_POLL
-  /* Notify all poll/select waiters */
+  /* Notify all poll/select waiters.  A writer may be waiting for room
+   * for a large value whatever the counter was.
+   */
 
   poll_notify(dev->fds, CONFIG_EVENT_FD_NPOLLWAITERS, POLLOUT);
 #endif
@@ -346,6 +348,7 @@ static ssize_t eventfd_do_write(FAR struct file *filep,
 {
   FAR struct eventfd_priv_s *dev = filep->f_priv;
   FAR eventfd_waiter_sem_t *cur_sem;
+  eventfd_t old_counter;
   eventfd_t new_counter;
   ssize_t ret;
 
@@ -392,26 +395,39 @@ static ssize_t eventfd_do_write(FAR struct file *filep,
       nxsem_destroy(&sem.sem);
     }
 
-  /* Ready to write, update counter */
+  /* Ready to write, update counter.  Many writes before the reader runs
+   * are coalesced in the counter: only the first one, which makes the
+   * eventfd readable, needs to wake up the poll/select waiters and the
+   * blocked readers.  The others find the counter non-zero anyway.
+   *
+   * In semaphore mode, each read takes only one from the counter, so an
+   * edge-triggered epoll waiter that stopped reading while the counter is
+   * still non-zero must be told of every write.
+   */
 
+  old_counter  = dev->counter;
   dev->counter = new_counter;
 
 #ifdef CONFIG_EVENT_FD_POLL
-  /* Notify all poll/select waiters */
-
-  poll_notify(dev->fds, CONFIG_EVENT_FD_NPOLLWAITERS, POLLIN);
+  if (old_counter == 0 || (filep->f_oflags & EFD_SEMAPHORE) != 0)
+    {
+      poll_notify(dev->fds, CONFIG_EVENT_FD_NPOLLWAITERS, POLLIN);
+    }
 #endif
 
-  /* Notify all of the waiting readers */
-
-  cur_sem = dev->rdsems;
-  while (cur_sem != NULL)
+  if (old_counter == 0)
     {
-      nxsem_post(&cur_sem->sem);
-      cur_sem = cur_sem->next;
-    }
+      /* Notify all of the waiting readers */
 
-  dev->rdsems = NULL;
+      cur_sem = dev->rdsems;
+      while (cur_sem != NULL)
+        {
+          nxsem_post(&cur_sem->sem);
+          cur_sem = cur_sem->next;
+        }
+
+      dev->rdsems = NULL;
+    }
 
   nxmutex_unlock(&dev->lock);
   return sizeof(eventfd_t);
@@ -65,6 +65,16 @@ static int file_vioctl(FAR struct file *filep, int req, va_list ap)
 
   if (inode->u.i_ops != NULL && inode->u.i_ops->ioctl != NULL)
     {
+#ifdef CONFIG_FS_READAHEAD
+      /* The driver may depend on the file system position */
+
+      ret = file_readahead_sync(filep);
+      if (ret < 0)
+        {
+          return ret;
+        }
+#endif
+
       /* Yes on both accounts.  Let the driver perform the ioctl command */
 
       ret = inode->u.i_ops->ioctl(filep, req, arg);
@@ -112,6 +122,17 @@ static int file_vioctl(FAR struct file *filep, int req, va_list ap)
           }
         break;
 
+      case FIOC_FADVISE:
+        if (ret == -ENOTTY)
+          {
+#ifdef CONFIG_FS_READAHEAD
+            ret = file_readahead_advise(filep, (int)arg);
+#else
+            ret = OK;
+#endif
+          }
+        break;
+
 #ifdef CONFIG_FDSAN
       case FIOC_SETTAG:
         tag = (FAR uint64_t *)arg;
@@ -62,6 +62,15 @@ off_t file_seek(FAR struct file *filep, off_t offset, int whence)
   DEBUGASSERT(filep);
   inode =  filep->f_inode;
 
+#ifdef CONFIG_FS_READAHEAD
+  /* Readahead may have left the file system ahead of f_pos */
+
+  if (filep->f_ra != NULL)
+    {
+      return file_readahead_seek(filep, offset, whence);
+    }
+
+#endif
   /* Invoke the file seek method if available */
 
   if (inode && inode->u.i_ops && inode->u.i_ops->seek)
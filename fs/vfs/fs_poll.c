@@ -24,6 +24,8 @@
 
 #include <nuttx/config.h>
 
+#include <sys/epoll.h>
+
 #include <poll.h>
 #include <time.h>
 #include <assert.h>
@@ -230,7 +232,11 @@ void poll_default_cb(FAR struct pollfd *fds)
  *
  * Description:
  *   Notify the poll, this function should be called by drivers to notify
- *   the caller the poll is ready.
+ *   the caller the poll is ready.  The pollfds registered with
+ *   EPOLLEXCLUSIVE are notified in order until one whose epoll instance
+ *   has a thread waiting in epoll_wait() was, unless the event is an error
+ *   or a hang up.  Like Linux, if no epoll instance waits, all of them are
+ *   notified, so that the event is not lost.
  *
  * Input Parameters:
  *   afds     - The fds array
@@ -246,6 +252,8 @@ void poll_notify(FAR struct pollfd **afds, int nfds, pollevent_t eventset)
 {
   int i;
   FAR struct pollfd *fds;
+  bool exclusive = false;
+  bool waiting;
 
   DEBUGASSERT(afds != NULL && nfds >= 1);
 
@@ -254,6 +262,13 @@ void poll_notify(FAR struct pollfd **afds, int nfds, pollevent_t eventset)
       fds = afds[i];
       if (fds != NULL)
         {
+          /* Skip the other exclusive waiters once one was notified */
+
+          if ((fds->events & EPOLLEXCLUSIVE) != 0 && exclusive)
+            {
+              continue;
+            }
+
           /* The error event must be set in fds->revents */
 
           fds->revents |= eventset & (fds->events | POLLERR | POLLHUP);
@@ -267,8 +282,20 @@ void poll_notify(FAR struct pollfd **afds, int nfds, pollevent_t eventset)
           if ((fds->revents != 0 || (fds->events & POLLALWAYS) != 0) &&
               fds->cb != NULL)
             {
+              /* Check for a waiter before the callback wakes it up */
+
+              waiting = (fds->events & EPOLLEXCLUSIVE) != 0 &&
+                        fds->revents != 0 &&
+                        (eventset & (POLLERR | POLLHUP)) == 0 &&
+                        epoll_waiting(fds);
+
               finfo("Report events: %08" PRIx32 "\n", fds->revents);
               fds->cb(fds);
+
+              if (waiting)
+                {
+                  exclusive = true;
+                }
             }
         }
     }
@@ -78,6 +78,15 @@ ssize_t file_read(FAR struct file *filep, FAR void *buf, size_t nbytes)
       ret = -EACCES;
     }
 
+#ifdef CONFIG_FS_READAHEAD
+  /* Has readahead been enabled on this file by posix_fadvise()? */
+
+  else if (filep->f_ra != NULL)
+    {
+      ret = (int)file_readahead(filep, buf, nbytes);
+    }
+#endif
+
   /* Is a driver or mountpoint registered? If so, does it support the read
    * method?
    */
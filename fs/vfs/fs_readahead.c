@@ -0,0 +1,594 @@
+/****************************************************************************
+ * fs/vfs/fs_readahead.c
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <sys/types.h>
+#include <stdatomic.h>
+#include <fcntl.h>
+#include <string.h>
+#include <assert.h>
+#include <errno.h>
+#include <debug.h>
+
+#include <nuttx/kmalloc.h>
+#include <nuttx/mutex.h>
+
+#include "inode/inode.h"
+
+#ifdef CONFIG_FS_READAHEAD
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+#if CONFIG_FS_READAHEAD_MINSIZE > CONFIG_FS_READAHEAD_MAXSIZE
+#  error CONFIG_FS_READAHEAD_MINSIZE > CONFIG_FS_READAHEAD_MAXSIZE
+#endif
+
+/****************************************************************************
+ * Private Types
+ ****************************************************************************/
+
+/* Per open file readahead state.  The buffer holds the file data in the
+ * range [ra_start, ra_start + ra_nbytes).  It is only valid as long as
+ * ra_wrgen matches the write generation of the inode, i.e. as long as
+ * nothing has been written to the file system through any descriptor.
+ *
+ * Serving a read from the buffer leaves the file system where the last
+ * refill left it, ahead of the caller's position in f_pos.  Instead of
+ * seeking the file system back on every read, which costs a walk of the
+ * cluster chain on FAT, the file is then "detached": ra_fspos remembers
+ * the position of the file system, which is given back to it before any
+ * other operation on the file (see file_readahead_sync()).
+ */
+
+struct file_readahead_s
+{
+  mutex_t      ra_lock;     /* Protects the readahead state */
+  FAR uint8_t *ra_buffer;   /* The buffer, NULL if readahead is disabled */
+  off_t        ra_start;    /* File offset of the first buffered byte */
+  off_t        ra_next;     /* Offset expected by the next sequential read */
+  off_t        ra_fspos;    /* Position of the file system if detached */
+  size_t       ra_nbytes;   /* Number of valid bytes in ra_buffer */
+  size_t       ra_window;   /* Current size of the readahead window */
+  unsigned int ra_wrgen;    /* Inode write generation of the buffer */
+  bool         ra_detached; /* f_pos is not the file system position */
+};
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: file_readahead_wrgen
+ *
+ * Description:
+ *   Return the write generation of an inode.
+ *
+ ****************************************************************************/
+
+static inline unsigned int file_readahead_wrgen(FAR struct inode *inode)
+{
+  return atomic_load((FAR atomic_uint *)&inode->i_wrgen);
+}
+
+/****************************************************************************
+ * Name: file_readahead_fsseek
+ *
+ * Description:
+ *   Seek the file system, bypassing file_seek() which would sync the
+ *   readahead state again.
+ *
+ ****************************************************************************/
+
+static off_t file_readahead_fsseek(FAR struct file *filep, off_t offset,
+                                   int whence)
+{
+  FAR struct inode *inode = filep->f_inode;
+
+  if (inode->u.i_ops->seek != NULL)
+    {
+      return inode->u.i_ops->seek(filep, offset, whence);
+    }
+
+  if (whence == SEEK_CUR)
+    {
+      offset += filep->f_pos;
+    }
+  else if (whence != SEEK_SET)
+    {
+      return whence == SEEK_END ? -ENOSYS : -EINVAL;
+    }
+
+  if (offset < 0)
+    {
+      return -EINVAL;
+    }
+
+  filep->f_pos = offset;
+  return offset;
+}
+
+/****************************************************************************
+ * Name: file_readahead_attach
+ *
+ * Description:
+ *   Give the file system its own position back in f_pos, and return the
+ *   caller's position.  No I/O is performed.
+ *
+ ****************************************************************************/
+
+static off_t file_readahead_attach(FAR struct file *filep,
+                                   FAR struct file_readahead_s *ra)
+{
+  off_t pos = filep->f_pos;
+
+  if (ra->ra_detached)
+    {
+      filep->f_pos    = ra->ra_fspos;
+      ra->ra_detached = false;
+    }
+
+  return pos;
+}
+
+/****************************************************************************
+ * Name: file_readahead_moveto
+ *
+ * Description:
+ *   Move the file system to 'pos', seeking only if it is not already
+ *   there.  In a sequential stream the buffer is refilled exactly where the
+ *   previous refill stopped, so no seek is needed.
+ *
+ ****************************************************************************/
+
+static int file_readahead_moveto(FAR struct file *filep,
+                                 FAR struct file_readahead_s *ra, off_t pos)
+{
+  off_t ret;
+
+  file_readahead_attach(filep, ra);
+  if (filep->f_pos == pos)
+    {
+      return OK;
+    }
+
+  ret = file_readahead_fsseek(filep, pos, SEEK_SET);
+  return ret < 0 ? (int)ret : OK;
+}
+
+/****************************************************************************
+ * Name: file_readahead_detach
+ *
+ * Description:
+ *   Show the caller's position 'pos' in f_pos, remembering the position of
+ *   the file system if it differs.
+ *
+ ****************************************************************************/
+
+static void file_readahead_detach(FAR struct file *filep,
+                                  FAR struct file_readahead_s *ra, off_t pos)
+{
+  if (!ra->ra_detached && filep->f_pos != pos)
+    {
+      ra->ra_fspos    = filep->f_pos;
+      ra->ra_detached = true;
+    }
+
+  filep->f_pos = pos;
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: file_readahead
+ *
+ * Description:
+ *   Read from a file that has readahead enabled.  Sequential reads are
+ *   served from the readahead buffer which is refilled with one large
+ *   read of the underlying file system, the size of which doubles on
+ *   every refill up to CONFIG_FS_READAHEAD_MAXSIZE.  Any non-sequential
+ *   read collapses the window and bypasses the buffer.
+ *
+ * Input Parameters:
+ *   filep  - File structure instance
+ *   buf    - User-provided to save the data
+ *   nbytes - The maximum size of the user-provided buffer
+ *
+ * Returned Value:
+ *   The positive non-zero number of bytes read on success, 0 on if an
+ *   end-of-file condition, or a negated errno value on any failure.
+ *
+ ****************************************************************************/
+
+ssize_t file_readahead(FAR struct file *filep, FAR void *buf, size_t nbytes)
+{
+  FAR struct file_readahead_s *ra = filep->f_ra;
+  FAR struct inode *inode = filep->f_inode;
+  FAR uint8_t *dest = buf;
+  size_t ncopied = 0;
+  ssize_t nread = 0;
+  unsigned int wrgen;
+  off_t pos;
+  int ret;
+
+  DEBUGASSERT(ra != NULL && inode != NULL && inode->u.i_ops->read != NULL);
+
+  ret = nxmutex_lock(&ra->ra_lock);
+  if (ret < 0)
+    {
+      return ret;
+    }
+
+  pos = filep->f_pos;
+
+  /* Drop the buffered data if anything was written in the meantime */
+
+  wrgen = file_readahead_wrgen(inode);
+  if (ra->ra_wrgen != wrgen)
+    {
+      ra->ra_wrgen  = wrgen;
+      ra->ra_nbytes = 0;
+    }
+
+  /* Readahead disabled or random access: collapse the window and go
+   * straight to the file system.
+   */
+
+  if (ra->ra_buffer == NULL || pos != ra->ra_next)
+    {
+      ra->ra_window = CONFIG_FS_READAHEAD_MINSIZE;
+      ra->ra_nbytes = 0;
+
+      ret = file_readahead_moveto(filep, ra, pos);
+      nread = ret < 0 ? ret : inode->u.i_ops->read(filep, buf, nbytes);
+      ra->ra_next = filep->f_pos;
+      nxmutex_unlock(&ra->ra_lock);
+      return nread;
+    }
+
+  while (ncopied < nbytes)
+    {
+      size_t remaining = nbytes - ncopied;
+
+      /* Serve as much as possible from the readahead buffer */
+
+      if (pos >= ra->ra_start && pos < ra->ra_start + ra->ra_nbytes)
+        {
+          size_t offset = pos - ra->ra_start;
+          size_t ncopy  = ra->ra_nbytes - offset;
+
+          if (ncopy > remaining)
+            {
+              ncopy = remaining;
+            }
+
+          memcpy(dest + ncopied, ra->ra_buffer + offset, ncopy);
+          ncopied += ncopy;
+          pos     += ncopy;
+          continue;
+        }
+
+      ret = file_readahead_moveto(filep, ra, pos);
+      if (ret < 0)
+        {
+          nread = ret;
+          break;
+        }
+
+      /* Requests larger than the window gain nothing from the buffer */
+
+      if (remaining >= ra->ra_window)
+        {
+          ra->ra_nbytes = 0;
+          nread = inode->u.i_ops->read(filep, (FAR char *)dest + ncopied,
+                                       remaining);
+          if (nread > 0)
+            {
+              ncopied += nread;
+              pos     += nread;
+            }
+
+          break;
+        }
+
+      /* Refill the buffer with the next window of the file */
+
+      ra->ra_nbytes = 0;
+      nread = inode->u.i_ops->read(filep, (FAR char *)ra->ra_buffer,
+                                   ra->ra_window);
+      if (nread <= 0)
+        {
+          break;
+        }
+
+      ra->ra_start  = pos;
+      ra->ra_nbytes = nread;
+
+      /* The stream is still sequential, open the window further */
+
+      if (ra->ra_window < CONFIG_FS_READAHEAD_MAXSIZE)
+        {
+          ra->ra_window <<= 1;
+          if (ra->ra_window > CONFIG_FS_READAHEAD_MAXSIZE)
+            {
+              ra->ra_window = CONFIG_FS_READAHEAD_MAXSIZE;
+            }
+        }
+    }
+
+  /* Show the caller's position, leaving the file system where it is */
+
+  file_readahead_detach(filep, ra, pos);
+  ra->ra_next = pos;
+
+  nxmutex_unlock(&ra->ra_lock);
+  return ncopied > 0 ? (ssize_t)ncopied : nread;
+}
+
+/****************************************************************************
+ * Name: file_readahead_invalidate
+ *
+ * Description:
+ *   Invalidate the readahead buffers of all the files on an inode.  Called
+ *   both before and after a write: a reader that refilled its buffer
+ *   while the write was in progress may hold old data, and must see the
+ *   generation change again once the write is complete.
+ *
+ * Input Parameters:
+ *   inode - The inode written to
+ *
+ ****************************************************************************/
+
+void file_readahead_invalidate(FAR struct inode *inode)
+{
+  atomic_fetch_add((FAR atomic_uint *)&inode->i_wrgen, 1);
+}
+
+/****************************************************************************
+ * Name: file_readahead_sync
+ *
+ * Description:
+ *   Move the file system back to the caller's position if buffered reads
+ *   left it elsewhere.  This must be called before any operation other
+ *   than read() that depends on the file system position.
+ *
+ * Input Parameters:
+ *   filep  - File structure instance
+ *
+ * Returned Value:
+ *   Zero (OK) on success; a negated errno value on failure.
+ *
+ ****************************************************************************/
+
+int file_readahead_sync(FAR struct file *filep)
+{
+  FAR struct file_readahead_s *ra = filep->f_ra;
+  int ret;
+
+  if (ra == NULL)
+    {
+      return OK;
+    }
+
+  ret = nxmutex_lock(&ra->ra_lock);
+  if (ret >= 0)
+    {
+      ret = file_readahead_moveto(filep, ra, filep->f_pos);
+      nxmutex_unlock(&ra->ra_lock);
+    }
+
+  return ret;
+}
+
+/****************************************************************************
+ * Name: file_readahead_seek
+ *
+ * Description:
+ *   Seek a file that has readahead state.  A query of the current position
+ *   (SEEK_CUR with a zero offset, as done by ftell()) does not touch the
+ *   file system at all.
+ *
+ * Input Parameters:
+ *   filep  - File structure instance
+ *   offset - Defines the offset to position to
+ *   whence - Defines how to use offset
+ *
+ * Returned Value:
+ *   The resulting offset on success.  A negated errno value is returned on
+ *   any failure.
+ *
+ ****************************************************************************/
+
+off_t file_readahead_seek(FAR struct file *filep, off_t offset, int whence)
+{
+  FAR struct file_readahead_s *ra = filep->f_ra;
+  off_t pos;
+  off_t ret;
+
+  DEBUGASSERT(ra != NULL);
+
+  ret = nxmutex_lock(&ra->ra_lock);
+  if (ret < 0)
+    {
+      return ret;
+    }
+
+  pos = filep->f_pos;
+  if (whence == SEEK_CUR)
+    {
+      offset += pos;
+      whence  = SEEK_SET;
+    }
+
+  if (whence == SEEK_SET && offset == pos)
+    {
+      ret = pos;
+    }
+  else
+    {
+      file_readahead_attach(filep, ra);
+      ret = file_readahead_fsseek(filep, offset, whence);
+      if (ret < 0)
+        {
+          /* The caller's position is unchanged on failure */
+
+          file_readahead_detach(filep, ra, pos);
+        }
+    }
+
+  nxmutex_unlock(&ra->ra_lock);
+  return ret;
+}
+
+/****************************************************************************
+ * Name: file_readahead_advise
+ *
+ * Description:
+ *   Apply posix_fadvise() advice to the readahead state of the file.
+ *   POSIX_FADV_SEQUENTIAL enables readahead, POSIX_FADV_NORMAL and
+ *   POSIX_FADV_RANDOM disable it and POSIX_FADV_DONTNEED drops the
+ *   buffered data.  The state itself, with its lock, lives until the file
+ *   is closed, so that a concurrent read never sees it freed.
+ *
+ * Input Parameters:
+ *   filep  - File structure instance
+ *   advice - One of POSIX_FADV_*
+ *
+ * Returned Value:
+ *   Zero (OK) on success; a negated errno value on failure.
+ *
+ ****************************************************************************/
+
+int file_readahead_advise(FAR struct file *filep, int advice)
+{
+  FAR struct file_readahead_s *ra = filep->f_ra;
+  FAR struct inode *inode = filep->f_inode;
+  int ret;
+
+  switch (advice)
+    {
+      case POSIX_FADV_SEQUENTIAL:
+
+        /* Only regular files on mounted volumes are worth buffering */
+
+        if (inode == NULL || !INODE_IS_MOUNTPT(inode) ||
+            inode->u.i_mops->read == NULL)
+          {
+            return OK;
+          }
+
+        if (ra == NULL)
+          {
+            ra = kmm_zalloc(sizeof(struct file_readahead_s));
+            if (ra == NULL)
+              {
+                return -ENOMEM;
+              }
+
+            nxmutex_init(&ra->ra_lock);
+            ra->ra_wrgen = file_readahead_wrgen(inode);
+            filep->f_ra  = ra;
+          }
+        break;
+
+      case POSIX_FADV_NORMAL:
+      case POSIX_FADV_RANDOM:
+      case POSIX_FADV_DONTNEED:
+        if (ra == NULL)
+          {
+            return OK;
+          }
+        break;
+
+      case POSIX_FADV_WILLNEED:
+      case POSIX_FADV_NOREUSE:
+        return OK;
+
+      default:
+        return -EINVAL;
+    }
+
+  ret = nxmutex_lock(&ra->ra_lock);
+  if (ret < 0)
+    {
+      return ret;
+    }
+
+  ra->ra_nbytes = 0;
+
+  if (advice == POSIX_FADV_SEQUENTIAL)
+    {
+      if (ra->ra_buffer == NULL)
+        {
+          ra->ra_buffer = kmm_malloc(CONFIG_FS_READAHEAD_MAXSIZE);
+          if (ra->ra_buffer == NULL)
+            {
+              ret = -ENOMEM;
+            }
+        }
+
+      ra->ra_next   = filep->f_pos;
+      ra->ra_window = CONFIG_FS_READAHEAD_MINSIZE;
+    }
+  else if (advice != POSIX_FADV_DONTNEED)
+    {
+      /* Disable readahead: give the file system the caller's position back
+       * and free the buffer.
+       */
+
+      ret = file_readahead_moveto(filep, ra, filep->f_pos);
+      kmm_free(ra->ra_buffer);
+      ra->ra_buffer = NULL;
+    }
+
+  nxmutex_unlock(&ra->ra_lock);
+  return ret;
+}
+
+/****************************************************************************
+ * Name: file_readahead_release
+ *
+ * Description:
+ *   Free the readahead state of the file, if any.
+ *
+ ****************************************************************************/
+
+void file_readahead_release(FAR struct file *filep)
+{
+  FAR struct file_readahead_s *ra = filep->f_ra;
+
+  if (ra != NULL)
+    {
+      nxmutex_destroy(&ra->ra_lock);
+      kmm_free(ra->ra_buffer);
+      kmm_free(ra);
+      filep->f_ra = NULL;
+    }
+}
+
+#endif /* CONFIG_FS_READAHEAD */
@@ -392,10 +392,6 @@ static void timerfd_timeout(wdparm_t arg)
 
   intflags = enter_critical_section();
 
-  /* Increment timer expiration counter */
-
-  dev->counter++;
-
   /* If this is a repetitive timer, then restart the watchdog */
 
   if (dev->delay > 0)
@@ -403,6 +399,17 @@ static void timerfd_timeout(wdparm_t arg)
       wd_start(&dev->wdog, dev->delay, timerfd_timeout, arg);
     }
 
+  /* Increment timer expiration counter.  Expirations that occur before
+   * the counter is read are only counted: the waiters were woken up by
+   * the first one and will collect all of them in a single read.
+   */
+
+  if (dev->counter++ > 0)
+    {
+      leave_critical_section(intflags);
+      return;
+    }
+
 #ifdef CONFIG_TIMER_FD_POLL
   /* Notify all poll/select waiters */
 
@@ -51,6 +51,9 @@
 int file_truncate(FAR struct file *filep, off_t length)
 {
   struct inode *inode;
+#ifdef CONFIG_FS_READAHEAD
+  int ret;
+#endif
 
   /* Was this file opened for write access? */
 
@@ -99,7 +102,20 @@ int file_truncate(FAR struct file *filep, off_t length)
 
   /* Yes, then tell the file system to truncate this file */
 
+#ifdef CONFIG_FS_READAHEAD
+  ret = file_readahead_sync(filep);
+  if (ret < 0)
+    {
+      return ret;
+    }
+
+  file_readahead_invalidate(inode);
+  ret = inode->u.i_ops->truncate(filep, length);
+  file_readahead_invalidate(inode);
+  return ret;
+#else
   return inode->u.i_ops->truncate(filep, length);
+#endif
 }
 
 /****************************************************************************
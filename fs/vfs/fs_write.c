@@ -68,6 +68,9 @@ ssize_t file_write(FAR struct file *filep, FAR const void *buf,
                    size_t nbytes)
 {
   FAR struct inode *inode;
+#ifdef CONFIG_FS_READAHEAD
+  ssize_t ret;
+#endif
 
   /* Was this file opened for write access? */
 
@@ -86,7 +89,25 @@ ssize_t file_write(FAR struct file *filep, FAR const void *buf,
 
   /* Yes, then let the driver perform the write */
 
+#ifdef CONFIG_FS_READAHEAD
+  /* Write at the caller's position, not where readahead left the file
+   * system, and invalidate the readahead buffers of all files on this
+   * inode, before and after the write.
+   */
+
+  ret = file_readahead_sync(filep);
+  if (ret < 0)
+    {
+      return ret;
+    }
+
+  file_readahead_invalidate(inode);
+  ret = inode->u.i_ops->write(filep, buf, nbytes);
+  file_readahead_invalidate(inode);
+  return ret;
+#else
   return inode->u.i_ops->write(filep, buf, nbytes);
+#endif
 }
 
 /****************************************************************************
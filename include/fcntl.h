@@ -142,6 +142,15 @@
 #define F_SEAL_WRITE        0x0008 /* Prevent writes */
 #define F_SEAL_FUTURE_WRITE 0x0010 /* Prevent future writes while mapped */
 
+/* Advice used by posix_fadvise() */
+
+#define POSIX_FADV_NORMAL     0 /* No advice, the default */
+#define POSIX_FADV_RANDOM     1 /* Expect random access */
+#define POSIX_FADV_SEQUENTIAL 2 /* Expect sequential access */
+#define POSIX_FADV_WILLNEED   3 /* The data will be accessed soon */
+#define POSIX_FADV_DONTNEED   4 /* The data will not be accessed soon */
+#define POSIX_FADV_NOREUSE    5 /* The data will be accessed only once */
+
 /* int creat(const char *path, mode_t mode);
  *
  * is equivalent to open with O_WRONLY|O_CREAT|O_TRUNC.
@@ -201,6 +210,7 @@ int open(FAR const char *path, int oflag, ...);
 int openat(int dirfd, FAR const char *path, int oflag, ...);
 int fcntl(int fd, int cmd, ...);
 
+int posix_fadvise(int fd, off_t offset, off_t len, int advice);
 int posix_fallocate(int fd, off_t offset, off_t len);
 
 #undef EXTERN
@@ -480,6 +480,21 @@ int up_backtrace(FAR struct tcb_s *tcb,
                  FAR void **buffer, int size, int skip);
 #endif /* CONFIG_ARCH_HAVE_BACKTRACE */
 
+/****************************************************************************
+ * Name: up_getusrpc
+ *
+ * Description:
+ *   Return the program counter saved in the register context 'regs'.  If
+ *   regs is NULL, the context interrupted by the current interrupt is
+ *   used, so this may only be called from interrupt context then.
+ *
+ *   Architectures selecting CONFIG_ARCH_HAVE_GETUSRPC provide this as a
+ *   macro in arch/irq.h.
+ *
+ ****************************************************************************/
+
+/* uintptr_t up_getusrpc(FAR void *regs); */
+
 /****************************************************************************
  * Name: up_schedule_sigaction
  *
@@ -2779,6 +2794,31 @@ unsigned long up_perf_gettime(void);
 unsigned long up_perf_getfreq(void);
 void up_perf_convert(unsigned long elapsed, FAR struct timespec *ts);
 
+/****************************************************************************
+ * Name: up_pmu_*
+ *
+ * Description:
+ *   Access to the programmable counters of the PMU of the current CPU,
+ *   used by the perf events framework.  They are always called with the
+ *   local interrupts disabled.
+ *
+ *   up_pmu_counters() returns the number of programmable counters.
+ *   up_pmu_start() programs 'counter' to count 'event', one of
+ *   PERF_COUNT_HW_*, and starts it from zero.  It returns -ENOTSUP if the
+ *   PMU can not count that event.  up_pmu_stop() stops the counter and
+ *   up_pmu_read() returns its current value.  The value is 64 bits wide,
+ *   hardware counters that are narrower must be extended (for instance
+ *   from their overflow interrupt) so that they do not wrap.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_ARCH_HAVE_PMU
+int up_pmu_counters(void);
+int up_pmu_start(int counter, int event);
+void up_pmu_stop(int counter);
+uint64_t up_pmu_read(int counter);
+#endif
+
 /****************************************************************************
  * Name: up_show_cpuinfo
  *
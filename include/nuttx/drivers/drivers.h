@@ -81,6 +81,18 @@ void devnull_register(void);
 void devascii_register(void);
 #endif
 
+/****************************************************************************
+ * Name: devprofile_register
+ *
+ * Description:
+ *   Register /dev/profile
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_DEV_PROFILE
+void devprofile_register(void);
+#endif
+
 /****************************************************************************
  * Name: devrandom_register
  *
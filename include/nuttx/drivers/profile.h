@@ -0,0 +1,64 @@
+/****************************************************************************
+ * include/nuttx/drivers/profile.h
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+#ifndef __INCLUDE_NUTTX_DRIVERS_PROFILE_H
+#define __INCLUDE_NUTTX_DRIVERS_PROFILE_H
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+#include <nuttx/fs/ioctl.h>
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+/* IOCTL Commands ***********************************************************/
+
+/* PROFIOC_START
+ *              - Discard the samples collected so far and start sampling
+ *                Argument: Sampling frequency in Hz, 0 for the default
+ *                          CONFIG_DEV_PROFILE_FREQUENCY
+ * PROFIOC_STOP
+ *              - Stop sampling.  The samples are kept until read.
+ *                Argument: Ignored
+ * PROFIOC_GETDROPPED
+ *              - Get the number of samples lost because a buffer was full
+ *                Argument: A writable pointer to unsigned long
+ */
+
+#define PROFIOC_START           _PROFIOC(0x01)
+#define PROFIOC_STOP            _PROFIOC(0x02)
+#define PROFIOC_GETDROPPED      _PROFIOC(0x03)
+
+/* Reading /dev/profile returns the samples in the legacy gperftools CPU
+ * profile format understood by pprof, made of uintptr_t words:
+ *
+ *   Header:  0, 3, 0, <sampling period in usec>, 0
+ *   Sample:  1, <depth>, <pc>, <caller>, ...
+ *   Trailer: 0, 1, 0
+ *
+ * The samples are removed as they are read.  The trailer is returned once
+ * the buffers are empty, after which read() returns 0.
+ */
+
+#endif /* __INCLUDE_NUTTX_DRIVERS_PROFILE_H */
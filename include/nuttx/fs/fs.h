@@ -176,6 +176,7 @@ struct statfs;
 struct pollfd;
 struct mtd_dev_s;
 struct tcb_s;
+struct aiocb;
 
 /* The internal representation of type DIR is just a container for an inode
  * reference, and the path of directory.
@@ -411,6 +412,9 @@ struct inode
   uint16_t          i_flags;    /* Flags for inode */
   union inode_ops_u u;          /* Inode operations */
   ino_t             i_ino;      /* Inode serial number */
+#ifdef CONFIG_FS_READAHEAD
+  unsigned int      i_wrgen;    /* Write generation, invalidates readahead */
+#endif
 #ifdef CONFIG_PSEUDOFS_FILE
   size_t            i_size;     /* The size of per inode driver */
 #endif
@@ -469,6 +473,9 @@ struct file
 #ifdef CONFIG_FDSAN
   uint64_t          f_tag;      /* file owner tag, init to 0 */
 #endif
+#ifdef CONFIG_FS_READAHEAD
+  FAR struct file_readahead_s *f_ra; /* Readahead state, see posix_fadvise */
+#endif
 };
 
 /* This defines a two layer array of files indexed by the file descriptor.
@@ -1509,6 +1516,17 @@ int file_mmap(FAR struct file *filep, FAR void *start, size_t length,
 
 int file_munmap(FAR void *start, size_t length);
 
+/****************************************************************************
+ * Name: file_msync
+ *
+ * Description:
+ *   Equivalent to the standard msync() function except it does not set
+ *   the errno variable.
+ *
+ ****************************************************************************/
+
+int file_msync(FAR void *start, size_t length, int flags);
+
 /****************************************************************************
  * Name: file_ioctl
  *
@@ -1734,6 +1752,31 @@ int file_pipe(FAR struct file *filep[2], size_t bufsize, int flags);
 int nx_mkfifo(FAR const char *pathname, mode_t mode, size_t bufsize);
 #endif
 
+/****************************************************************************
+ * Name: nx_lio_submit
+ *
+ * Description:
+ *   Submit all of the asynchronous I/O operations of a lio_listio() list in
+ *   a single call.  This is the submission part of lio_listio(), which is
+ *   performed in the kernel so that a list of operations costs one system
+ *   call rather than one per operation.
+ *
+ * Input Parameters:
+ *   list    - The list of AIO control blocks, NULL entries are skipped
+ *   nent    - The number of entries in the list
+ *   nqueued - The location to return the number of operations queued
+ *
+ * Returned Value:
+ *   Zero (OK) if every operation was submitted; -EIO if one or more could
+ *   not be, in which case their aio_result holds the reason.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_FS_AIO
+int nx_lio_submit(FAR struct aiocb * const list[], int nent,
+                  FAR int *nqueued);
+#endif
+
 #undef EXTERN
 #if defined(__cplusplus)
 }
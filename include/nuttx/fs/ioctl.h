@@ -99,6 +99,8 @@
 #define _SEIOCBASE      (0x3a00) /* Secure element ioctl commands */
 #define _SYSLOGBASE     (0x3c00) /* Syslog device ioctl commands */
 #define _STEPIOBASE     (0x3d00) /* Stepper device ioctl commands */
+#define _PROFIOBASE     (0x3e00) /* Profiler device ioctl commands */
+#define _PERFIOBASE     (0x3f00) /* Performance counter ioctl commands */
 #define _WLIOCBASE      (0x8b00) /* Wireless modules ioctl network commands */
 
 /* boardctl() commands share the same number space */
@@ -200,6 +202,11 @@
                                            */
 #endif
 
+#define FIOC_FADVISE    _FIOC(0x0010)     /* IN:  The posix_fadvise() advice
+                                           *      (POSIX_FADV_*)
+                                           * OUT: None
+                                           */
+
 /* NuttX file system ioctl definitions **************************************/
 
 #define _DIOCVALID(c)   (_IOC_TYPE(c)==_DIOCBASE)
@@ -618,6 +625,20 @@
 #define _STEPIOCVALID(c)    (_IOC_TYPE(c) == _STEPIOBASE)
 #define _STEPIOC(nr)        _IOC(_STEPIOBASE, nr)
 
+/* Profiler driver **********************************************************/
+
+/* (see nuttx/include/drivers/profile.h */
+
+#define _PROFIOCVALID(c)    (_IOC_TYPE(c) == _PROFIOBASE)
+#define _PROFIOC(nr)        _IOC(_PROFIOBASE, nr)
+
+/* Performance counter driver ***********************************************/
+
+/* (see nuttx/include/perf.h */
+
+#define _PERFIOCVALID(c)    (_IOC_TYPE(c) == _PERFIOBASE)
+#define _PERFIOC(nr)        _IOC(_PERFIOBASE, nr)
+
 /* MATH drivers *************************************************************/
 
 #define _MATHIOCVALID(c)    (_IOC_TYPE(c) == _MATHIOBASE)
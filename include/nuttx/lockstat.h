@@ -0,0 +1,187 @@
+/****************************************************************************
+ * include/nuttx/lockstat.h
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+#ifndef __INCLUDE_NUTTX_LOCKSTAT_H
+#define __INCLUDE_NUTTX_LOCKSTAT_H
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <sys/types.h>
+#include <stdbool.h>
+#include <stdint.h>
+
+#include <nuttx/spinlock.h>
+
+#ifdef CONFIG_SCHED_LOCKSTAT
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+/* Lock types */
+
+#define LOCKSTAT_MUTEX          0
+#define LOCKSTAT_SPINLOCK       1
+
+/* Number of top waiters kept per lock class */
+
+#define LOCKSTAT_NWAITERS       4
+
+/****************************************************************************
+ * Public Types
+ ****************************************************************************/
+
+/* A thread that waited for a lock class, and for how long in total */
+
+struct lockstat_waiter_s
+{
+  pid_t   pid;                      /* ID of the thread */
+  clock_t wait_time;                /* Total time waited */
+};
+
+/* Statistics of a lock class.  Mutexes are grouped by the place where they
+ * are initialized, statically initialized mutexes and spinlocks are each
+ * a class of their own.  Each CPU keeps a bounded table of classes, in
+ * which a new class replaces the least used one.  Times are in
+ * perf_gettime() units.
+ */
+
+struct lockstat_class_s
+{
+  FAR const void *key;              /* Init site, or address of the lock */
+  uint8_t  type;                    /* LOCKSTAT_MUTEX or LOCKSTAT_SPINLOCK */
+  uint32_t nacquired;               /* Number of acquisitions */
+  uint32_t ncontended;              /* Acquisitions that had to wait */
+  clock_t  wait_time;               /* Total time waited */
+  clock_t  wait_max;                /* Longest wait */
+  clock_t  hold_time;               /* Total time held */
+  clock_t  hold_max;                /* Longest hold */
+  struct lockstat_waiter_s waiters[LOCKSTAT_NWAITERS];
+};
+
+/* Per mutex state */
+
+struct lockstat_s
+{
+  FAR const void *key;              /* Init site, or NULL */
+  clock_t hold_start;               /* Time the mutex was acquired */
+};
+
+/****************************************************************************
+ * Public Function Prototypes
+ ****************************************************************************/
+
+#ifdef __cplusplus
+#define EXTERN extern "C"
+extern "C"
+{
+#else
+#define EXTERN extern
+#endif
+
+/****************************************************************************
+ * Name: lockstat_init
+ *
+ * Description:
+ *   Attach a mutex to the class of its initialization site 'site'.
+ *
+ ****************************************************************************/
+
+void lockstat_init(FAR struct lockstat_s *stat, FAR const void *site);
+
+/****************************************************************************
+ * Name: lockstat_acquired
+ *
+ * Description:
+ *   Record the acquisition of a mutex whose acquisition started at 'start'.
+ *   'lock' identifies the class of a mutex that was not initialized by
+ *   lockstat_init().
+ *
+ ****************************************************************************/
+
+void lockstat_acquired(FAR struct lockstat_s *stat, FAR const void *lock,
+                       clock_t start, bool contended);
+
+/****************************************************************************
+ * Name: lockstat_released
+ *
+ * Description:
+ *   Record the release of a mutex.  'lock' is as for lockstat_acquired().
+ *
+ ****************************************************************************/
+
+void lockstat_released(FAR struct lockstat_s *stat, FAR const void *lock);
+
+/****************************************************************************
+ * Name: lockstat_spin_acquired
+ *
+ * Description:
+ *   Record the acquisition of a spinlock.
+ *
+ ****************************************************************************/
+
+void lockstat_spin_acquired(FAR volatile spinlock_t *lock, clock_t start,
+                            bool contended);
+
+/****************************************************************************
+ * Name: lockstat_spin_released
+ *
+ * Description:
+ *   Record the release of a spinlock.
+ *
+ ****************************************************************************/
+
+void lockstat_spin_released(FAR volatile spinlock_t *lock);
+
+/****************************************************************************
+ * Name: lockstat_snapshot
+ *
+ * Description:
+ *   Copy up to 'nclasses' lock classes to 'classes', adding up the
+ *   statistics of the CPUs.
+ *
+ * Returned Value:
+ *   The number of classes copied.
+ *
+ ****************************************************************************/
+
+int lockstat_snapshot(FAR struct lockstat_class_s *classes, int nclasses);
+
+/****************************************************************************
+ * Name: lockstat_reset
+ *
+ * Description:
+ *   Clear the statistics of all lock classes.
+ *
+ ****************************************************************************/
+
+void lockstat_reset(void);
+
+#undef EXTERN
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* CONFIG_SCHED_LOCKSTAT */
+#endif /* __INCLUDE_NUTTX_LOCKSTAT_H */
@@ -67,6 +67,16 @@ struct mm_map_entry_s
                 FAR struct mm_map_entry_s *entry,
                 FAR void *start,
                 size_t length);
+
+  /* Drivers whose mappings are not coherent with the backing object (e.g.
+   * the RAM copy of a file) may implement msync to write the modified
+   * range back.  NULL means that there is nothing to synchronize.
+   */
+
+  int (*msync)(FAR struct mm_map_entry_s *entry,
+               FAR void *start,
+               size_t length,
+               int flags);
 };
 
 /* A structure for the task group */
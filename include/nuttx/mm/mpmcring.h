@@ -0,0 +1,168 @@
+/****************************************************************************
+ * include/nuttx/mm/mpmcring.h
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+#ifndef __INCLUDE_NUTTX_MM_MPMCRING_H
+#define __INCLUDE_NUTTX_MM_MPMCRING_H
+
+/* A lock-free ring of fixed size elements for any number of producers and
+ * consumers, in tasks or interrupt handlers.  Every element has a sequence
+ * number that tells whether it is free for the producer of a given
+ * position, or full for the consumer of that position.  Producers claim
+ * positions by advancing the head with compare-and-swap, and consumers by
+ * advancing the tail, so neither side waits for the other except for an
+ * element that is claimed but not yet committed.
+ */
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+#include <nuttx/compiler.h>
+#include <nuttx/mm/spscring.h>
+
+#include <stdint.h>
+#include <sys/types.h>
+
+/****************************************************************************
+ * Public Types
+ ****************************************************************************/
+
+struct mpmcring_s
+{
+  RING_ALIGNED size_t head;   /* Next position to enqueue */
+  RING_ALIGNED size_t tail;   /* Next position to dequeue */
+
+  /* Not changed after initialization */
+
+  RING_ALIGNED FAR size_t *seq; /* The sequence number of each element */
+  FAR uint8_t *base;            /* The element storage */
+  size_t    esize;              /* The size of one element */
+  size_t    mask;               /* The number of elements minus one */
+};
+
+/****************************************************************************
+ * Public Function Prototypes
+ ****************************************************************************/
+
+#undef EXTERN
+#if defined(__cplusplus)
+#define EXTERN extern "C"
+extern "C"
+{
+#else
+#define EXTERN extern
+#endif
+
+/****************************************************************************
+ * Name: mpmcring_init
+ *
+ * Description:
+ *   Initialize a ring, allocating its storage.
+ *
+ * Input Parameters:
+ *   ring  - Address of the ring to be used.
+ *   esize - The size of one element in bytes.
+ *   nelem - The number of elements, a power of two.
+ *
+ * Returned Value:
+ *   Zero on success; A negated errno value is returned on any failure.
+ *
+ ****************************************************************************/
+
+int mpmcring_init(FAR struct mpmcring_s *ring, size_t esize, size_t nelem);
+
+/****************************************************************************
+ * Name: mpmcring_uninit
+ *
+ * Description:
+ *   Free the storage of the ring.
+ *
+ ****************************************************************************/
+
+void mpmcring_uninit(FAR struct mpmcring_s *ring);
+
+/****************************************************************************
+ * Name: mpmcring_enqueue
+ *
+ * Description:
+ *   Copy up to nelem elements into the ring.  The elements are claimed
+ *   with a single compare-and-swap, so they are consecutive in the ring.
+ *
+ * Returned Value:
+ *   The number of elements enqueued, less than nelem if the ring is full.
+ *
+ ****************************************************************************/
+
+size_t mpmcring_enqueue(FAR struct mpmcring_s *ring,
+                        FAR const void *elems, size_t nelem);
+
+/****************************************************************************
+ * Name: mpmcring_dequeue
+ *
+ * Description:
+ *   Copy up to nelem elements out of the ring.
+ *
+ * Returned Value:
+ *   The number of elements dequeued, less than nelem if the ring is empty.
+ *
+ ****************************************************************************/
+
+size_t mpmcring_dequeue(FAR struct mpmcring_s *ring,
+                        FAR void *elems, size_t nelem);
+
+/****************************************************************************
+ * Name: mpmcring_enqueue_reserve and mpmcring_enqueue_commit
+ *
+ * Description:
+ *   Zero-copy enqueue of one element.  mpmcring_enqueue_reserve() claims a
+ *   free element, which the producer fills in place and then publishes
+ *   with mpmcring_enqueue_commit().  Consumers reaching the element wait
+ *   for the commit, so the element must be committed promptly.
+ *
+ * Returned Value:
+ *   The claimed element, or NULL if the ring is full.
+ *
+ ****************************************************************************/
+
+FAR void *mpmcring_enqueue_reserve(FAR struct mpmcring_s *ring);
+void mpmcring_enqueue_commit(FAR struct mpmcring_s *ring, FAR void *elem);
+
+/****************************************************************************
+ * Name: mpmcring_dequeue_reserve and mpmcring_dequeue_commit
+ *
+ * Description:
+ *   Zero-copy dequeue of one element.  mpmcring_dequeue_reserve() claims
+ *   the oldest element, which the consumer uses in place and then gives
+ *   back with mpmcring_dequeue_commit().
+ *
+ * Returned Value:
+ *   The claimed element, or NULL if the ring is empty.
+ *
+ ****************************************************************************/
+
+FAR void *mpmcring_dequeue_reserve(FAR struct mpmcring_s *ring);
+void mpmcring_dequeue_commit(FAR struct mpmcring_s *ring, FAR void *elem);
+
+#undef EXTERN
+#if defined(__cplusplus)
+}
+#endif
+#endif /* __INCLUDE_NUTTX_MM_MPMCRING_H */
@@ -0,0 +1,209 @@
+/****************************************************************************
+ * include/nuttx/mm/spscring.h
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+#ifndef __INCLUDE_NUTTX_MM_SPSCRING_H
+#define __INCLUDE_NUTTX_MM_SPSCRING_H
+
+/* A lock-free ring of fixed size elements for exactly one producer and one
+ * consumer, e.g. an interrupt handler and a task.  Neither side takes a
+ * lock or disables interrupts: the producer only writes the head, the
+ * consumer only writes the tail, and each publishes its index with release
+ * semantics after it is done with the elements.  If there may be several
+ * producers or several consumers, use the mpmcring instead.
+ */
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+#include <nuttx/compiler.h>
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <sys/types.h>
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+/* The indices of the two sides are kept in separate cache lines so that
+ * the producer and the consumer do not keep taking the line from each
+ * other.
+ */
+
+#if defined(CONFIG_MM_RING_ALIGN) && CONFIG_MM_RING_ALIGN > 0
+#  define RING_ALIGNED aligned_data(CONFIG_MM_RING_ALIGN)
+#else
+#  define RING_ALIGNED
+#endif
+
+/****************************************************************************
+ * Public Types
+ ****************************************************************************/
+
+struct spscring_s
+{
+  /* Written by the producer only */
+
+  RING_ALIGNED size_t head;   /* Number of elements ever enqueued */
+  size_t    tailcache;        /* Producer's last view of the tail */
+
+  /* Written by the consumer only */
+
+  RING_ALIGNED size_t tail;   /* Number of elements ever dequeued */
+  size_t    headcache;        /* Consumer's last view of the head */
+
+  /* Not changed after initialization */
+
+  RING_ALIGNED FAR uint8_t *base; /* The element storage */
+  size_t    esize;                /* The size of one element */
+  size_t    mask;                 /* The number of elements minus one */
+  bool      external;             /* The storage was provided by the caller */
+};
+
+/****************************************************************************
+ * Public Function Prototypes
+ ****************************************************************************/
+
+#undef EXTERN
+#if defined(__cplusplus)
+#define EXTERN extern "C"
+extern "C"
+{
+#else
+#define EXTERN extern
+#endif
+
+/****************************************************************************
+ * Name: spscring_init
+ *
+ * Description:
+ *   Initialize a ring.
+ *
+ * Input Parameters:
+ *   ring  - Address of the ring to be used.
+ *   base  - The storage of the ring, of at least esize * nelem bytes.  If
+ *           NULL, it is allocated.
+ *   esize - The size of one element in bytes.
+ *   nelem - The number of elements, a power of two.
+ *
+ * Returned Value:
+ *   Zero on success; A negated errno value is returned on any failure.
+ *
+ ****************************************************************************/
+
+int spscring_init(FAR struct spscring_s *ring, FAR void *base,
+                  size_t esize, size_t nelem);
+
+/****************************************************************************
+ * Name: spscring_uninit
+ *
+ * Description:
+ *   Free the storage of the ring if it was allocated by spscring_init().
+ *
+ ****************************************************************************/
+
+void spscring_uninit(FAR struct spscring_s *ring);
+
+/****************************************************************************
+ * Name: spscring_used and spscring_space
+ *
+ * Description:
+ *   Return the number of elements in the ring and the number of free
+ *   elements.  The values are only a snapshot unless called by the side
+ *   that could make them smaller.
+ *
+ ****************************************************************************/
+
+size_t spscring_used(FAR struct spscring_s *ring);
+size_t spscring_space(FAR struct spscring_s *ring);
+
+/****************************************************************************
+ * Name: spscring_enqueue
+ *
+ * Description:
+ *   Copy up to nelem elements into the ring.  Producer only.
+ *
+ * Returned Value:
+ *   The number of elements enqueued, less than nelem if the ring is full.
+ *
+ ****************************************************************************/
+
+size_t spscring_enqueue(FAR struct spscring_s *ring,
+                        FAR const void *elems, size_t nelem);
+
+/****************************************************************************
+ * Name: spscring_dequeue
+ *
+ * Description:
+ *   Copy up to nelem elements out of the ring.  Consumer only.
+ *
+ * Returned Value:
+ *   The number of elements dequeued, less than nelem if the ring is empty.
+ *
+ ****************************************************************************/
+
+size_t spscring_dequeue(FAR struct spscring_s *ring,
+                        FAR void *elems, size_t nelem);
+
+/****************************************************************************
+ * Name: spscring_enqueue_reserve and spscring_enqueue_commit
+ *
+ * Description:
+ *   Zero-copy enqueue.  spscring_enqueue_reserve() returns the first free
+ *   element and, in *nelem, the number of free elements that follow it
+ *   contiguously, at most the number passed in *nelem.  The producer fills
+ *   some of them in place and then publishes them with
+ *   spscring_enqueue_commit().  Producer only.
+ *
+ * Returned Value:
+ *   The first free element, or NULL if the ring is full.
+ *
+ ****************************************************************************/
+
+FAR void *spscring_enqueue_reserve(FAR struct spscring_s *ring,
+                                   FAR size_t *nelem);
+void spscring_enqueue_commit(FAR struct spscring_s *ring, size_t nelem);
+
+/****************************************************************************
+ * Name: spscring_dequeue_reserve and spscring_dequeue_commit
+ *
+ * Description:
+ *   Zero-copy dequeue.  spscring_dequeue_reserve() returns the oldest
+ *   element and, in *nelem, the number of elements that follow it
+ *   contiguously, at most the number passed in *nelem.  The consumer uses
+ *   some of them in place and then gives them back with
+ *   spscring_dequeue_commit().  Consumer only.
+ *
+ * Returned Value:
+ *   The oldest element, or NULL if the ring is empty.
+ *
+ ****************************************************************************/
+
+FAR void *spscring_dequeue_reserve(FAR struct spscring_s *ring,
+                                   FAR size_t *nelem);
+void spscring_dequeue_commit(FAR struct spscring_s *ring, size_t nelem);
+
+#undef EXTERN
+#if defined(__cplusplus)
+}
+#endif
+#endif /* __INCLUDE_NUTTX_MM_SPSCRING_H */
@@ -120,6 +120,16 @@ struct mqueue_inode_s
   pid_t ntpid;                /* Notification: Receiving Task's PID */
   struct sigevent ntevent;    /* Notification description */
   struct sigwork_s ntwork;    /* Notification work */
+#endif
+#ifdef CONFIG_MQ_QUEUE_POOL
+  struct list_node msgfree;   /* Free messages of the queue's own pool */
+  FAR char *pool;             /* The pool, allocated with the queue */
+  size_t poolsize;            /* Size of the pool in bytes */
+#endif
+#ifdef CONFIG_MQ_LOAN
+  struct list_node loans;     /* Messages out on loan */
+  int16_t nloans;             /* Number of messages out on loan */
+  bool orphan;                /* Freed when the last loan is given back */
 #endif
   FAR struct pollfd *fds[CONFIG_FS_MQUEUE_NPOLLWAITERS];
 };
@@ -383,7 +393,8 @@ ssize_t nxmq_timedreceive(mqd_t mqdes, FAR char *msg, size_t msglen,
  *   First, it deallocates all of the queued messages in the message
  *   queue.  It is assumed that this message queue is fully unlinked
  *   and closed so that no thread will attempt to access it while it
- *   is being deleted.
+ *   is being deleted.  A queue with messages out on loan is only marked
+ *   as an orphan, and freed when the last one is given back.
  *
  * Input Parameters:
  *   msgq - Named message queue to be freed
@@ -703,6 +714,73 @@ int file_mq_setattr(FAR struct file *mq, FAR const struct mq_attr *mq_stat,
 
 int file_mq_getattr(FAR struct file *mq, FAR struct mq_attr *mq_stat);
 
+/****************************************************************************
+ * Name: nxmq_loan, nxmq_send_loan, nxmq_receive_loan and nxmq_release_loan
+ *
+ * Description:
+ *   Zero-copy message passing.  nxmq_loan() lends the caller a free
+ *   message buffer of the queue, large enough for mq_msgsize bytes.  The
+ *   caller writes the message in place and passes the buffer to
+ *   nxmq_send_loan(), which queues it without copying it.  If the send
+ *   fails, the caller still owns the buffer.
+ *
+ *   nxmq_receive_loan() removes the next message from the queue like
+ *   nxmq_receive() but returns a pointer to the message buffer instead of
+ *   copying it out.  The caller reads it in place and gives it back with
+ *   nxmq_release_loan(), which may also be used to give back an unsent
+ *   buffer obtained from nxmq_loan().
+ *
+ *   Loaned buffers belong to the message queue: they must only be sent to,
+ *   and released through, a descriptor of the same queue.  A queue with
+ *   buffers out on loan is not freed when it is closed for the last time
+ *   and unlinked, so that the buffers stay valid.  Such buffers are given
+ *   back with nxmq_return_loan(), which needs no descriptor: the message
+ *   knows the queue that lent it.  The queue is freed with the last one.
+ *   nxmq_return_loan() cannot check the buffer as thoroughly as
+ *   nxmq_release_loan(), so use the latter while a descriptor is open.
+ *
+ *   The buffers are kernel memory, so these interfaces are only usable by
+ *   the OS and, in the FLAT build, by applications.
+ *
+ *   The file_mq_* variants take a struct file instead of a descriptor.
+ *   file_mq_loan(), file_mq_send_loan(), file_mq_release_loan() and
+ *   nxmq_return_loan() may be called from interrupt handlers.
+ *
+ * Returned Value:
+ *   This is an internal OS interface and should not be used by applications.
+ *   It follows the NuttX internal error return policy:  Zero (OK), or the
+ *   length of the message for nxmq_receive_loan(), is returned on success.
+ *   A negated errno value is returned on failure:
+ *
+ *   EBADF    The descriptor is not a message queue opened for writing
+ *            (loan and send) or reading (receive).
+ *   EINVAL   The buffer is not out on loan from this queue, or prio is
+ *            invalid.
+ *   EMSGSIZE 'msglen' is greater than the mq_msgsize of the queue.
+ *   ENOMEM   No message buffer is available.
+ *   EAGAIN   The queue is full (send) or empty (receive) and O_NONBLOCK is
+ *            set.
+ *   EINTR    The wait was interrupted by a signal.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_MQ_LOAN
+int file_mq_loan(FAR struct file *mq, FAR void **buffer);
+int file_mq_send_loan(FAR struct file *mq, FAR void *buffer, size_t msglen,
+                      unsigned int prio);
+ssize_t file_mq_receive_loan(FAR struct file *mq, FAR void **buffer,
+                             FAR unsigned int *prio);
+int file_mq_release_loan(FAR struct file *mq, FAR void *buffer);
+
+int nxmq_loan(mqd_t mqdes, FAR void **buffer);
+int nxmq_send_loan(mqd_t mqdes, FAR void *buffer, size_t msglen,
+                   unsigned int prio);
+ssize_t nxmq_receive_loan(mqd_t mqdes, FAR void **buffer,
+                          FAR unsigned int *prio);
+int nxmq_release_loan(mqd_t mqdes, FAR void *buffer);
+int nxmq_return_loan(FAR void *buffer);
+#endif
+
 #undef EXTERN
 #ifdef __cplusplus
 }
@@ -27,7 +27,9 @@
 
 #include <assert.h>
 #include <stdbool.h>
+#include <stdint.h>
 
+#include <nuttx/lockstat.h>
 #include <nuttx/semaphore.h>
 
 /****************************************************************************
@@ -47,6 +49,9 @@ struct mutex_s
 {
   sem_t sem;
   pid_t holder;
+#ifdef CONFIG_SCHED_LOCKSTAT
+  struct lockstat_s stat;
+#endif
 };
 
 typedef struct mutex_s mutex_t;
@@ -59,6 +64,16 @@ struct rmutex_s
 
 typedef struct rmutex_s rmutex_t;
 
+#ifdef CONFIG_MUTEX_SPIN
+/* Outcome of the contended nxmutex_lock() calls of a CPU */
+
+struct mutex_spin_s
+{
+  uint32_t nspin;                   /* Mutex taken by spinning */
+  uint32_t nblock;                  /* Thread blocked */
+};
+#endif
+
 /****************************************************************************
  * Public Function Prototypes
  ****************************************************************************/
@@ -73,6 +88,10 @@ extern "C"
 #define EXTERN extern
 #endif
 
+#ifdef CONFIG_MUTEX_SPIN
+EXTERN struct mutex_spin_s g_mutex_spin[CONFIG_SMP_NCPUS];
+#endif
+
 /****************************************************************************
  * Name: nxmutex_init
  *
@@ -513,6 +532,25 @@ int nxrmutex_breaklock(FAR rmutex_t *rmutex, FAR unsigned int *count);
 
 int nxrmutex_restorelock(FAR rmutex_t *rmutex, unsigned int count);
 
+/****************************************************************************
+ * Name: nxmutex_spin
+ *
+ * Description:
+ *   Spin while the mutex is locked by a thread running on another CPU, and
+ *   take it if it is released.  Called by nxmutex_lock() before it blocks.
+ *
+ * Parameters:
+ *   mutex - mutex descriptor.
+ *
+ * Return Value:
+ *   true if the mutex was taken, false if the caller has to block.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_MUTEX_SPIN
+bool nxmutex_spin(FAR mutex_t *mutex);
+#endif
+
 #undef EXTERN
 #ifdef __cplusplus
 }
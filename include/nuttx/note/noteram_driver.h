@@ -46,12 +46,20 @@
  * NOTERAM_SETMODE
  *              - Set overwrite mode
  *                Argument: A read-only pointer to unsigned int
+ * NOTERAM_GETREADMODE
+ *              - Get read mode of the open file
+ *                Argument: A writable pointer to unsigned int
+ * NOTERAM_SETREADMODE
+ *              - Set read mode of the open file
+ *                Argument: A read-only pointer to unsigned int
  */
 
 #ifdef CONFIG_DRIVERS_NOTERAM
 #define NOTERAM_CLEAR           _NOTERAMIOC(0x01)
 #define NOTERAM_GETMODE         _NOTERAMIOC(0x02)
 #define NOTERAM_SETMODE         _NOTERAMIOC(0x03)
+#define NOTERAM_GETREADMODE     _NOTERAMIOC(0x04)
+#define NOTERAM_SETREADMODE     _NOTERAMIOC(0x05)
 #endif
 
 /* Overwrite mode definitions */
@@ -62,6 +70,13 @@
 #define NOTERAM_MODE_OVERWRITE_OVERFLOW     2
 #endif
 
+/* Read mode definitions */
+
+#ifdef CONFIG_DRIVERS_NOTERAM
+#define NOTERAM_MODE_READ_ASCII             0
+#define NOTERAM_MODE_READ_BINARY            1
+#endif
+
 /****************************************************************************
  * Public Types
  ****************************************************************************/
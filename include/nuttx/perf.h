@@ -0,0 +1,164 @@
+/****************************************************************************
+ * include/nuttx/perf.h
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+#ifndef __INCLUDE_NUTTX_PERF_H
+#define __INCLUDE_NUTTX_PERF_H
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <sys/types.h>
+#include <stdbool.h>
+#include <stdint.h>
+
+#include <nuttx/fs/ioctl.h>
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+/* Event types */
+
+#define PERF_TYPE_HARDWARE                0
+
+/* Generic hardware events of PERF_TYPE_HARDWARE, mapped by the architecture
+ * to the events of its PMU.
+ */
+
+#define PERF_COUNT_HW_CPU_CYCLES          0
+#define PERF_COUNT_HW_INSTRUCTIONS        1
+#define PERF_COUNT_HW_CACHE_REFERENCES    2
+#define PERF_COUNT_HW_CACHE_MISSES        3
+#define PERF_COUNT_HW_BRANCH_INSTRUCTIONS 4
+#define PERF_COUNT_HW_BRANCH_MISSES       5
+#define PERF_COUNT_HW_MAX                 6
+
+/* IOCTL Commands ***********************************************************/
+
+/* Each open of /dev/perf may hold one counter.  read() returns its value
+ * as an uint64_t.
+ *
+ * PERFIOC_SETUP
+ *              - Attach a counter to the file
+ *                Argument: A pointer to a struct perf_event_attr_s
+ * PERFIOC_ENABLE
+ *              - Start counting
+ *                Argument: Ignored
+ * PERFIOC_DISABLE
+ *              - Stop counting, the value is kept
+ *                Argument: Ignored
+ * PERFIOC_RESET
+ *              - Set the value to zero
+ *                Argument: Ignored
+ */
+
+#define PERFIOC_SETUP                     _PERFIOC(0x01)
+#define PERFIOC_ENABLE                    _PERFIOC(0x02)
+#define PERFIOC_DISABLE                   _PERFIOC(0x03)
+#define PERFIOC_RESET                     _PERFIOC(0x04)
+
+/****************************************************************************
+ * Public Types
+ ****************************************************************************/
+
+/* Describes the counter to attach with PERFIOC_SETUP.  As with Linux
+ * perf_event_open(), pid 0 counts the calling thread, a positive pid
+ * counts that thread wherever it runs, and pid -1 counts everything that
+ * runs on 'cpu'.
+ */
+
+struct perf_event_attr_s
+{
+  uint32_t type;       /* PERF_TYPE_* */
+  uint64_t config;     /* PERF_COUNT_HW_* for PERF_TYPE_HARDWARE */
+  pid_t    pid;        /* Thread to count, see above */
+  int      cpu;        /* CPU to count when pid is -1 */
+  bool     disabled;   /* Wait for PERFIOC_ENABLE to start counting */
+};
+
+/****************************************************************************
+ * Public Function Prototypes
+ ****************************************************************************/
+
+#ifdef __cplusplus
+#define EXTERN extern "C"
+extern "C"
+{
+#else
+#define EXTERN extern
+#endif
+
+#ifdef CONFIG_PERF_EVENTS
+
+struct tcb_s; /* Forward reference */
+
+/****************************************************************************
+ * Name: perf_event_register
+ *
+ * Description:
+ *   Register /dev/perf
+ *
+ ****************************************************************************/
+
+void perf_event_register(void);
+
+/****************************************************************************
+ * Name: perf_event_suspend
+ *
+ * Description:
+ *   Called by the scheduler when 'tcb' stops running on this CPU.  Saves
+ *   the counters of the thread.
+ *
+ ****************************************************************************/
+
+void perf_event_suspend(FAR struct tcb_s *tcb);
+
+/****************************************************************************
+ * Name: perf_event_resume
+ *
+ * Description:
+ *   Called by the scheduler when 'tcb' starts running on this CPU.
+ *   Restarts the counters of the thread.
+ *
+ ****************************************************************************/
+
+void perf_event_resume(FAR struct tcb_s *tcb);
+
+/****************************************************************************
+ * Name: perf_event_release
+ *
+ * Description:
+ *   Called when 'tcb' is released.  Its counters keep their last value.
+ *
+ ****************************************************************************/
+
+void perf_event_release(FAR struct tcb_s *tcb);
+
+#endif /* CONFIG_PERF_EVENTS */
+
+#undef EXTERN
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __INCLUDE_NUTTX_PERF_H */
@@ -376,6 +376,61 @@ struct stackinfo_s
                                          /* from the stack.                  */
 };
 
+/* struct latency_hist_s ****************************************************/
+
+/* A log2 histogram of latencies.  count[n] is the number of latencies in
+ * the range [2^n, 2^(n+1)) nanoseconds, the last bucket collecting all
+ * larger values.
+ */
+
+#ifdef CONFIG_SCHED_LATENCYMONITOR
+#define LATENCY_NBUCKETS 32
+
+struct latency_hist_s
+{
+  uint32_t count[LATENCY_NBUCKETS];      /* Number of samples per bucket     */
+  uint64_t max;                          /* Largest sample in nanoseconds    */
+};
+#endif
+
+/* Scheduler statistics of a thread.  Times are in perf_gettime() units. */
+
+#ifdef CONFIG_SCHED_SCHEDSTAT
+struct schedstat_s
+{
+  clock_t  stamp;                        /* Time switched in, or preempted  */
+  clock_t  exec_time;                    /* Total time running              */
+  clock_t  wait_time;                    /* Total time ready-to-run         */
+  clock_t  wait_max;                     /* Max time ready-to-run           */
+  uint32_t nr_run;                       /* Number of times switched in     */
+  uint32_t nr_vcsw;                      /* Switched out to block           */
+  uint32_t nr_ivcsw;                     /* Switched out still ready-to-run */
+  uint32_t nr_preempt;                   /* Of nr_ivcsw, for a higher prio  */
+#ifdef CONFIG_SMP
+  uint32_t nr_migrate;                   /* Switched in on another CPU      */
+  uint8_t  cpu;                          /* CPU it last ran on              */
+#endif
+};
+#endif
+
+/* Statistics of a system call.  hist[n] counts the calls that took
+ * [2^n, 2^(n+1)) microseconds, the first bucket also counting the shorter
+ * calls and the last all the longer ones.  Times are in perf_gettime()
+ * units.
+ */
+
+#ifdef CONFIG_SCHED_SYSCALLSTAT
+#define SYSCALLSTAT_NBUCKETS 16
+
+struct syscallstat_s
+{
+  uint32_t count;                        /* Number of calls                 */
+  clock_t  time;                         /* Total time in the call          */
+  clock_t  max;                          /* Longest call                    */
+  uint32_t hist[SYSCALLSTAT_NBUCKETS];   /* Duration histogram              */
+};
+#endif
+
 /* struct task_group_s ******************************************************/
 
 /* All threads created by pthread_create belong in the same task group (along
@@ -636,6 +691,30 @@ struct tcb_s
   clock_t run_time;                /* Total time thread run           */
 #endif
 
+#ifdef CONFIG_SCHED_LATENCYMONITOR
+  clock_t wakeup_start;            /* Time when made ready-to-run     */
+
+  /* Latency from ready-to-run until running */
+
+  struct latency_hist_s wakeup_latency;
+#endif
+
+#ifdef CONFIG_SCHED_SCHEDSTAT
+  struct schedstat_s schedstat;    /* Run queue and switch accounting */
+#endif
+
+#ifdef CONFIG_SCHED_SYSCALLSTAT
+  uint32_t syscall_count;          /* Number of system calls made     */
+  clock_t  syscall_time;           /* Total time in system calls      */
+  clock_t  syscall_max;            /* Longest system call             */
+#endif
+
+  /* Hardware performance counters ******************************************/
+
+#ifdef CONFIG_PERF_EVENTS
+  sq_queue_t perf_events;                /* Events counting this thread     */
+#endif
+
   /* State save areas *******************************************************/
 
   /* The form and content of these fields are platform-specific.            */
@@ -767,6 +846,16 @@ EXTERN clock_t g_premp_max[CONFIG_SMP_NCPUS];
 EXTERN clock_t g_crit_max[CONFIG_SMP_NCPUS];
 #endif /* CONFIG_SCHED_CRITMONITOR */
 
+#ifdef CONFIG_SCHED_LATENCYMONITOR
+/* Latency histograms of interrupt handlers, of threads from ready-to-run
+ * until running, and of watchdog expirations.
+ */
+
+EXTERN struct latency_hist_s g_irq_latency[CONFIG_SMP_NCPUS];
+EXTERN struct latency_hist_s g_wakeup_latency[CONFIG_SMP_NCPUS];
+EXTERN struct latency_hist_s g_wdog_latency;
+#endif
+
 EXTERN const struct tcbinfo_s g_tcbinfo;
 
 /****************************************************************************
@@ -839,6 +928,58 @@ FAR struct tcb_s *nxsched_get_tcb(pid_t pid);
 
 int nxsched_release_tcb(FAR struct tcb_s *tcb, uint8_t ttype);
 
+/****************************************************************************
+ * Name: nxsched_latency_percentile
+ *
+ * Description:
+ *   Return an upper bound, in nanoseconds, of the latency below which
+ *   'permille' thousandths of the samples of a latency histogram fall.
+ *   Zero is returned if the histogram is empty.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_SCHED_LATENCYMONITOR
+uint64_t nxsched_latency_percentile(FAR const struct latency_hist_s *hist,
+                                    unsigned int permille);
+#endif
+
+#ifdef CONFIG_SCHED_SYSCALLSTAT
+
+/****************************************************************************
+ * Name: nxsched_syscall_stat
+ *
+ * Description:
+ *   Called by the system call wrappers when the system call 'nr', entered
+ *   at time 'start', returns.
+ *
+ ****************************************************************************/
+
+void nxsched_syscall_stat(int nr, clock_t start);
+
+/****************************************************************************
+ * Name: nxsched_syscall_snapshot
+ *
+ * Description:
+ *   Copy the statistics of the first 'nstats' system calls, indexed by
+ *   system call number less CONFIG_SYS_RESERVED, to 'stats', adding up the
+ *   statistics of the CPUs.
+ *
+ ****************************************************************************/
+
+void nxsched_syscall_snapshot(FAR struct syscallstat_s *stats, int nstats);
+
+/****************************************************************************
+ * Name: nxsched_syscall_reset
+ *
+ * Description:
+ *   Clear the statistics of all system calls.
+ *
+ ****************************************************************************/
+
+void nxsched_syscall_reset(void);
+
+#endif /* CONFIG_SCHED_SYSCALLSTAT */
+
 /* File system helpers ******************************************************/
 
 /* These functions all extract lists from the group structure associated with
@@ -34,6 +34,7 @@
 
 #include <nuttx/sched.h>
 #include <nuttx/spinlock.h>
+#include <nuttx/static_key.h>
 
 /* For system call numbers definition */
 
@@ -122,25 +123,59 @@
 #  define NOTE_FILTER_TAGMASK_ZERO(s)
 #endif
 
+/* With the instrumentation filter, the hot note hooks are guarded at their
+ * call sites by static keys that follow the filter mode, so that disabled
+ * instrumentation does not call into the note driver.
+ */
+
+#if defined(CONFIG_SCHED_INSTRUMENTATION_FILTER) && \
+    (defined(__KERNEL__) || defined(CONFIG_BUILD_FLAT))
+#  define SCHED_NOTE_HOOK(key, hook) \
+          do \
+            { \
+              if (static_branch_unlikely(&(key))) \
+                { \
+                  hook; \
+                } \
+            } \
+          while (0)
+#else
+#  define SCHED_NOTE_HOOK(key, hook) hook
+#endif
+
+#ifdef CONFIG_SCHED_INSTRUMENTATION_DUMP
+#  define SCHED_NOTE_DUMP_HOOK(hook) SCHED_NOTE_HOOK(g_note_dump_key, hook)
+#else
+#  define SCHED_NOTE_DUMP_HOOK(hook) hook
+#endif
+
 #define SCHED_NOTE_IP \
         ({ __label__ __here; __here: (unsigned long)&&__here; })
 
 #define sched_note_string(tag, buf) \
-        sched_note_string_ip(tag, SCHED_NOTE_IP, buf)
+        SCHED_NOTE_DUMP_HOOK( \
+          sched_note_string_ip(tag, SCHED_NOTE_IP, buf))
 #define sched_note_event(tag, event, buf, len) \
-        sched_note_event_ip(tag, SCHED_NOTE_IP, event, buf, len)
+        SCHED_NOTE_DUMP_HOOK( \
+          sched_note_event_ip(tag, SCHED_NOTE_IP, event, buf, len))
 #define sched_note_dump(tag, buf, len) \
-        sched_note_event_ip(tag, SCHED_NOTE_IP, NOTE_DUMP_BINARY, buf, len)
+        SCHED_NOTE_DUMP_HOOK( \
+          sched_note_event_ip(tag, SCHED_NOTE_IP, NOTE_DUMP_BINARY, buf, len))
 #define sched_note_vprintf(tag, fmt, va) \
-        sched_note_vprintf_ip(tag, SCHED_NOTE_IP, fmt, va)
+        SCHED_NOTE_DUMP_HOOK( \
+          sched_note_vprintf_ip(tag, SCHED_NOTE_IP, fmt, va))
 #define sched_note_vbprintf(tag, fmt, va) \
-        sched_note_vbprintf_ip(tag, SCHED_NOTE_IP, fmt, va)
+        SCHED_NOTE_DUMP_HOOK( \
+          sched_note_vbprintf_ip(tag, SCHED_NOTE_IP, fmt, va))
 #define sched_note_printf(tag, fmt, ...) \
-        sched_note_printf_ip(tag, SCHED_NOTE_IP, fmt, ##__VA_ARGS__)
+        SCHED_NOTE_DUMP_HOOK( \
+          sched_note_printf_ip(tag, SCHED_NOTE_IP, fmt, ##__VA_ARGS__))
 #define sched_note_bprintf(tag, fmt, ...) \
-        sched_note_bprintf_ip(tag, SCHED_NOTE_IP, fmt, ##__VA_ARGS__)
+        SCHED_NOTE_DUMP_HOOK( \
+          sched_note_bprintf_ip(tag, SCHED_NOTE_IP, fmt, ##__VA_ARGS__))
 #define sched_note_counter(tag, name, value) \
-        sched_note_counter_ip(tag, SCHED_NOTE_IP, name, value)
+        SCHED_NOTE_DUMP_HOOK( \
+          sched_note_counter_ip(tag, SCHED_NOTE_IP, name, value))
 
 #define sched_note_begin(tag) \
         sched_note_event(tag, NOTE_DUMP_BEGIN, NULL, 0)
@@ -438,7 +473,7 @@ struct note_filter_tag_s
 };
 
 /****************************************************************************
- * Public Function Prototypes
+ * Public Data
  ****************************************************************************/
 
 #undef EXTERN
@@ -450,6 +485,31 @@ extern "C"
 #define EXTERN extern
 #endif
 
+#ifdef CONFIG_SCHED_INSTRUMENTATION_FILTER
+/* Static keys of the note hooks, maintained by sched_note_filter_mode().
+ * A key is enabled whenever the instrumentation it guards may record
+ * anything.  The hooks themselves still apply the complete filter.
+ */
+
+EXTERN struct static_key_s g_note_key;          /* Instrumentation */
+#ifdef CONFIG_SCHED_INSTRUMENTATION_SWITCH
+EXTERN struct static_key_s g_note_switch_key;   /* Context switches */
+#endif
+#ifdef CONFIG_SCHED_INSTRUMENTATION_SYSCALL
+EXTERN struct static_key_s g_note_syscall_key;  /* System calls */
+#endif
+#ifdef CONFIG_SCHED_INSTRUMENTATION_IRQHANDLER
+EXTERN struct static_key_s g_note_irq_key;      /* Interrupt handlers */
+#endif
+#ifdef CONFIG_SCHED_INSTRUMENTATION_DUMP
+EXTERN struct static_key_s g_note_dump_key;     /* Dump notes */
+#endif
+#endif
+
+/****************************************************************************
+ * Public Function Prototypes
+ ****************************************************************************/
+
 /****************************************************************************
  * Name: sched_note_*
  *
@@ -477,6 +537,12 @@ void sched_note_stop(FAR struct tcb_s *tcb);
 #ifdef CONFIG_SCHED_INSTRUMENTATION_SWITCH
 void sched_note_suspend(FAR struct tcb_s *tcb);
 void sched_note_resume(FAR struct tcb_s *tcb);
+#  ifdef CONFIG_SCHED_INSTRUMENTATION_FILTER
+#    define sched_note_suspend(t) \
+            SCHED_NOTE_HOOK(g_note_switch_key, sched_note_suspend(t))
+#    define sched_note_resume(t) \
+            SCHED_NOTE_HOOK(g_note_switch_key, sched_note_resume(t))
+#  endif
 #else
 #  define sched_note_suspend(t)
 #  define sched_note_resume(t)
@@ -504,12 +570,20 @@ void sched_note_cpu_resumed(FAR struct tcb_s *tcb);
 
 #ifdef CONFIG_SCHED_INSTRUMENTATION_PREEMPTION
 void sched_note_premption(FAR struct tcb_s *tcb, bool locked);
+#  ifdef CONFIG_SCHED_INSTRUMENTATION_FILTER
+#    define sched_note_premption(t,l) \
+            SCHED_NOTE_HOOK(g_note_key, sched_note_premption(t, l))
+#  endif
 #else
 #  define sched_note_premption(t,l)
 #endif
 
 #ifdef CONFIG_SCHED_INSTRUMENTATION_CSECTION
 void sched_note_csection(FAR struct tcb_s *tcb, bool enter);
+#  ifdef CONFIG_SCHED_INSTRUMENTATION_FILTER
+#    define sched_note_csection(t,e) \
+            SCHED_NOTE_HOOK(g_note_key, sched_note_csection(t, e))
+#  endif
 #else
 #  define sched_note_csection(t,e)
 #endif
@@ -518,6 +592,11 @@ void sched_note_csection(FAR struct tcb_s *tcb, bool enter);
 void sched_note_spinlock(FAR struct tcb_s *tcb,
                          FAR volatile spinlock_t *spinlock,
                          int type);
+#  ifdef CONFIG_SCHED_INSTRUMENTATION_FILTER
+#    define sched_note_spinlock(tcb, spinlock, type) \
+            SCHED_NOTE_HOOK(g_note_key, \
+                            sched_note_spinlock(tcb, spinlock, type))
+#  endif
 #else
 #  define sched_note_spinlock(tcb, spinlock, type)
 #endif
@@ -525,6 +604,14 @@ void sched_note_spinlock(FAR struct tcb_s *tcb,
 #ifdef CONFIG_SCHED_INSTRUMENTATION_SYSCALL
 void sched_note_syscall_enter(int nr, int argc, ...);
 void sched_note_syscall_leave(int nr, uintptr_t result);
+#  ifdef CONFIG_SCHED_INSTRUMENTATION_FILTER
+#    define sched_note_syscall_enter(n,a,...) \
+            SCHED_NOTE_HOOK(g_note_syscall_key, \
+                            sched_note_syscall_enter(n, a, ##__VA_ARGS__))
+#    define sched_note_syscall_leave(n,r) \
+            SCHED_NOTE_HOOK(g_note_syscall_key, \
+                            sched_note_syscall_leave(n, r))
+#  endif
 #else
 #  define sched_note_syscall_enter(n,a,...)
 #  define sched_note_syscall_leave(n,r)
@@ -532,6 +619,10 @@ void sched_note_syscall_leave(int nr, uintptr_t result);
 
 #ifdef CONFIG_SCHED_INSTRUMENTATION_IRQHANDLER
 void sched_note_irqhandler(int irq, FAR void *handler, bool enter);
+#  ifdef CONFIG_SCHED_INSTRUMENTATION_FILTER
+#    define sched_note_irqhandler(i,h,e) \
+            SCHED_NOTE_HOOK(g_note_irq_key, sched_note_irqhandler(i, h, e))
+#  endif
 #else
 #  define sched_note_irqhandler(i,h,e)
 #endif
@@ -28,7 +28,13 @@
 #include <nuttx/config.h>
 
 #include <errno.h>
+#include <limits.h>
 #include <semaphore.h>
+#include <stdbool.h>
+
+#ifndef __cplusplus
+#  include <stdatomic.h>
+#endif
 
 #include <nuttx/clock.h>
 
@@ -57,6 +63,42 @@
      {(c), (f), SEM_WAITLIST_INITIALIZER}
 #endif /* CONFIG_PRIORITY_INHERITANCE */
 
+/* The fast paths take and give back uncontended counts with an atomic
+ * compare-and-swap on the count, in user space as well.  They need a
+ * native 16-bit compare-and-swap, so the architecture opts in with
+ * ARCH_HAVE_SEM_FASTPATH.
+ */
+
+#if defined(CONFIG_SEM_FASTPATH) && !defined(__cplusplus)
+#  define NXSEM_FASTPATH 1
+#endif
+
+/* Accessors of the semaphore count.  Once a semaphore is in use its count
+ * must only be changed through them.  With the fast paths the count is
+ * changed atomically, because the fast paths change it without entering
+ * a critical section; otherwise it is only changed within the critical
+ * section, as a plain integer.  nxsem_count_cmpxchg() never fails then,
+ * since the count cannot change under the critical section.
+ */
+
+#ifdef NXSEM_FASTPATH
+#  define NXSEM_COUNT(s)               ((FAR atomic_short *)&(s)->semcount)
+#  define nxsem_count_get(s)           atomic_load(NXSEM_COUNT(s))
+#  define nxsem_count_set(s, c)        atomic_store(NXSEM_COUNT(s), (c))
+#  define nxsem_count_inc(s)           atomic_fetch_add(NXSEM_COUNT(s), 1)
+#  define nxsem_count_dec(s)           atomic_fetch_sub(NXSEM_COUNT(s), 1)
+#  define nxsem_count_cmpxchg(s, o, n) \
+     atomic_compare_exchange_weak(NXSEM_COUNT(s), (o), (n))
+#else
+#  define nxsem_count_get(s)           ((s)->semcount)
+#  define nxsem_count_set(s, c)        ((s)->semcount = (c))
+#  define nxsem_count_inc(s)           ((s)->semcount++)
+#  define nxsem_count_dec(s)           ((s)->semcount--)
+#  define nxsem_count_cmpxchg(s, o, n) ((s)->semcount = (n), true)
+#  define nxsem_trywait_fast(s)        false
+#  define nxsem_post_fast(s)           false
+#endif
+
 /****************************************************************************
  * Public Type Definitions
  ****************************************************************************/
@@ -679,6 +721,88 @@ int nxsem_clockwait_uninterruptible(FAR sem_t *sem, clockid_t clockid,
 
 int nxsem_tickwait_uninterruptible(FAR sem_t *sem, uint32_t delay);
 
+/****************************************************************************
+ * Inline Functions
+ ****************************************************************************/
+
+#ifdef NXSEM_FASTPATH
+
+/****************************************************************************
+ * Name: nxsem_trywait_fast
+ *
+ * Description:
+ *   Take a count from the semaphore with a single atomic operation, without
+ *   entering the kernel or a critical section.  This only succeeds if a
+ *   count is available and the semaphore does not track its holders for
+ *   priority inheritance.  Otherwise the caller falls back to nxsem_wait()
+ *   or nxsem_trywait(), which also handle the contended case.
+ *
+ * Returned Value:
+ *   true if a count was taken.
+ *
+ ****************************************************************************/
+
+static inline bool nxsem_trywait_fast(FAR sem_t *sem)
+{
+  short count;
+
+  if ((sem->flags & SEM_PRIO_MASK) != SEM_PRIO_NONE)
+    {
+      return false;
+    }
+
+  count = atomic_load(NXSEM_COUNT(sem));
+  while (count > 0)
+    {
+      if (atomic_compare_exchange_weak(NXSEM_COUNT(sem), &count,
+                                       count - 1))
+        {
+          return true;
+        }
+    }
+
+  return false;
+}
+
+/****************************************************************************
+ * Name: nxsem_post_fast
+ *
+ * Description:
+ *   Give a count back to the semaphore with a single atomic operation,
+ *   without entering the kernel or a critical section.  This only succeeds
+ *   if no thread waits for the semaphore and it does not track its holders
+ *   for priority inheritance.  Otherwise the caller falls back to
+ *   nxsem_post(), which wakes up the waiter.
+ *
+ * Returned Value:
+ *   true if the count was given back.
+ *
+ ****************************************************************************/
+
+static inline bool nxsem_post_fast(FAR sem_t *sem)
+{
+  short count;
+
+  if ((sem->flags & SEM_PRIO_MASK) != SEM_PRIO_NONE)
+    {
+      return false;
+    }
+
+  count = atomic_load(NXSEM_COUNT(sem));
+  while (count >= 0 && count < SEM_VALUE_MAX)
+    {
+      if (atomic_compare_exchange_weak(NXSEM_COUNT(sem), &count,
+                                       count + 1))
+        {
+          return true;
+        }
+    }
+
+  return false;
+}
+
+#endif /* NXSEM_FASTPATH */
+
 #undef EXTERN
 #ifdef __cplusplus
 }
@@ -0,0 +1,225 @@
+/****************************************************************************
+ * include/nuttx/seqlock.h
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+#ifndef __INCLUDE_NUTTX_SEQLOCK_H
+#define __INCLUDE_NUTTX_SEQLOCK_H
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <stdbool.h>
+
+#include <nuttx/irq.h>
+#include <nuttx/spinlock.h>
+
+#ifndef __cplusplus
+#  include <stdatomic.h>
+#endif
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+#define SEQCOUNT_INITIALIZER    {0}
+#define SEQLOCK_INITIALIZER     {SEQCOUNT_INITIALIZER, SP_UNLOCKED}
+
+#define seqcount_init(s)        do { (s)->sequence = 0; } while (0)
+#define seqlock_init(l) \
+  do \
+    { \
+      seqcount_init(&(l)->seqcount); \
+      spin_lock_init(&(l)->lock); \
+    } \
+  while (0)
+
+/****************************************************************************
+ * Public Types
+ ****************************************************************************/
+
+/* A sequence count protects data that is read far more often than it is
+ * written.  Readers take no lock: they read the data and retry if a writer
+ * changed it meanwhile.  The count is odd while an update is in progress.
+ *
+ *   do
+ *     {
+ *       seq = read_seqbegin(&g_lock);
+ *       ... copy the data ...
+ *     }
+ *   while (read_seqretry(&g_lock, seq));
+ *
+ * The writers of a bare seqcount_t must already exclude each other, and
+ * must not be preempted or interrupted by a reader of the same CPU while
+ * the update is in progress, or that reader would spin forever.  A
+ * seqlock_t adds a spinlock that does both.
+ */
+
+struct seqcount_s
+{
+  unsigned int sequence;
+};
+
+typedef struct seqcount_s seqcount_t;
+
+struct seqlock_s
+{
+  seqcount_t seqcount;
+  spinlock_t lock;
+};
+
+typedef struct seqlock_s seqlock_t;
+
+/****************************************************************************
+ * Inline Functions
+ ****************************************************************************/
+
+#ifndef __cplusplus
+
+/****************************************************************************
+ * Name: read_seqcount_begin
+ *
+ * Description:
+ *   Start a read section, waiting for an update in progress to complete.
+ *
+ * Returned Value:
+ *   The sequence to pass to read_seqcount_retry().
+ *
+ ****************************************************************************/
+
+static inline unsigned int read_seqcount_begin(FAR seqcount_t *s)
+{
+  unsigned int seq;
+
+  while (((seq = atomic_load_explicit((FAR atomic_uint *)&s->sequence,
+                                      memory_order_acquire)) & 1) != 0)
+    {
+      SP_DSB();
+    }
+
+  return seq;
+}
+
+/****************************************************************************
+ * Name: read_seqcount_retry
+ *
+ * Description:
+ *   End a read section.
+ *
+ * Returned Value:
+ *   true if the data was updated since read_seqcount_begin() returned
+ *   'seq', and the read section must be done again.
+ *
+ ****************************************************************************/
+
+static inline bool read_seqcount_retry(FAR seqcount_t *s, unsigned int seq)
+{
+  atomic_thread_fence(memory_order_acquire);
+  return atomic_load_explicit((FAR atomic_uint *)&s->sequence,
+                              memory_order_relaxed) != seq;
+}
+
+/****************************************************************************
+ * Name: write_seqcount_begin
+ *
+ * Description:
+ *   Start an update.  The caller excludes the other writers.
+ *
+ ****************************************************************************/
+
+static inline void write_seqcount_begin(FAR seqcount_t *s)
+{
+  atomic_store_explicit((FAR atomic_uint *)&s->sequence, s->sequence + 1,
+                        memory_order_relaxed);
+  atomic_thread_fence(memory_order_release);
+}
+
+/****************************************************************************
+ * Name: write_seqcount_end
+ *
+ * Description:
+ *   Complete an update started with write_seqcount_begin().
+ *
+ ****************************************************************************/
+
+static inline void write_seqcount_end(FAR seqcount_t *s)
+{
+  atomic_thread_fence(memory_order_release);
+  atomic_store_explicit((FAR atomic_uint *)&s->sequence, s->sequence + 1,
+                        memory_order_relaxed);
+}
+
+/****************************************************************************
+ * Name: read_seqbegin and read_seqretry
+ *
+ * Description:
+ *   Start and end a read section of a seqlock_t.  See
+ *   read_seqcount_begin() and read_seqcount_retry().
+ *
+ ****************************************************************************/
+
+static inline unsigned int read_seqbegin(FAR seqlock_t *lock)
+{
+  return read_seqcount_begin(&lock->seqcount);
+}
+
+static inline bool read_seqretry(FAR seqlock_t *lock, unsigned int seq)
+{
+  return read_seqcount_retry(&lock->seqcount, seq);
+}
+
+/****************************************************************************
+ * Name: write_seqlock_irqsave
+ *
+ * Description:
+ *   Disable local interrupts, take the spinlock of a seqlock_t and start an
+ *   update.  Readers do not wait for the spinlock, only for the update.
+ *
+ * Returned Value:
+ *   The interrupt state to pass to write_sequnlock_irqrestore().
+ *
+ ****************************************************************************/
+
+static inline irqstate_t write_seqlock_irqsave(FAR seqlock_t *lock)
+{
+  irqstate_t flags = spin_lock_irqsave(&lock->lock);
+
+  write_seqcount_begin(&lock->seqcount);
+  return flags;
+}
+
+/****************************************************************************
+ * Name: write_sequnlock_irqrestore
+ *
+ * Description:
+ *   Complete an update, release the spinlock and restore the interrupts.
+ *
+ ****************************************************************************/
+
+static inline void write_sequnlock_irqrestore(FAR seqlock_t *lock,
+                                              irqstate_t flags)
+{
+  write_seqcount_end(&lock->seqcount);
+  spin_unlock_irqrestore(&lock->lock, flags);
+}
+
+#endif /* __cplusplus */
+#endif /* __INCLUDE_NUTTX_SEQLOCK_H */
@@ -41,12 +41,15 @@ extern "C"
 #define EXTERN extern
 #endif
 
-#if defined(CONFIG_RW_SPINLOCK)
+/* Reader-writer spinlocks.  Without SMP, read_lock_irqsave() and
+ * write_lock_irqsave() only disable interrupts, so that rwlock_t may be
+ * used by code that also builds for single CPU configurations.
+ */
+
 typedef int rwlock_t;
-#  define RW_SP_UNLOCKED      0
-#  define RW_SP_READ_LOCKED   1
-#  define RW_SP_WRITE_LOCKED -1
-#endif
+#define RW_SP_UNLOCKED      0
+#define RW_SP_READ_LOCKED   1
+#define RW_SP_WRITE_LOCKED -1
 
 #ifndef CONFIG_SPINLOCK
 #  define SP_UNLOCKED 0  /* The Un-locked state */
@@ -69,6 +72,27 @@ typedef union spinlock_u spinlock_t;
 #  define SP_UNLOCKED (union spinlock_u){{0, 0}}
 #  define SP_LOCKED (union spinlock_u){{0, 1}}
 
+#elif defined(CONFIG_MCS_SPINLOCK)
+
+/* Only the first CPU waiting for a MCS spinlock polls the lock, the CPUs
+ * queued behind it poll their own queue node.
+ */
+
+union spinlock_u
+{
+  struct
+  {
+    unsigned char locked;    /* Non-zero while the lock is held */
+    unsigned char reserved;
+    unsigned short tail;     /* 1 + CPU of the last waiter, 0 if none */
+  } mcs;
+  unsigned int value;
+};
+typedef union spinlock_u spinlock_t;
+
+#  define SP_UNLOCKED (union spinlock_u){{0, 0, 0}}
+#  define SP_LOCKED (union spinlock_u){{1, 0, 0}}
+
 #else
 
 /* The architecture specific spinlock.h header file must also provide the
@@ -115,7 +139,9 @@ typedef union spinlock_u spinlock_t;
 #endif
 
 #if !defined(__SP_UNLOCK_FUNCTION) && (defined(CONFIG_TICKET_SPINLOCK) || \
-     defined(CONFIG_SCHED_INSTRUMENTATION_SPINLOCKS))
+     defined(CONFIG_MCS_SPINLOCK) || \
+     defined(CONFIG_SCHED_INSTRUMENTATION_SPINLOCKS) || \
+     defined(CONFIG_SCHED_LOCKSTAT))
 #  define __SP_UNLOCK_FUNCTION 1
 #endif
 
@@ -338,8 +364,10 @@ void spin_unlock_wo_note(FAR volatile spinlock_t *lock);
  ****************************************************************************/
 
 /* bool spin_islocked(FAR spinlock_t lock); */
-#ifdef CONFIG_TICKET_SPINLOCK
+#if defined(CONFIG_TICKET_SPINLOCK)
 #  define spin_is_locked(l) ((*l).tickets.owner != (*l).tickets.next)
+#elif defined(CONFIG_MCS_SPINLOCK)
+#  define spin_is_locked(l) ((*l).mcs.locked != 0)
 #else
 #  define spin_is_locked(l) (*(l) == SP_LOCKED)
 #endif
@@ -504,8 +532,6 @@ void spin_unlock_irqrestore_wo_note(FAR spinlock_t *lock, irqstate_t flags);
 #  define spin_unlock_irqrestore_wo_note(l, f) up_irq_restore(f)
 #endif
 
-#if defined(CONFIG_RW_SPINLOCK)
-
 /****************************************************************************
  * Name: rwlock_init
  *
@@ -524,6 +550,8 @@ void spin_unlock_irqrestore_wo_note(FAR spinlock_t *lock, irqstate_t flags);
 
 #define rwlock_init(l) do { *(l) = RW_SP_UNLOCKED; } while(0)
 
+#if defined(CONFIG_RW_SPINLOCK)
+
 /****************************************************************************
  * Name: read_lock
  *
@@ -668,6 +696,8 @@ bool write_trylock(FAR volatile rwlock_t *lock);
 
 void write_unlock(FAR volatile rwlock_t *lock);
 
+#endif /* CONFIG_RW_SPINLOCK */
+
 /****************************************************************************
  * Name: read_lock_irqsave
  *
@@ -812,8 +842,6 @@ void write_unlock_irqrestore(FAR rwlock_t *lock, irqstate_t flags);
 #  define write_unlock_irqrestore(l, f) up_irq_restore(f)
 #endif
 
-#endif /* CONFIG_RW_SPINLOCK */
-
 #undef EXTERN
 #if defined(__cplusplus)
 }
@@ -0,0 +1,101 @@
+/****************************************************************************
+ * include/nuttx/static_key.h
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+#ifndef __INCLUDE_NUTTX_STATIC_KEY_H
+#define __INCLUDE_NUTTX_STATIC_KEY_H
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+#include <nuttx/compiler.h>
+
+#include <stdbool.h>
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+/* A static key guards code that is rarely enabled, typically
+ * instrumentation, at its call site:
+ *
+ *   if (static_branch_unlikely(&g_key))
+ *     {
+ *       expensive_hook();
+ *     }
+ *
+ * The test is a single load and a branch that the compiler lays out as
+ * not taken, so that a disabled hook costs neither a function call nor
+ * the evaluation of its arguments.
+ */
+
+#define STATIC_KEY_INIT_FALSE         { false }
+#define STATIC_KEY_INIT_TRUE          { true }
+
+#define static_branch_likely(key)     predict_true(static_key_enabled(key))
+#define static_branch_unlikely(key)   predict_false(static_key_enabled(key))
+
+/****************************************************************************
+ * Public Types
+ ****************************************************************************/
+
+struct static_key_s
+{
+  volatile bool enabled;
+};
+
+/****************************************************************************
+ * Inline Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: static_key_enabled
+ *
+ * Description:
+ *   Return true if the key is enabled.
+ *
+ ****************************************************************************/
+
+static always_inline_function bool
+static_key_enabled(FAR const struct static_key_s *key)
+{
+  return key->enabled;
+}
+
+/****************************************************************************
+ * Name: static_key_set
+ *
+ * Description:
+ *   Enable or disable the key.  Serializing updates of the same key is up
+ *   to the caller.
+ *
+ ****************************************************************************/
+
+static inline void static_key_set(FAR struct static_key_s *key,
+                                  bool enable)
+{
+  key->enabled = enable;
+}
+
+#define static_key_enable(key)        static_key_set(key, true)
+#define static_key_disable(key)       static_key_set(key, false)
+
+#endif /* __INCLUDE_NUTTX_STATIC_KEY_H */
@@ -42,6 +42,8 @@
 #include <nuttx/config.h>
 #include <nuttx/syslog/syslog.h>
 
+#include <stdarg.h>
+
 #ifdef CONFIG_RAMLOG
 
 /****************************************************************************
@@ -149,6 +151,32 @@ ssize_t ramlog_write(FAR struct syslog_channel_s *channel,
                      FAR const char *buffer, size_t buflen);
 #endif
 
+/****************************************************************************
+ * Name: ramlog_vsyslog
+ *
+ * Description:
+ *   Record a syslog message in the RAMLOG without formatting it.  The
+ *   message is formatted when the RAMLOG is read.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_RAMLOG_DEFERRED
+int ramlog_vsyslog(int priority, FAR const IPTR char *fmt, va_list ap);
+#endif
+
+/****************************************************************************
+ * Name: ramlog_flush
+ *
+ * Description:
+ *   Format all the messages recorded by ramlog_vsyslog() that have not been
+ *   read yet.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_RAMLOG_DEFERRED
+int ramlog_flush(FAR struct syslog_channel_s *channel);
+#endif
+
 #undef EXTERN
 #ifdef __cplusplus
 }
@@ -39,116 +39,217 @@
 #  define trace_end(tag)
 #endif
 
+/* Tracepoints with a typed payload.  A subsystem declares a tracepoint in
+ * one of its headers with the TRACEPOINT macro of the subsystem, for
+ * example:
+ *
+ *   NET_TRACEPOINT(net_rx, "dev=%p len=%u",
+ *                  TP_PROTO(FAR struct net_driver_s *dev, unsigned int len),
+ *                  TP_ARGS(dev, len))
+ *
+ * and calls trace_net_rx(dev, len) where the event occurs.  The arguments
+ * are recorded in binary form by sched_note_bprintf() and only formatted
+ * when the notes are read.  Like the begin/end hooks below, a tracepoint
+ * is compiled in only if the trace option of its subsystem is enabled
+ * (CONFIG_TRACE_NET for NET_TRACEPOINT); otherwise trace_net_rx() is an
+ * empty inline function.  With the instrumentation filter, a tracepoint
+ * whose dump notes are disabled costs the test of a static key.
+ */
+
+#define TP_PROTO(...) __VA_ARGS__
+#define TP_ARGS(...)  __VA_ARGS__
+
+#define TRACEPOINT_DEFINE(name, tag, fmt, proto, args) \
+  static inline void trace_##name(proto) \
+  { \
+    sched_note_bprintf(tag, fmt, args); \
+  }
+
+#define TRACEPOINT_NONE(name, proto) \
+  static inline void trace_##name(proto) \
+  { \
+  }
+
 #ifdef CONFIG_TRACE_APP
 #  define app_trace_begin() trace_begin(NOTE_TAG_APP)
 #  define app_trace_end() trace_end(NOTE_TAG_APP)
+#  define APP_TRACEPOINT(name, fmt, proto, args) \
+     TRACEPOINT_DEFINE(name, NOTE_TAG_APP, fmt, \
+                       TP_PROTO(proto), TP_ARGS(args))
 #else
 #  define app_trace_begin()
 #  define app_trace_end()
+#  define APP_TRACEPOINT(name, fmt, proto, args) \
+     TRACEPOINT_NONE(name, TP_PROTO(proto))
 #endif
 
 #ifdef CONFIG_TRACE_ARCH
 #  define arch_trace_begin() trace_begin(NOTE_TAG_ARCH)
 #  define arch_trace_end() trace_end(NOTE_TAG_ARCH)
+#  define ARCH_TRACEPOINT(name, fmt, proto, args) \
+     TRACEPOINT_DEFINE(name, NOTE_TAG_ARCH, fmt, \
+                       TP_PROTO(proto), TP_ARGS(args))
 #else
 #  define arch_trace_begin()
 #  define arch_trace_end()
+#  define ARCH_TRACEPOINT(name, fmt, proto, args) \
+     TRACEPOINT_NONE(name, TP_PROTO(proto))
 #endif
 
 #ifdef CONFIG_TRACE_AUDIO
 #  define audio_trace_begin() trace_begin(NOTE_TAG_AUDIO)
 #  define audio_trace_end() trace_end(NOTE_TAG_AUDIO)
+#  define AUDIO_TRACEPOINT(name, fmt, proto, args) \
+     TRACEPOINT_DEFINE(name, NOTE_TAG_AUDIO, fmt, \
+                       TP_PROTO(proto), TP_ARGS(args))
 #else
 #  define audio_trace_begin()
 #  define audio_trace_end()
+#  define AUDIO_TRACEPOINT(name, fmt, proto, args) \
+     TRACEPOINT_NONE(name, TP_PROTO(proto))
 #endif
 
 #ifdef CONFIG_TRACE_BOARDS
 #  define boards_trace_begin() trace_begin(NOTE_TAG_BOARDS)
 #  define boards_trace_end() trace_end(NOTE_TAG_BOARDS)
+#  define BOARDS_TRACEPOINT(name, fmt, proto, args) \
+     TRACEPOINT_DEFINE(name, NOTE_TAG_BOARDS, fmt, \
+                       TP_PROTO(proto), TP_ARGS(args))
 #else
 #  define boards_trace_begin()
 #  define boards_trace_end()
+#  define BOARDS_TRACEPOINT(name, fmt, proto, args) \
+     TRACEPOINT_NONE(name, TP_PROTO(proto))
 #endif
 
 #ifdef CONFIG_TRACE_CRYPTO
 #  define crypto_trace_begin() trace_begin(NOTE_TAG_CRYPTO)
 #  define crypto_trace_end() trace_end(NOTE_TAG_CRYPTO)
+#  define CRYPTO_TRACEPOINT(name, fmt, proto, args) \
+     TRACEPOINT_DEFINE(name, NOTE_TAG_CRYPTO, fmt, \
+                       TP_PROTO(proto), TP_ARGS(args))
 #else
 #  define crypto_trace_begin()
 #  define crypto_trace_end()
+#  define CRYPTO_TRACEPOINT(name, fmt, proto, args) \
+     TRACEPOINT_NONE(name, TP_PROTO(proto))
 #endif
 
 #ifdef CONFIG_TRACE_DRIVERS
 #  define drivers_trace_begin() trace_begin(NOTE_TAG_DRIVERS)
 #  define drivers_trace_end() trace_end(NOTE_TAG_DRIVERS)
+#  define DRIVERS_TRACEPOINT(name, fmt, proto, args) \
+     TRACEPOINT_DEFINE(name, NOTE_TAG_DRIVERS, fmt, \
+                       TP_PROTO(proto), TP_ARGS(args))
 #else
 #  define drivers_trace_begin()
 #  define drivers_trace_end()
+#  define DRIVERS_TRACEPOINT(name, fmt, proto, args) \
+     TRACEPOINT_NONE(name, TP_PROTO(proto))
 #endif
 
 #ifdef CONFIG_TRACE_FS
 #  define fs_trace_begin() trace_begin(NOTE_TAG_FS)
 #  define fs_trace_end() trace_end(NOTE_TAG_FS)
+#  define FS_TRACEPOINT(name, fmt, proto, args) \
+     TRACEPOINT_DEFINE(name, NOTE_TAG_FS, fmt, \
+                       TP_PROTO(proto), TP_ARGS(args))
 #else
 #  define fs_trace_begin()
 #  define fs_trace_end()
+#  define FS_TRACEPOINT(name, fmt, proto, args) \
+     TRACEPOINT_NONE(name, TP_PROTO(proto))
 #endif
 
 #ifdef CONFIG_TRACE_GRAPHICS
 #  define graphics_trace_begin() trace_begin(NOTE_TAG_GRAPHICS)
 #  define graphics_trace_end() trace_end(NOTE_TAG_GRAPHICS)
+#  define GRAPHICS_TRACEPOINT(name, fmt, proto, args) \
+     TRACEPOINT_DEFINE(name, NOTE_TAG_GRAPHICS, fmt, \
+                       TP_PROTO(proto), TP_ARGS(args))
 #else
 #  define graphics_trace_begin()
 #  define graphics_trace_end()
+#  define GRAPHICS_TRACEPOINT(name, fmt, proto, args) \
+     TRACEPOINT_NONE(name, TP_PROTO(proto))
 #endif
 
 #ifdef CONFIG_TRACE_LIBS
 #  define libs_trace_begin() trace_begin(NOTE_TAG_LIBS)
 #  define libs_trace_end() trace_end(NOTE_TAG_LIBS)
+#  define LIBS_TRACEPOINT(name, fmt, proto, args) \
+     TRACEPOINT_DEFINE(name, NOTE_TAG_LIBS, fmt, \
+                       TP_PROTO(proto), TP_ARGS(args))
 #else
 #  define libs_trace_begin()
 #  define libs_trace_end()
+#  define LIBS_TRACEPOINT(name, fmt, proto, args) \
+     TRACEPOINT_NONE(name, TP_PROTO(proto))
 #endif
 
 #ifdef CONFIG_TRACE_MM
 #  define mm_trace_begin() trace_begin(NOTE_TAG_MM)
 #  define mm_trace_end() trace_end(NOTE_TAG_MM)
+#  define MM_TRACEPOINT(name, fmt, proto, args) \
+     TRACEPOINT_DEFINE(name, NOTE_TAG_MM, fmt, \
+                       TP_PROTO(proto), TP_ARGS(args))
 #else
 #  define mm_trace_begin()
 #  define mm_trace_end()
+#  define MM_TRACEPOINT(name, fmt, proto, args) \
+     TRACEPOINT_NONE(name, TP_PROTO(proto))
 #endif
 
 #ifdef CONFIG_TRACE_NET
 #  define net_trace_begin() trace_begin(NOTE_TAG_NET)
 #  define net_trace_end() trace_end(NOTE_TAG_NET)
+#  define NET_TRACEPOINT(name, fmt, proto, args) \
+     TRACEPOINT_DEFINE(name, NOTE_TAG_NET, fmt, \
+                       TP_PROTO(proto), TP_ARGS(args))
 #else
 #  define net_trace_begin()
 #  define net_trace_end()
+#  define NET_TRACEPOINT(name, fmt, proto, args) \
+     TRACEPOINT_NONE(name, TP_PROTO(proto))
 #endif
 
 #ifdef CONFIG_TRACE_SCHED
 #  define sched_trace_begin() trace_begin(NOTE_TAG_SCHED)
 #  define sched_trace_end() trace_end(NOTE_TAG_SCHED)
+#  define SCHED_TRACEPOINT(name, fmt, proto, args) \
+     TRACEPOINT_DEFINE(name, NOTE_TAG_SCHED, fmt, \
+                       TP_PROTO(proto), TP_ARGS(args))
 #else
 #  define sched_trace_begin()
 #  define sched_trace_end()
+#  define SCHED_TRACEPOINT(name, fmt, proto, args) \
+     TRACEPOINT_NONE(name, TP_PROTO(proto))
 #endif
 
 #ifdef CONFIG_TRACE_VIDEO
 #  define video_trace_begin() trace_begin(NOTE_TAG_VIDEO)
 #  define video_trace_end() trace_end(NOTE_TAG_VIDEO)
+#  define VIDEO_TRACEPOINT(name, fmt, proto, args) \
+     TRACEPOINT_DEFINE(name, NOTE_TAG_VIDEO, fmt, \
+                       TP_PROTO(proto), TP_ARGS(args))
 #else
 #  define video_trace_begin()
 #  define video_trace_end()
+#  define VIDEO_TRACEPOINT(name, fmt, proto, args) \
+     TRACEPOINT_NONE(name, TP_PROTO(proto))
 #endif
 
 #ifdef CONFIG_TRACE_WIRELESS
 #  define wireless_trace_begin() trace_begin(NOTE_TAG_WIRLESS)
 #  define wireless_trace_end() trace_end(NOTE_TAG_WIRLESS)
+#  define WIRELESS_TRACEPOINT(name, fmt, proto, args) \
+     TRACEPOINT_DEFINE(name, NOTE_TAG_WIRLESS, fmt, \
+                       TP_PROTO(proto), TP_ARGS(args))
 #else
 #  define wireless_trace_begin()
 #  define wireless_trace_end()
+#  define WIRELESS_TRACEPOINT(name, fmt, proto, args) \
+     TRACEPOINT_NONE(name, TP_PROTO(proto))
 #endif
 
 #endif /* __INCLUDE_NUTTX_TRACE_H */
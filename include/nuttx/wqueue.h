@@ -99,6 +99,7 @@
 
 #  undef CONFIG_SCHED_HPWORK
 #  undef CONFIG_SCHED_LPWORK
+#  undef CONFIG_SCHED_CPUWORK
 #  undef CONFIG_SCHED_WORKQUEUE
 
   /* User-space worker threads are not built in a kernel build when we are
@@ -175,6 +176,20 @@
 
 #endif /* CONFIG_SCHED_LPWORK */
 
+/* Per-CPU kernel work queue configuration **********************************/
+
+#ifdef CONFIG_SCHED_CPUWORK
+
+#  ifndef CONFIG_SCHED_CPUWORKPRIORITY
+#    define CONFIG_SCHED_CPUWORKPRIORITY 100
+#  endif
+
+#  ifndef CONFIG_SCHED_CPUWORKSTACKSIZE
+#    define CONFIG_SCHED_CPUWORKSTACKSIZE CONFIG_IDLETHREAD_STACKSIZE
+#  endif
+
+#endif /* CONFIG_SCHED_CPUWORK */
+
 /* User space work queue configuration **************************************/
 
 #ifdef CONFIG_LIBC_USRWORK
@@ -199,6 +214,11 @@
  *     used for any purpose.  if CONFIG_SCHED_LPWORK is not defined, then
  *     there is only one kernel work queue and LPWORK == HPWORK.
  *
+ *   CPUWORK: This is the ID of the per-CPU work queues, if
+ *     CONFIG_SCHED_CPUWORK is defined.  Work queued with it runs on the
+ *     worker thread of the CPU that queued it, unless it is stolen by the
+ *     worker thread of an idle CPU.
+ *
  * User Work Queue:
  *   USRWORK:  In the kernel phase a a kernel build, there should be no
  *     references to user-space work queues.  That would be an error.
@@ -212,6 +232,7 @@
 #  define USRWORK  2          /* User mode work queue */
 #  define HPWORK   USRWORK    /* Redirect kernel-mode references */
 #  define LPWORK   USRWORK
+#  define CPUWORK  USRWORK
 
 #else
 /* Kernel mode */
@@ -222,6 +243,9 @@
 #  else
 #    define LPWORK HPWORK     /* Redirect low-priority references */
 #  endif
+#  ifdef CONFIG_SCHED_CPUWORK
+#    define CPUWORK (LPWORK+1) /* Per-CPU, kernel-mode work queues */
+#  endif
 #  define USRWORK  LPWORK     /* Redirect user-mode references */
 
 #endif /* CONFIG_LIBC_USRWORK && !__KERNEL__ */
@@ -254,6 +278,12 @@ struct work_s
   } u;
   worker_t  worker;         /* Work callback */
   FAR void *arg;            /* Callback argument */
+#ifdef CONFIG_SCHED_WORKQUEUE_STATS
+  clock_t   stamp;          /* perf_gettime() when the work was queued */
+#endif
+#ifdef CONFIG_SCHED_CPUWORK
+  uint8_t   cpu;            /* CPU whose CPUWORK queue holds the work */
+#endif
 };
 
 /* This is an enumeration of the various events that may be
@@ -294,6 +324,26 @@ struct work_notifier_s
 
 typedef CODE void (*work_foreach_t)(int tid, FAR void *arg);
 
+/* Statistics of one kernel work queue, see work_getstat().  Times are
+ * perf_gettime() intervals; the wait is the time from work_queue(), or
+ * from the expiry of the delay, until a worker thread takes the work.
+ */
+
+#ifdef CONFIG_SCHED_WORKQUEUE_STATS
+struct work_stat_s
+{
+  uint32_t nqueued;         /* Work queued */
+  uint32_t nrun;            /* Work performed */
+  uint32_t npending;        /* Work queued and not yet taken */
+  uint32_t maxpending;      /* Largest npending */
+  uint64_t wait_time;       /* Total time waited */
+  clock_t  wait_max;        /* Longest time waited */
+  uint64_t run_time;        /* Total time spent in the workers */
+  clock_t  run_max;         /* Longest time spent in a worker */
+  uint32_t nstolen;         /* Work taken from the queue of another CPU */
+};
+#endif
+
 /****************************************************************************
  * Public Data
  ****************************************************************************/
@@ -425,6 +475,27 @@ int work_cancel_sync(int qid, FAR struct work_s *work);
 
 void work_foreach(int qid, work_foreach_t handler, FAR void *arg);
 
+/****************************************************************************
+ * Name: work_getstat and work_resetstat
+ *
+ * Description:
+ *   Get a snapshot of, or clear, the statistics of a kernel work queue.
+ *
+ * Input Parameters:
+ *   qid  - The work queue ID (HPWORK, LPWORK or CPUWORK, whose statistics
+ *          are those of all the CPUs)
+ *   stat - Location to return the statistics
+ *
+ * Returned Value:
+ *   Zero (OK) on success, -EINVAL if there is no such work queue.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_SCHED_WORKQUEUE_STATS
+int work_getstat(int qid, FAR struct work_stat_s *stat);
+int work_resetstat(int qid);
+#endif
+
 /****************************************************************************
  * Name: work_available
  *
@@ -63,28 +63,33 @@ struct semholder_s
 {
 #if CONFIG_SEM_PREALLOCHOLDERS > 0
   FAR struct semholder_s *flink;  /* List of semaphore's holder            */
+  FAR struct semholder_s *blink;  /* Previous holder of the semaphore      */
 #endif
   FAR struct semholder_s *tlink;  /* List of task held semaphores          */
+  FAR struct semholder_s *tblink; /* Previous semaphore held by the task   */
   FAR struct sem_s *sem;          /* Ths corresponding semaphore           */
   FAR struct tcb_s *htcb;         /* Ths corresponding TCB                 */
   int16_t counts;                 /* Number of counts owned by this holder */
 };
 
 #if CONFIG_SEM_PREALLOCHOLDERS > 0
-#  define SEMHOLDER_INITIALIZER   {NULL, NULL, NULL, NULL, 0}
+#  define SEMHOLDER_INITIALIZER   {NULL, NULL, NULL, NULL, NULL, NULL, 0}
 #  define INITIALIZE_SEMHOLDER(h) \
     do { \
       (h)->flink  = NULL; \
+      (h)->blink  = NULL; \
       (h)->tlink  = NULL; \
+      (h)->tblink = NULL; \
       (h)->sem    = NULL; \
       (h)->htcb   = NULL; \
       (h)->counts = 0; \
     } while (0)
 #else
-#  define SEMHOLDER_INITIALIZER   {NULL, NULL, NULL, 0}
+#  define SEMHOLDER_INITIALIZER   {NULL, NULL, NULL, NULL, 0}
 #  define INITIALIZE_SEMHOLDER(h) \
     do { \
       (h)->tlink  = NULL; \
+      (h)->tblink = NULL; \
       (h)->sem    = NULL; \
       (h)->htcb   = NULL; \
       (h)->counts = 0; \
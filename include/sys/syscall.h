@@ -34,7 +34,12 @@
 
 #include <arch/syscall.h>
 
-#ifdef CONFIG_LIB_SYSCALL
+/* The system call numbers are also needed by the kernel when the system
+ * calls are instrumented, even if the system call library is not built.
+ */
+
+#if defined(CONFIG_LIB_SYSCALL) || \
+    defined(CONFIG_SCHED_INSTRUMENTATION_SYSCALL)
 
 /****************************************************************************
  * Pre-processor Definitions
@@ -105,5 +110,5 @@ EXTERN const char *g_funcnames[SYS_nsyscalls];
 #endif
 
 #endif /* __ASSEMBLY__ */
-#endif /* CONFIG_LIB_SYSCALL */
+#endif /* CONFIG_LIB_SYSCALL || CONFIG_SCHED_INSTRUMENTATION_SYSCALL */
 #endif /* __INCLUDE_SYS_SYSCALL_H */
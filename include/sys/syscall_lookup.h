@@ -198,6 +198,7 @@ SYSCALL_LOOKUP(pwrite,                     4)
   SYSCALL_LOOKUP(aio_write,                1)
   SYSCALL_LOOKUP(aio_fsync,                2)
   SYSCALL_LOOKUP(aio_cancel,               2)
+  SYSCALL_LOOKUP(nx_lio_submit,            3)
 #endif
   SYSCALL_LOOKUP(poll,                     3)
   SYSCALL_LOOKUP(select,                   5)
@@ -249,6 +250,7 @@ SYSCALL_LOOKUP(utimens,                    2)
 SYSCALL_LOOKUP(lutimens,                   2)
 SYSCALL_LOOKUP(futimens,                   2)
 SYSCALL_LOOKUP(munmap,                     2)
+SYSCALL_LOOKUP(msync,                      3)
 
 #if defined(CONFIG_PSEUDOFS_SOFTLINKS)
   SYSCALL_LOOKUP(link,                     2)
@@ -31,6 +31,7 @@
 #include <debug.h>
 #include <errno.h>
 
+#include <nuttx/fs/fs.h>
 #include <nuttx/signal.h>
 #include <nuttx/sched.h>
 
@@ -511,7 +512,6 @@ int lio_listio(int mode, FAR struct aiocb * const list[], int nent,
 {
   FAR struct aiocb *aiocbp = NULL;
   int nqueued;
-  int errcode;
   int retcode;
   int status;
   int ret;
@@ -525,8 +525,7 @@ int lio_listio(int mode, FAR struct aiocb * const list[], int nent,
 
   DEBUGASSERT(list);
 
-  nqueued = 0;    /* No I/O operations yet queued */
-  ret     = OK;   /* Assume success */
+  ret = OK;       /* Assume success */
 
   /* Lock the scheduler so that no I/O events can complete on the worker
    * thread until we set our wait set up.  Pre-emption will, of course, be
@@ -535,77 +534,26 @@ int lio_listio(int mode, FAR struct aiocb * const list[], int nent,
 
   sched_lock();
 
-  /* Submit each asynchronous I/O operation in the list, skipping over NULL
-   * entries.
+  /* Submit all of the asynchronous I/O operations in the list with a
+   * single system call.
    */
 
-  for (i = 0; i < nent; i++)
+  if (nx_lio_submit(list, nent, &nqueued) < 0)
     {
-      /* Skip over NULL entries */
+      ret = ERROR;
+    }
 
-      aiocbp = list[i];
-      if (aiocbp)
-        {
-          /* Submit the operation according to its opcode */
+  /* The last entry of the list carries the notification if no I/O was
+   * queued.
+   */
 
-          status = OK;
-          switch (aiocbp->aio_lio_opcode)
-            {
-            case LIO_NOP:
-              {
-                /* Mark the do-nothing operation complete */
-
-                aiocbp->aio_result = OK;
-              }
-              break;
-
-            case LIO_READ:
-            case LIO_WRITE:
-              {
-                if (aiocbp->aio_lio_opcode == LIO_READ)
-                  {
-                    /* Submit the asynchronous read operation */
-
-                    status = aio_read(aiocbp);
-                  }
-                else
-                  {
-                    /* Submit the asynchronous write operation */
-
-                    status = aio_write(aiocbp);
-                  }
-
-                if (status < 0)
-                  {
-                    /* Failed to queue the I/O.  Set up the error return. */
-
-                    errcode = get_errno();
-                    ferr("ERROR: aio_read/write failed: %d\n", errcode);
-                    DEBUGASSERT(errcode > 0);
-                    aiocbp->aio_result = -errcode;
-                    ret = ERROR;
-                  }
-                else
-                  {
-                    /* Increment the count of successfully queue operations */
-
-                    nqueued++;
-                  }
-              }
-              break;
-
-            default:
-              {
-                /* Make the invalid operation complete with an error */
-
-                ferr("ERROR: Unrecognized opcode: %d\n",
-                     aiocbp->aio_lio_opcode);
-                aiocbp->aio_result = -EINVAL;
-                ret = ERROR;
-              }
-              break;
-            }
-        }
+  for (i = nent - 1; i > 0 && list[i] == NULL; i--)
+    {
+    }
+
+  if (nent > 0)
+    {
+      aiocbp = list[i];
     }
 
   /* If there was any failure in queuing the I/O, EIO will be returned */
@@ -26,6 +26,8 @@
 
 #include <nuttx/sched.h>
 #include <nuttx/clock.h>
+#include <nuttx/compiler.h>
+#include <nuttx/lockstat.h>
 #include <nuttx/mutex.h>
 #include <nuttx/semaphore.h>
 
@@ -35,6 +37,20 @@
 
 #define NXMUTEX_RESET          ((pid_t)-2)
 
+/* Lock statistics are collected by the kernel */
+
+#if defined(CONFIG_SCHED_LOCKSTAT) && \
+    (defined(CONFIG_BUILD_FLAT) || defined(__KERNEL__))
+#  define NXMUTEX_LOCKSTAT 1
+#endif
+
+/* Adaptive spinning looks at the owner, which only the kernel can do */
+
+#if !defined(CONFIG_MUTEX_SPIN) || \
+    (!defined(CONFIG_BUILD_FLAT) && !defined(__KERNEL__))
+#  define nxmutex_spin(m) false
+#endif
+
 /****************************************************************************
  * Private Functions
  ****************************************************************************/
@@ -94,6 +110,9 @@ int nxmutex_init(FAR mutex_t *mutex)
   nxsem_set_protocol(&mutex->sem, SEM_TYPE_MUTEX | SEM_PRIO_INHERIT);
 #else
   nxsem_set_protocol(&mutex->sem, SEM_TYPE_MUTEX);
+#endif
+#ifdef NXMUTEX_LOCKSTAT
+  lockstat_init(&mutex->stat, return_address(0));
 #endif
   return ret;
 }
@@ -194,17 +213,28 @@ bool nxmutex_is_locked(FAR mutex_t *mutex)
 
 int nxmutex_lock(FAR mutex_t *mutex)
 {
+#ifdef NXMUTEX_LOCKSTAT
+  clock_t start = perf_gettime();
+  bool contended = nxmutex_is_locked(mutex);
+#endif
   int ret;
 
   DEBUGASSERT(!nxmutex_is_hold(mutex));
   for (; ; )
     {
-      /* Take the semaphore (perhaps waiting) */
+      /* Take the semaphore (perhaps waiting).  An unlocked mutex is taken
+       * without a system call, a mutex held by a thread running on another
+       * CPU may be taken by spinning.
+       */
 
-      ret = nxsem_wait(&mutex->sem);
+      ret = nxsem_trywait_fast(&mutex->sem) || nxmutex_spin(mutex) ? OK :
+            nxsem_wait(&mutex->sem);
       if (ret >= 0)
         {
           mutex->holder = _SCHED_GETTID();
+#ifdef NXMUTEX_LOCKSTAT
+          lockstat_acquired(&mutex->stat, mutex, start, contended);
+#endif
           break;
         }
       else if (ret != -EINTR && ret != -ECANCELED)
@@ -242,13 +272,17 @@ int nxmutex_trylock(FAR mutex_t *mutex)
   int ret;
 
   DEBUGASSERT(!nxmutex_is_hold(mutex));
-  ret = nxsem_trywait(&mutex->sem);
+  ret = nxsem_trywait_fast(&mutex->sem) ? OK :
+        nxsem_trywait(&mutex->sem);
   if (ret < 0)
     {
       return ret;
     }
 
   mutex->holder = _SCHED_GETTID();
+#ifdef NXMUTEX_LOCKSTAT
+  lockstat_acquired(&mutex->stat, mutex, perf_gettime(), false);
+#endif
   return ret;
 }
 
@@ -278,26 +312,42 @@ int nxmutex_trylock(FAR mutex_t *mutex)
 
 int nxmutex_timedlock(FAR mutex_t *mutex, unsigned int timeout)
 {
+#ifdef NXMUTEX_LOCKSTAT
+  clock_t start = perf_gettime();
+  bool contended = nxmutex_is_locked(mutex);
+#endif
   int ret;
   struct timespec now;
   struct timespec delay;
   struct timespec rqtp;
 
-  clock_gettime(CLOCK_MONOTONIC, &now);
-  clock_ticks2time(MSEC2TICK(timeout), &delay);
-  clock_timespec_add(&now, &delay, &rqtp);
-
-  /* Wait until we get the lock or until the timeout expires */
+  /* An unlocked mutex is taken without a system call */
 
-  do
+  if (nxsem_trywait_fast(&mutex->sem) || nxmutex_spin(mutex))
     {
-      ret = nxsem_clockwait(&mutex->sem, CLOCK_MONOTONIC, &rqtp);
+      ret = OK;
+    }
+  else
+    {
+      clock_gettime(CLOCK_MONOTONIC, &now);
+      clock_ticks2time(MSEC2TICK(timeout), &delay);
+      clock_timespec_add(&now, &delay, &rqtp);
+
+      /* Wait until we get the lock or until the timeout expires */
+
+      do
+        {
+          ret = nxsem_clockwait(&mutex->sem, CLOCK_MONOTONIC, &rqtp);
+        }
+      while (ret == -EINTR || ret == -ECANCELED);
     }
-  while (ret == -EINTR || ret == -ECANCELED);
 
   if (ret >= 0)
     {
       mutex->holder = _SCHED_GETTID();
+#ifdef NXMUTEX_LOCKSTAT
+      lockstat_acquired(&mutex->stat, mutex, start, contended);
+#endif
     }
 
   return ret;
@@ -334,9 +384,14 @@ int nxmutex_unlock(FAR mutex_t *mutex)
 
   DEBUGASSERT(nxmutex_is_hold(mutex));
 
+#ifdef NXMUTEX_LOCKSTAT
+  lockstat_released(&mutex->stat, mutex);
+#endif
   mutex->holder = NXMUTEX_NO_HOLDER;
 
-  ret = nxsem_post(&mutex->sem);
+  /* Without waiters the mutex is released without a system call */
+
+  ret = nxsem_post_fast(&mutex->sem) ? OK : nxsem_post(&mutex->sem);
   if (ret < 0)
     {
       mutex->holder = _SCHED_GETTID();
@@ -444,8 +499,20 @@ int nxmutex_restorelock(FAR mutex_t *mutex, bool locked)
 
 int nxrmutex_init(FAR rmutex_t *rmutex)
 {
+  int ret;
+
   rmutex->count = 0;
-  return nxmutex_init(&rmutex->mutex);
+  ret = nxmutex_init(&rmutex->mutex);
+#ifdef NXMUTEX_LOCKSTAT
+  if (ret >= 0)
+    {
+      /* Group the mutex by the caller of nxrmutex_init() */
+
+      lockstat_init(&rmutex->mutex.stat, return_address(0));
+    }
+#endif
+
+  return ret;
 }
 
 /****************************************************************************
@@ -73,7 +73,9 @@ int sem_post(FAR sem_t *sem)
       return ERROR;
     }
 
-  ret = nxsem_post(sem);
+  /* Give back an uncontended count without a system call */
+
+  ret = nxsem_post_fast(sem) ? OK : nxsem_post(sem);
   if (ret < 0)
     {
       set_errno(-ret);
@@ -63,9 +63,11 @@ int sem_trywait(FAR sem_t *sem)
       return ERROR;
     }
 
-  /* Let nxsem_trywait do the real work */
+  /* Take an uncontended count without a system call, or let
+   * nxsem_trywait do the real work.
+   */
 
-  ret = nxsem_trywait(sem);
+  ret = nxsem_trywait_fast(sem) ? OK : nxsem_trywait(sem);
   if (ret < 0)
     {
       set_errno(-ret);
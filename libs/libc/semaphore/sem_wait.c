@@ -79,9 +79,11 @@ int sem_wait(FAR sem_t *sem)
 #endif
     }
 
-  /* Let nxsem_wait() do the real work */
+  /* Take an uncontended count without a system call, or let nxsem_wait()
+   * do the real work.
+   */
 
-  ret = nxsem_wait(sem);
+  ret = nxsem_trywait_fast(sem) ? OK : nxsem_wait(sem);
   if (ret < 0)
     {
       errcode = -ret;
@@ -0,0 +1,76 @@
+/****************************************************************************
+ * libs/libc/unistd/lib_posix_fadvise.c
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <fcntl.h>
+#include <errno.h>
+#include <unistd.h>
+
+#include <sys/ioctl.h>
+
+#ifndef CONFIG_DISABLE_MOUNTPOINT
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: posix_fadvise
+ *
+ * Description:
+ *  The posix_fadvise() function shall advise the implementation on the
+ *  expected behavior of the application with respect to the data in the
+ *  file associated with the open file descriptor, fd, starting at offset
+ *  and continuing for len bytes. The specified range need not currently
+ *  exist in the file. If len is zero, all data following offset is
+ *  specified. The implementation may use this information to optimize
+ *  handling of the specified data. The posix_fadvise() function shall have
+ *  no effect on the semantics of other operations on the specified data,
+ *  although it may affect the performance of other operations.
+ *
+ *  NuttX applies the advice to the whole open file description: offset
+ *  and len are only validated.
+ *
+ * Returned Value:
+ *   Upon successful completion, posix_fadvise() shall return zero;
+ *   otherwise, an error number shall be returned to indicate the error.
+ *
+ ****************************************************************************/
+
+int posix_fadvise(int fd, off_t offset, off_t len, int advice)
+{
+  if (offset < 0 || len < 0 ||
+      advice < POSIX_FADV_NORMAL || advice > POSIX_FADV_NOREUSE)
+    {
+      return EINVAL;
+    }
+
+  if (ioctl(fd, FIOC_FADVISE, advice) < 0)
+    {
+      return get_errno();
+    }
+
+  return 0;
+}
+
+#endif /* !CONFIG_DISABLE_MOUNTPOINT */
@@ -0,0 +1,354 @@
+/****************************************************************************
+ * mm/circbuf/mpmcring.c
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <stdatomic.h>
+#include <string.h>
+#include <assert.h>
+#include <errno.h>
+
+#include <nuttx/kmalloc.h>
+#include <nuttx/mm/mpmcring.h>
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+/* The sequence number of the element at position 'pos' is:
+ *
+ *   pos        when it is free for the producer of 'pos',
+ *   pos + 1    when it is full for the consumer of 'pos'.
+ *
+ * The consumer then sets it to pos + nelem, i.e. free for the producer of
+ * the next round.  The sequence numbers are published with release
+ * semantics once the element is written or read.
+ */
+
+#define MPMCRING_FREE   0
+#define MPMCRING_FULL   1
+
+#define mpmcring_seq(ring, pos) \
+  atomic_load_explicit((FAR atomic_size_t *)&(ring)->seq[(pos) & \
+                       (ring)->mask], memory_order_acquire)
+#define mpmcring_setseq(ring, pos, v) \
+  atomic_store_explicit((FAR atomic_size_t *)&(ring)->seq[(pos) & \
+                        (ring)->mask], (v), memory_order_release)
+
+#define mpmcring_elem(ring, pos) \
+  ((ring)->base + ((pos) & (ring)->mask) * (ring)->esize)
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: mpmcring_claim
+ *
+ * Description:
+ *   Claim up to nelem consecutive positions from 'index' (the head for
+ *   producers, the tail for consumers) whose elements are in the 'state'
+ *   (MPMCRING_FREE or MPMCRING_FULL) expected by the claimer.
+ *
+ * Returned Value:
+ *   The number of positions claimed, the first of which is returned in
+ *   *ppos.  Zero if the ring is full (producers) or empty (consumers).
+ *
+ ****************************************************************************/
+
+static size_t mpmcring_claim(FAR struct mpmcring_s *ring,
+                             FAR size_t *index, size_t state,
+                             size_t nelem, FAR size_t *ppos)
+{
+  size_t pos = atomic_load_explicit((FAR atomic_size_t *)index,
+                                    memory_order_relaxed);
+
+  for (; ; )
+    {
+      size_t seq = mpmcring_seq(ring, pos);
+      size_t n;
+
+      if (seq != pos + state)
+        {
+          /* A sequence behind the position means the ring is full or
+           * empty.  Ahead of it, another claimer took the position since
+           * we read the index.
+           */
+
+          if ((ssize_t)(seq - (pos + state)) < 0)
+            {
+              return 0;
+            }
+
+          pos = atomic_load_explicit((FAR atomic_size_t *)index,
+                                     memory_order_relaxed);
+          continue;
+        }
+
+      /* Count the following elements that are ready too */
+
+      for (n = 1; n < nelem && n <= ring->mask; n++)
+        {
+          if (mpmcring_seq(ring, pos + n) != pos + n + state)
+            {
+              break;
+            }
+        }
+
+      /* Claim them all at once; on failure, pos is reloaded */
+
+      if (atomic_compare_exchange_weak_explicit((FAR atomic_size_t *)index,
+                                                &pos, pos + n,
+                                                memory_order_relaxed,
+                                                memory_order_relaxed))
+        {
+          *ppos = pos;
+          return n;
+        }
+    }
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: mpmcring_init
+ *
+ * Description:
+ *   Initialize a ring, allocating its storage.
+ *
+ * Input Parameters:
+ *   ring  - Address of the ring to be used.
+ *   esize - The size of one element in bytes.
+ *   nelem - The number of elements, a power of two.
+ *
+ * Returned Value:
+ *   Zero on success; A negated errno value is returned on any failure.
+ *
+ ****************************************************************************/
+
+int mpmcring_init(FAR struct mpmcring_s *ring, size_t esize, size_t nelem)
+{
+  size_t i;
+
+  DEBUGASSERT(ring);
+
+  if (esize == 0 || nelem == 0 || (nelem & (nelem - 1)) != 0)
+    {
+      return -EINVAL;
+    }
+
+  /* The sequence numbers and the elements share one allocation */
+
+  ring->seq = kmm_malloc(nelem * (sizeof(size_t) + esize));
+  if (ring->seq == NULL)
+    {
+      return -ENOMEM;
+    }
+
+  for (i = 0; i < nelem; i++)
+    {
+      ring->seq[i] = i;
+    }
+
+  ring->base  = (FAR uint8_t *)&ring->seq[nelem];
+  ring->esize = esize;
+  ring->mask  = nelem - 1;
+  ring->head  = 0;
+  ring->tail  = 0;
+
+  return 0;
+}
+
+/****************************************************************************
+ * Name: mpmcring_uninit
+ *
+ * Description:
+ *   Free the storage of the ring.
+ *
+ ****************************************************************************/
+
+void mpmcring_uninit(FAR struct mpmcring_s *ring)
+{
+  DEBUGASSERT(ring);
+
+  kmm_free(ring->seq);
+  ring->seq  = NULL;
+  ring->base = NULL;
+}
+
+/****************************************************************************
+ * Name: mpmcring_enqueue
+ *
+ * Description:
+ *   Copy up to nelem elements into the ring.
+ *
+ * Returned Value:
+ *   The number of elements enqueued, less than nelem if the ring is full.
+ *
+ ****************************************************************************/
+
+size_t mpmcring_enqueue(FAR struct mpmcring_s *ring,
+                        FAR const void *elems, size_t nelem)
+{
+  FAR const uint8_t *src = elems;
+  size_t pos;
+  size_t n;
+  size_t i;
+
+  DEBUGASSERT(ring && (elems || nelem == 0));
+
+  if (nelem == 0)
+    {
+      return 0;
+    }
+
+  n = mpmcring_claim(ring, &ring->head, MPMCRING_FREE, nelem, &pos);
+  for (i = 0; i < n; i++, pos++, src += ring->esize)
+    {
+      memcpy(mpmcring_elem(ring, pos), src, ring->esize);
+      mpmcring_setseq(ring, pos, pos + MPMCRING_FULL);
+    }
+
+  return n;
+}
+
+/****************************************************************************
+ * Name: mpmcring_dequeue
+ *
+ * Description:
+ *   Copy up to nelem elements out of the ring.
+ *
+ * Returned Value:
+ *   The number of elements dequeued, less than nelem if the ring is empty.
+ *
+ ****************************************************************************/
+
+size_t mpmcring_dequeue(FAR struct mpmcring_s *ring,
+                        FAR void *elems, size_t nelem)
+{
+  FAR uint8_t *dst = elems;
+  size_t pos;
+  size_t n;
+  size_t i;
+
+  DEBUGASSERT(ring && (elems || nelem == 0));
+
+  if (nelem == 0)
+    {
+      return 0;
+    }
+
+  n = mpmcring_claim(ring, &ring->tail, MPMCRING_FULL, nelem, &pos);
+  for (i = 0; i < n; i++, pos++, dst += ring->esize)
+    {
+      memcpy(dst, mpmcring_elem(ring, pos), ring->esize);
+      mpmcring_setseq(ring, pos, pos + ring->mask + 1);
+    }
+
+  return n;
+}
+
+/****************************************************************************
+ * Name: mpmcring_enqueue_reserve
+ *
+ * Description:
+ *   Claim a free element to be filled in place.
+ *
+ ****************************************************************************/
+
+FAR void *mpmcring_enqueue_reserve(FAR struct mpmcring_s *ring)
+{
+  size_t pos;
+
+  DEBUGASSERT(ring);
+
+  if (mpmcring_claim(ring, &ring->head, MPMCRING_FREE, 1, &pos) == 0)
+    {
+      return NULL;
+    }
+
+  return mpmcring_elem(ring, pos);
+}
+
+/****************************************************************************
+ * Name: mpmcring_enqueue_commit
+ *
+ * Description:
+ *   Publish an element returned by mpmcring_enqueue_reserve().  Its
+ *   sequence number is still its position.
+ *
+ ****************************************************************************/
+
+void mpmcring_enqueue_commit(FAR struct mpmcring_s *ring, FAR void *elem)
+{
+  size_t idx;
+
+  DEBUGASSERT(ring && elem);
+
+  idx = ((FAR uint8_t *)elem - ring->base) / ring->esize;
+  mpmcring_setseq(ring, idx, ring->seq[idx] + MPMCRING_FULL);
+}
+
+/****************************************************************************
+ * Name: mpmcring_dequeue_reserve
+ *
+ * Description:
+ *   Claim the oldest element to be used in place.
+ *
+ ****************************************************************************/
+
+FAR void *mpmcring_dequeue_reserve(FAR struct mpmcring_s *ring)
+{
+  size_t pos;
+
+  DEBUGASSERT(ring);
+
+  if (mpmcring_claim(ring, &ring->tail, MPMCRING_FULL, 1, &pos) == 0)
+    {
+      return NULL;
+    }
+
+  return mpmcring_elem(ring, pos);
+}
+
+/****************************************************************************
+ * Name: mpmcring_dequeue_commit
+ *
+ * Description:
+ *   Give back an element returned by mpmcring_dequeue_reserve().  Its
+ *   sequence number is still its position plus one.
+ *
+ ****************************************************************************/
+
+void mpmcring_dequeue_commit(FAR struct mpmcring_s *ring, FAR void *elem)
+{
+  size_t idx;
+
+  DEBUGASSERT(ring && elem);
+
+  idx = ((FAR uint8_t *)elem - ring->base) / ring->esize;
+  mpmcring_setseq(ring, idx, ring->seq[idx] + ring->mask);
+}
@@ -0,0 +1,343 @@
+/****************************************************************************
+ * mm/circbuf/spscring.c
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <sys/param.h>
+#include <stdatomic.h>
+#include <string.h>
+#include <assert.h>
+#include <errno.h>
+
+#include <nuttx/kmalloc.h>
+#include <nuttx/mm/spscring.h>
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+/* The head is only written by the producer and the tail by the consumer.
+ * A side reads its own index plainly, and the other side's index with
+ * acquire semantics: the producer must not reuse an element before the
+ * consumer is done with it, and the consumer must see the contents of an
+ * element that the producer published.
+ */
+
+#define spscring_load(p) \
+  atomic_load_explicit((FAR atomic_size_t *)(p), memory_order_acquire)
+#define spscring_store(p, v) \
+  atomic_store_explicit((FAR atomic_size_t *)(p), (v), memory_order_release)
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: spscring_free
+ *
+ * Description:
+ *   Return the number of free elements as seen by the producer, at most
+ *   'want'.  The tail is read again only if the cached one shows fewer
+ *   than 'want'.
+ *
+ ****************************************************************************/
+
+static size_t spscring_free(FAR struct spscring_s *ring, size_t want)
+{
+  size_t size = ring->mask + 1;
+  size_t nfree = size - (ring->head - ring->tailcache);
+
+  if (nfree < want)
+    {
+      ring->tailcache = spscring_load(&ring->tail);
+      nfree = size - (ring->head - ring->tailcache);
+    }
+
+  return MIN(nfree, want);
+}
+
+/****************************************************************************
+ * Name: spscring_avail
+ *
+ * Description:
+ *   Return the number of elements as seen by the consumer, at most 'want'.
+ *   The head is read again only if the cached one shows fewer than 'want'.
+ *
+ ****************************************************************************/
+
+static size_t spscring_avail(FAR struct spscring_s *ring, size_t want)
+{
+  size_t avail = ring->headcache - ring->tail;
+
+  if (avail < want)
+    {
+      ring->headcache = spscring_load(&ring->head);
+      avail = ring->headcache - ring->tail;
+    }
+
+  return MIN(avail, want);
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: spscring_init
+ *
+ * Description:
+ *   Initialize a ring.
+ *
+ * Input Parameters:
+ *   ring  - Address of the ring to be used.
+ *   base  - The storage of the ring, of at least esize * nelem bytes.  If
+ *           NULL, it is allocated.
+ *   esize - The size of one element in bytes.
+ *   nelem - The number of elements, a power of two.
+ *
+ * Returned Value:
+ *   Zero on success; A negated errno value is returned on any failure.
+ *
+ ****************************************************************************/
+
+int spscring_init(FAR struct spscring_s *ring, FAR void *base,
+                  size_t esize, size_t nelem)
+{
+  DEBUGASSERT(ring);
+
+  if (esize == 0 || nelem == 0 || (nelem & (nelem - 1)) != 0)
+    {
+      return -EINVAL;
+    }
+
+  ring->external = base != NULL;
+
+  if (base == NULL)
+    {
+      base = kmm_malloc(esize * nelem);
+      if (base == NULL)
+        {
+          return -ENOMEM;
+        }
+    }
+
+  ring->base      = base;
+  ring->esize     = esize;
+  ring->mask      = nelem - 1;
+  ring->head      = 0;
+  ring->tailcache = 0;
+  ring->tail      = 0;
+  ring->headcache = 0;
+
+  return 0;
+}
+
+/****************************************************************************
+ * Name: spscring_uninit
+ *
+ * Description:
+ *   Free the storage of the ring if it was allocated by spscring_init().
+ *
+ ****************************************************************************/
+
+void spscring_uninit(FAR struct spscring_s *ring)
+{
+  DEBUGASSERT(ring);
+
+  if (!ring->external)
+    {
+      kmm_free(ring->base);
+    }
+
+  ring->base = NULL;
+}
+
+/****************************************************************************
+ * Name: spscring_used and spscring_space
+ *
+ * Description:
+ *   Return the number of elements in the ring and the number of free
+ *   elements.
+ *
+ ****************************************************************************/
+
+size_t spscring_used(FAR struct spscring_s *ring)
+{
+  size_t tail = spscring_load(&ring->tail);
+  size_t used = spscring_load(&ring->head) - tail;
+
+  /* Both sides may have moved on between the two loads */
+
+  return MIN(used, ring->mask + 1);
+}
+
+size_t spscring_space(FAR struct spscring_s *ring)
+{
+  return ring->mask + 1 - spscring_used(ring);
+}
+
+/****************************************************************************
+ * Name: spscring_enqueue
+ *
+ * Description:
+ *   Copy up to nelem elements into the ring.  Producer only.
+ *
+ * Returned Value:
+ *   The number of elements enqueued, less than nelem if the ring is full.
+ *
+ ****************************************************************************/
+
+size_t spscring_enqueue(FAR struct spscring_s *ring,
+                        FAR const void *elems, size_t nelem)
+{
+  size_t off;
+  size_t n;
+
+  DEBUGASSERT(ring && (elems || nelem == 0));
+
+  nelem = spscring_free(ring, nelem);
+  off   = ring->head & ring->mask;
+  n     = MIN(nelem, ring->mask + 1 - off);
+
+  /* Copy up to the end of the storage, then the rest from its start */
+
+  memcpy(ring->base + off * ring->esize, elems, n * ring->esize);
+  memcpy(ring->base, (FAR const uint8_t *)elems + n * ring->esize,
+         (nelem - n) * ring->esize);
+
+  spscring_store(&ring->head, ring->head + nelem);
+  return nelem;
+}
+
+/****************************************************************************
+ * Name: spscring_dequeue
+ *
+ * Description:
+ *   Copy up to nelem elements out of the ring.  Consumer only.
+ *
+ * Returned Value:
+ *   The number of elements dequeued, less than nelem if the ring is empty.
+ *
+ ****************************************************************************/
+
+size_t spscring_dequeue(FAR struct spscring_s *ring,
+                        FAR void *elems, size_t nelem)
+{
+  size_t off;
+  size_t n;
+
+  DEBUGASSERT(ring && (elems || nelem == 0));
+
+  nelem = spscring_avail(ring, nelem);
+  off   = ring->tail & ring->mask;
+  n     = MIN(nelem, ring->mask + 1 - off);
+
+  memcpy(elems, ring->base + off * ring->esize, n * ring->esize);
+  memcpy((FAR uint8_t *)elems + n * ring->esize, ring->base,
+         (nelem - n) * ring->esize);
+
+  spscring_store(&ring->tail, ring->tail + nelem);
+  return nelem;
+}
+
+/****************************************************************************
+ * Name: spscring_enqueue_reserve
+ *
+ * Description:
+ *   Return the first free element and, in *nelem, the number of free
+ *   elements that follow it contiguously, at most the number passed in.
+ *   Producer only.
+ *
+ ****************************************************************************/
+
+FAR void *spscring_enqueue_reserve(FAR struct spscring_s *ring,
+                                   FAR size_t *nelem)
+{
+  size_t off;
+  size_t n;
+
+  DEBUGASSERT(ring && nelem);
+
+  off = ring->head & ring->mask;
+  n   = MIN(*nelem, ring->mask + 1 - off);
+  n   = spscring_free(ring, n);
+
+  *nelem = n;
+  return n > 0 ? ring->base + off * ring->esize : NULL;
+}
+
+/****************************************************************************
+ * Name: spscring_enqueue_commit
+ *
+ * Description:
+ *   Publish nelem elements written in place after
+ *   spscring_enqueue_reserve().  Producer only.
+ *
+ ****************************************************************************/
+
+void spscring_enqueue_commit(FAR struct spscring_s *ring, size_t nelem)
+{
+  DEBUGASSERT(ring && spscring_free(ring, nelem) == nelem);
+  spscring_store(&ring->head, ring->head + nelem);
+}
+
+/****************************************************************************
+ * Name: spscring_dequeue_reserve
+ *
+ * Description:
+ *   Return the oldest element and, in *nelem, the number of elements that
+ *   follow it contiguously, at most the number passed in.  Consumer only.
+ *
+ ****************************************************************************/
+
+FAR void *spscring_dequeue_reserve(FAR struct spscring_s *ring,
+                                   FAR size_t *nelem)
+{
+  size_t off;
+  size_t n;
+
+  DEBUGASSERT(ring && nelem);
+
+  off = ring->tail & ring->mask;
+  n   = MIN(*nelem, ring->mask + 1 - off);
+  n   = spscring_avail(ring, n);
+
+  *nelem = n;
+  return n > 0 ? ring->base + off * ring->esize : NULL;
+}
+
+/****************************************************************************
+ * Name: spscring_dequeue_commit
+ *
+ * Description:
+ *   Give back nelem elements used in place after
+ *   spscring_dequeue_reserve().  Consumer only.
+ *
+ ****************************************************************************/
+
+void spscring_dequeue_commit(FAR struct spscring_s *ring, size_t nelem)
+{
+  DEBUGASSERT(ring && spscring_avail(ring, nelem) == nelem);
+  spscring_store(&ring->tail, ring->tail + nelem);
+}
@@ -217,7 +217,7 @@ FAR struct iob_qentry_s *iob_tryalloc_qentry(void)
        * so a simple decrement is all that is needed.
        */
 
-      g_qentry_sem.semcount--;
+      nxsem_count_dec(&g_qentry_sem);
       DEBUGASSERT(g_qentry_sem.semcount >= 0);
 
       /* Put the I/O buffer in a known state */
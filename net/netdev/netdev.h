@@ -32,6 +32,7 @@
 
 #include <nuttx/net/ip.h>
 #include <nuttx/net/netdev.h>
+#include <nuttx/spinlock.h>
 
 #ifdef CONFIG_NETDOWN_NOTIFIER
 #  include <nuttx/wqueue.h>
@@ -58,6 +59,13 @@ extern "C"
 
 EXTERN struct net_driver_s *g_netdevices;
 
+/* Changes to g_netdevices are also done with this lock held for writing,
+ * so that the lookups by name or index only need it held for reading,
+ * not the network lock.
+ */
+
+EXTERN rwlock_t g_netdevices_lock;
+
 #ifdef CONFIG_NETDEV_IFINDEX
 /* The set of network devices that have been registered.  This is used to
  * assign a unique device index to the newly registered device.
@@ -56,6 +56,7 @@
 FAR struct net_driver_s *netdev_findbyindex(int ifindex)
 {
   FAR struct net_driver_s *dev;
+  irqstate_t flags;
 #ifdef CONFIG_NETDEV_IFINDEX
   /* The bit index is the interface index minus one.  Zero is reserved in
    * POSIX to mean no interface index.
@@ -70,7 +71,7 @@ FAR struct net_driver_s *netdev_findbyindex(int ifindex)
 
 #endif
 
-  net_lock();
+  flags = read_lock_irqsave(&g_netdevices_lock);
 
 #ifdef CONFIG_NETDEV_IFINDEX
   /* Check if this index has been assigned */
@@ -79,7 +80,7 @@ FAR struct net_driver_s *netdev_findbyindex(int ifindex)
     {
       /* This index has not been assigned */
 
-      net_unlock();
+      read_unlock_irqrestore(&g_netdevices_lock, flags);
       return NULL;
     }
 #endif
@@ -102,12 +103,12 @@ FAR struct net_driver_s *netdev_findbyindex(int ifindex)
       if (++i == ifindex)
 #endif
         {
-          net_unlock();
+          read_unlock_irqrestore(&g_netdevices_lock, flags);
           return dev;
         }
     }
 
-  net_unlock();
+  read_unlock_irqrestore(&g_netdevices_lock, flags);
   return NULL;
 }
 
@@ -54,20 +54,21 @@
 FAR struct net_driver_s *netdev_findbyname(FAR const char *ifname)
 {
   FAR struct net_driver_s *dev;
+  irqstate_t flags;
 
   if (ifname)
     {
-      net_lock();
+      flags = read_lock_irqsave(&g_netdevices_lock);
       for (dev = g_netdevices; dev; dev = dev->flink)
         {
           if (strcmp(ifname, dev->d_ifname) == 0)
             {
-              net_unlock();
+              read_unlock_irqrestore(&g_netdevices_lock, flags);
               return dev;
             }
         }
 
-      net_unlock();
+      read_unlock_irqrestore(&g_netdevices_lock, flags);
     }
 
   return NULL;
@@ -83,6 +83,7 @@
 /* List of registered Ethernet device drivers */
 
 struct net_driver_s *g_netdevices = NULL;
+rwlock_t g_netdevices_lock = RW_SP_UNLOCKED;
 
 #ifdef CONFIG_NETDEV_IFINDEX
 /* The set of network devices that have been registered.  This is used to
@@ -242,6 +243,7 @@ static int get_ifindex(void)
 int netdev_register(FAR struct net_driver_s *dev, enum net_lltype_e lltype)
 {
   FAR struct net_driver_s **last;
+  irqstate_t irqflags;
   FAR char devfmt_str[IFNAMSIZ];
   FAR const char *devfmt;
   uint32_t flags   = 0;
@@ -453,15 +455,17 @@ int netdev_register(FAR struct net_driver_s *dev, enum net_lltype_e lltype)
 
       /* Add the device to the list of known network devices */
 
-      last = &g_netdevices;
+      dev->flink = NULL;
+
+      irqflags = write_lock_irqsave(&g_netdevices_lock);
+      last     = &g_netdevices;
       while (*last)
         {
           last = &((*last)->flink);
         }
 
       *last = dev;
-
-      dev->flink = NULL;
+      write_unlock_irqrestore(&g_netdevices_lock, irqflags);
 
 #ifdef CONFIG_NET_IGMP
       /* Configure the device for IGMP support */
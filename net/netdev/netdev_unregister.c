@@ -112,10 +112,12 @@ int netdev_unregister(FAR struct net_driver_s *dev)
 {
   struct net_driver_s *prev;
   struct net_driver_s *curr;
+  irqstate_t flags;
 
   if (dev)
     {
       net_lock();
+      flags = write_lock_irqsave(&g_netdevices_lock);
 
       /* Find the device in the list of known network devices */
 
@@ -145,6 +147,8 @@ int netdev_unregister(FAR struct net_driver_s *dev)
           curr->flink = NULL;
         }
 
+      write_unlock_irqrestore(&g_netdevices_lock, flags);
+
 #ifdef CONFIG_NETDEV_IFINDEX
       free_ifindex(dev->d_ifindex);
 #endif
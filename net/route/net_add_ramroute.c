@@ -60,6 +60,7 @@
 int net_addroute_ipv4(in_addr_t target, in_addr_t netmask, in_addr_t router)
 {
   FAR struct net_route_ipv4_s *route;
+  irqstate_t flags;
 
   /* Allocate a route entry */
 
@@ -83,8 +84,10 @@ int net_addroute_ipv4(in_addr_t target, in_addr_t netmask, in_addr_t router)
 
   /* Then add the new entry to the table */
 
+  flags = write_seqlock_irqsave(&g_ipv4_routes_lock);
   ramroute_ipv4_addlast((FAR struct net_route_ipv4_entry_s *)route,
                         &g_ipv4_routes);
+  write_sequnlock_irqrestore(&g_ipv4_routes_lock, flags);
   net_unlock();
   return OK;
 }
@@ -95,6 +98,7 @@ int net_addroute_ipv6(net_ipv6addr_t target, net_ipv6addr_t netmask,
                       net_ipv6addr_t router)
 {
   FAR struct net_route_ipv6_s *route;
+  irqstate_t flags;
 
   /* Allocate a route entry */
 
@@ -118,8 +122,10 @@ int net_addroute_ipv6(net_ipv6addr_t target, net_ipv6addr_t netmask,
 
   /* Then add the new entry to the table */
 
+  flags = write_seqlock_irqsave(&g_ipv6_routes_lock);
   ramroute_ipv6_addlast((FAR struct net_route_ipv6_entry_s *)route,
                         &g_ipv6_routes);
+  write_sequnlock_irqrestore(&g_ipv6_routes_lock, flags);
   net_unlock();
   return OK;
 }
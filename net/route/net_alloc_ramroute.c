@@ -46,10 +46,12 @@
 
 #ifdef CONFIG_ROUTE_IPv4_RAMROUTE
 FAR struct net_route_ipv4_queue_s g_ipv4_routes;
+seqlock_t g_ipv4_routes_lock = SEQLOCK_INITIALIZER;
 #endif
 
 #ifdef CONFIG_ROUTE_IPv6_RAMROUTE
 FAR struct net_route_ipv6_queue_s g_ipv6_routes;
+seqlock_t g_ipv6_routes_lock = SEQLOCK_INITIALIZER;
 #endif
 
 /****************************************************************************
@@ -83,6 +83,7 @@ static int net_match_ipv4(FAR struct net_route_ipv4_s *route, FAR void *arg)
 {
   FAR struct route_match_ipv4_s *match =
                     (FAR struct route_match_ipv4_s *)arg;
+  irqstate_t flags;
 
   /* To match, the masked target address must be the same, and the masks
    * must be the same.
@@ -98,6 +99,7 @@ static int net_match_ipv4(FAR struct net_route_ipv4_s *route, FAR void *arg)
     {
       /* They match.. Remove the entry from the routing table */
 
+      flags = write_seqlock_irqsave(&g_ipv4_routes_lock);
       if (match->prev)
         {
           ramroute_ipv4_remafter(
@@ -109,6 +111,8 @@ static int net_match_ipv4(FAR struct net_route_ipv4_s *route, FAR void *arg)
           ramroute_ipv4_remfirst(&g_ipv4_routes);
         }
 
+      write_sequnlock_irqrestore(&g_ipv4_routes_lock, flags);
+
       /* And free the routing table entry by adding it to the free list */
 
       net_freeroute_ipv4(route);
@@ -131,6 +135,7 @@ static int net_match_ipv6(
 {
   FAR struct route_match_ipv6_s *match =
                      (FAR struct route_match_ipv6_s *)arg;
+  irqstate_t flags;
 
   /* To match, the masked target address must be the same, and the masks
    * must be the same.
@@ -154,6 +159,7 @@ static int net_match_ipv6(
     {
       /* They match.. Remove the entry from the routing table */
 
+      flags = write_seqlock_irqsave(&g_ipv6_routes_lock);
       if (match->prev)
         {
           ramroute_ipv6_remafter(
@@ -165,6 +171,8 @@ static int net_match_ipv6(
           ramroute_ipv6_remfirst(&g_ipv6_routes);
         }
 
+      write_sequnlock_irqrestore(&g_ipv6_routes_lock, flags);
+
       /* And free the routing table entry by adding it to the free list */
 
       net_freeroute_ipv6(route);
@@ -28,6 +28,7 @@
 #include <errno.h>
 
 #include <nuttx/net/net.h>
+#include <nuttx/seqlock.h>
 
 #include <arch/irq.h>
 
@@ -117,4 +118,81 @@ int net_foreachroute_ipv6(route_handler_ipv6_t handler, FAR void *arg)
 }
 #endif
 
+/****************************************************************************
+ * Name: net_lookuproute_ipv4 and net_lookuproute_ipv6
+ *
+ * Description:
+ *   Search the routing table without the network lock.  The entries are
+ *   never returned to the heap, so a stale link still points into the
+ *   pre-allocated pool; the search is bounded by the size of that pool and
+ *   done again if the table was changed meanwhile.
+ *
+ * Input Parameters:
+ *   handler - Will be called for a copy of each route in the table.
+ *   arg     - An arbitrary value that will be passed to the handler.
+ *
+ * Returned Value:
+ *   Zero (OK) returned if the entire table was searched.  Handlers may
+ *   terminate the search early with any non-zero value.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_ROUTE_IPv4_RAMROUTE
+int net_lookuproute_ipv4(route_handler_ipv4_t handler, FAR void *arg)
+{
+  FAR struct net_route_ipv4_entry_s *route;
+  struct net_route_ipv4_s entry;
+  unsigned int seq;
+  int ret;
+  int i;
+
+  do
+    {
+      seq = read_seqbegin(&g_ipv4_routes_lock);
+      ret = 0;
+
+      for (route = g_ipv4_routes.head, i = 0;
+           ret == 0 && route != NULL &&
+           i < CONFIG_ROUTE_MAX_IPv4_RAMROUTES;
+           route = route->flink, i++)
+        {
+          entry = route->entry;
+          ret   = handler(&entry, arg);
+        }
+    }
+  while (read_seqretry(&g_ipv4_routes_lock, seq));
+
+  return ret;
+}
+#endif
+
+#ifdef CONFIG_ROUTE_IPv6_RAMROUTE
+int net_lookuproute_ipv6(route_handler_ipv6_t handler, FAR void *arg)
+{
+  FAR struct net_route_ipv6_entry_s *route;
+  struct net_route_ipv6_s entry;
+  unsigned int seq;
+  int ret;
+  int i;
+
+  do
+    {
+      seq = read_seqbegin(&g_ipv6_routes_lock);
+      ret = 0;
+
+      for (route = g_ipv6_routes.head, i = 0;
+           ret == 0 && route != NULL &&
+           i < CONFIG_ROUTE_MAX_IPv6_RAMROUTES;
+           route = route->flink, i++)
+        {
+          entry = route->entry;
+          ret   = handler(&entry, arg);
+        }
+    }
+  while (read_seqretry(&g_ipv6_routes_lock, seq));
+
+  return ret;
+}
+#endif
+
 #endif /* CONFIG_ROUTE_IPv4_RAMROUTE || CONFIG_ROUTE_IPv6_RAMROUTE */
@@ -224,7 +224,7 @@ int net_ipv4_router(in_addr_t target, FAR in_addr_t *router)
        * routing table that can forward to this address
        */
 
-      ret = net_foreachroute_ipv4(net_ipv4_match, &match);
+      ret = net_lookuproute_ipv4(net_ipv4_match, &match);
     }
 
   /* Did we find a route? */
@@ -299,7 +299,7 @@ int net_ipv6_router(const net_ipv6addr_t target, net_ipv6addr_t router)
        * routing table that can forward to this address
        */
 
-      ret = net_foreachroute_ipv6(net_ipv6_match, &match);
+      ret = net_lookuproute_ipv6(net_ipv6_match, &match);
     }
 
   /* Did we find a route? */
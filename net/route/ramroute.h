@@ -27,6 +27,8 @@
 
 #include <nuttx/config.h>
 
+#include <nuttx/seqlock.h>
+
 #include "route/route.h"
 
 #if defined(CONFIG_ROUTE_IPv4_RAMROUTE) || defined(CONFIG_ROUTE_IPv6_RAMROUTE)
@@ -105,12 +107,24 @@ struct net_route_ipv6_queue_s
 /* The in-memory routing tables are represented as singly linked lists. */
 
 extern struct net_route_ipv4_queue_s g_ipv4_routes;
+
+/* Changes to the table are published through this seqlock, so that
+ * net_lookuproute_ipv4() can search it without the network lock.
+ */
+
+extern seqlock_t g_ipv4_routes_lock;
 #endif
 
 #if defined(CONFIG_ROUTE_IPv6_RAMROUTE)
 /* The in-memory routing tables are represented as singly linked lists. */
 
 extern struct net_route_ipv6_queue_s g_ipv6_routes;
+
+/* Changes to the table are published through this seqlock, so that
+ * net_lookuproute_ipv6() can search it without the network lock.
+ */
+
+extern seqlock_t g_ipv6_routes_lock;
 #endif
 
 /****************************************************************************
@@ -273,6 +273,39 @@ int net_foreachroute_ipv4(route_handler_ipv4_t handler, FAR void *arg);
 int net_foreachroute_ipv6(route_handler_ipv6_t handler, FAR void *arg);
 #endif
 
+/****************************************************************************
+ * Name: net_lookuproute_ipv4/net_lookuproute_ipv6
+ *
+ * Description:
+ *   Search the routing table without locking the network.  The handler is
+ *   given a copy of each route and may be called again on the same routes
+ *   if the table changes during the search, so it must not modify the
+ *   table, must not block, and must not depend on earlier calls.  Only the
+ *   in-memory routing table supports this; the other ones are searched with
+ *   net_foreachroute_ipv4/net_foreachroute_ipv6().
+ *
+ * Input Parameters:
+ *   handler - Will be called for each route in the routing table.
+ *   arg     - An arbitrary value that will be passed to the handler.
+ *
+ * Returned Value:
+ *   Zero (OK) returned if the entire table was searched.  Handlers may
+ *   terminate the search early with any non-zero value.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_ROUTE_IPv4_RAMROUTE
+int net_lookuproute_ipv4(route_handler_ipv4_t handler, FAR void *arg);
+#elif defined(CONFIG_NET_IPv4)
+#  define net_lookuproute_ipv4(h, a) net_foreachroute_ipv4(h, a)
+#endif
+
+#ifdef CONFIG_ROUTE_IPv6_RAMROUTE
+int net_lookuproute_ipv6(route_handler_ipv6_t handler, FAR void *arg);
+#elif defined(CONFIG_NET_IPv6)
+#  define net_lookuproute_ipv6(h, a) net_foreachroute_ipv6(h, a)
+#endif
+
 /****************************************************************************
  * Name: net_ipv4_dumproute and net_ipv6_dumproute
  *
@@ -31,6 +31,7 @@
 
 #include <nuttx/clock.h>
 #include <nuttx/compiler.h>
+#include <nuttx/seqlock.h>
 
 /****************************************************************************
  * Pre-processor Definitions
@@ -64,6 +65,7 @@ extern volatile clock_t g_system_ticks;
 
 #ifndef CONFIG_CLOCK_TIMEKEEPING
 extern struct timespec  g_basetime;
+extern seqcount_t       g_basetime_seq;
 #endif
 
 /****************************************************************************
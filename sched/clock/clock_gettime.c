@@ -32,7 +32,6 @@
 
 #include <nuttx/arch.h>
 #include <nuttx/sched.h>
-#include <nuttx/spinlock.h>
 
 #include "clock/clock.h"
 #ifdef CONFIG_CLOCK_TIMEKEEPING
@@ -107,19 +106,23 @@ int clock_gettime(clockid_t clock_id, struct timespec *tp)
       ret = clock_systime_timespec(&ts);
       if (ret == OK)
         {
-          irqstate_t flags;
+          struct timespec base;
+          unsigned int seq;
 
           /* Add the base time to this.  The base time is the time-of-day
            * setting.  When added to the elapsed time since the time-of-day
            * was last set, this gives us the current time.
            */
 
-          flags = spin_lock_irqsave(NULL);
-
-          ts.tv_sec  += (uint32_t)g_basetime.tv_sec;
-          ts.tv_nsec += (uint32_t)g_basetime.tv_nsec;
+          do
+            {
+              seq  = read_seqcount_begin(&g_basetime_seq);
+              base = g_basetime;
+            }
+          while (read_seqcount_retry(&g_basetime_seq, seq));
 
-          spin_unlock_irqrestore(NULL, flags);
+          ts.tv_sec  += (uint32_t)base.tv_sec;
+          ts.tv_nsec += (uint32_t)base.tv_nsec;
 
           /* Handle carry to seconds. */
 
@@ -57,6 +57,7 @@ volatile uint32_t g_system_ticks = INITIAL_SYSTEM_TIMER_TICKS;
 
 #ifndef CONFIG_CLOCK_TIMEKEEPING
 struct timespec   g_basetime;
+seqcount_t        g_basetime_seq = SEQCOUNT_INITIALIZER;
 #endif
 
 /****************************************************************************
@@ -162,6 +163,8 @@ static void clock_inittime(FAR const struct timespec *tp)
 #ifndef CONFIG_CLOCK_TIMEKEEPING
   struct timespec ts;
 
+  write_seqcount_begin(&g_basetime_seq);
+
   if (tp)
     {
       memcpy(&g_basetime, tp, sizeof(struct timespec));
@@ -182,6 +185,8 @@ static void clock_inittime(FAR const struct timespec *tp)
       g_basetime.tv_nsec += NSEC_PER_SEC;
       g_basetime.tv_sec--;
     }
+
+  write_seqcount_end(&g_basetime_seq);
 #else
   clock_inittimekeeping(tp);
 #endif
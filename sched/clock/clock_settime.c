@@ -90,8 +90,11 @@ int clock_settime(clockid_t clock_id, FAR const struct timespec *tp)
 
       clock_systime_timespec(&bias);
 
-      /* Save the new base time. */
+      /* Save the new base time.  clock_gettime() reads it without the
+       * critical section.
+       */
 
+      write_seqcount_begin(&g_basetime_seq);
       g_basetime.tv_sec  = tp->tv_sec;
       g_basetime.tv_nsec = tp->tv_nsec;
 
@@ -110,6 +113,7 @@ int clock_settime(clockid_t clock_id, FAR const struct timespec *tp)
 
       g_basetime.tv_nsec -= bias.tv_nsec;
       g_basetime.tv_sec  -= bias.tv_sec;
+      write_seqcount_end(&g_basetime_seq);
 
       /* Setup the RTC (lo- or high-res) */
 
@@ -34,6 +34,7 @@
 
 #include <nuttx/irq.h>
 #include <nuttx/arch.h>
+#include <nuttx/seqlock.h>
 
 #include "clock/clock.h"
 
@@ -51,6 +52,7 @@ static struct timespec g_clock_wall_time;
 static uint64_t        g_clock_last_counter;
 static uint64_t        g_clock_mask;
 static long            g_clock_adjust;
+static seqcount_t      g_clock_seq = SEQCOUNT_INITIALIZER;
 
 /****************************************************************************
  * Private Functions
@@ -63,38 +65,45 @@ static long            g_clock_adjust;
 static int clock_get_current_time(FAR struct timespec *ts,
                                   FAR struct timespec *base)
 {
-  irqstate_t flags;
   uint64_t counter;
   uint64_t offset;
   uint64_t nsec;
+  unsigned int seq;
   time_t sec;
   int ret;
 
-  flags = enter_critical_section();
+  /* The wall time is read far more often than it is updated, read it
+   * without the critical section and retry if an update raced with us.
+   */
 
-  ret = up_timer_gettick(&counter);
-  if (ret < 0)
+  do
     {
-      goto errout_in_critical_section;
-    }
+      seq = read_seqcount_begin(&g_clock_seq);
 
-  offset = (counter - g_clock_last_counter) & g_clock_mask;
-  nsec   = offset * NSEC_PER_TICK;
-  sec    = nsec   / NSEC_PER_SEC;
-  nsec  -= sec    * NSEC_PER_SEC;
+      ret = up_timer_gettick(&counter);
+      if (ret < 0)
+        {
+          return ret;
+        }
 
-  nsec  += base->tv_nsec;
-  if (nsec >= NSEC_PER_SEC)
-    {
-      nsec -= NSEC_PER_SEC;
-      sec  += 1;
+      offset = (counter - g_clock_last_counter) & g_clock_mask;
+      nsec   = offset * NSEC_PER_TICK;
+      sec    = nsec   / NSEC_PER_SEC;
+      nsec  -= sec    * NSEC_PER_SEC;
+
+      nsec  += base->tv_nsec;
+      if (nsec >= NSEC_PER_SEC)
+        {
+          nsec -= NSEC_PER_SEC;
+          sec  += 1;
+        }
+
+      sec += base->tv_sec;
     }
+  while (read_seqcount_retry(&g_clock_seq, seq));
 
   ts->tv_nsec = nsec;
-  ts->tv_sec = base->tv_sec + sec;
-
-errout_in_critical_section:
-  leave_critical_section(flags);
+  ts->tv_sec  = sec;
   return ret;
 }
 
@@ -129,10 +138,12 @@ int clock_timekeeping_set_wall_time(FAR const struct timespec *ts)
       goto errout_in_critical_section;
     }
 
+  write_seqcount_begin(&g_clock_seq);
   memcpy(&g_clock_wall_time, ts, sizeof(struct timespec));
 
   g_clock_adjust       = 0;
   g_clock_last_counter = counter;
+  write_seqcount_end(&g_clock_seq);
 
 errout_in_critical_section:
   leave_critical_section(flags);
@@ -263,10 +274,12 @@ void clock_update_wall_time(void)
         }
     }
 
+  write_seqcount_begin(&g_clock_seq);
   g_clock_wall_time.tv_sec += sec;
   g_clock_wall_time.tv_nsec = (long)nsec;
 
   g_clock_last_counter = counter;
+  write_seqcount_end(&g_clock_seq);
 
 errout_in_critical_section:
   leave_critical_section(flags);
@@ -196,6 +196,13 @@ static inline void nx_workqueues(void)
 
 #endif /* CONFIG_SCHED_LPWORK */
 
+#ifdef CONFIG_SCHED_CPUWORK
+  /* Start the per-CPU worker threads */
+
+  work_start_cpu();
+
+#endif /* CONFIG_SCHED_CPUWORK */
+
 #ifdef CONFIG_LIBC_USRWORK
   /* Start the user-space work queue */
 
@@ -54,14 +54,9 @@
 #endif
 
 #ifdef CONFIG_SCHED_IRQMONITOR
-#  define CALL_VECTOR(ndx, vector, irq, context, arg) \
+#  define IRQMONITOR_UPDATE(ndx, vector, irq, elapsed) \
      do \
        { \
-         clock_t start; \
-         clock_t elapsed; \
-         start = perf_gettime(); \
-         vector(irq, context, arg); \
-         elapsed = perf_gettime() - start; \
          if (ndx < NUSER_IRQS) \
            { \
              g_irqvector[ndx].count++; \
@@ -79,9 +74,33 @@
        } \
      while (0)
 #else
+#  define IRQMONITOR_UPDATE(ndx, vector, irq, elapsed)
+#endif /* CONFIG_SCHED_IRQMONITOR */
+
+#ifdef CONFIG_SCHED_LATENCYMONITOR
+#  define LATENCY_UPDATE(elapsed) \
+     nxsched_latency_elapsed(&g_irq_latency[this_cpu()], elapsed)
+#else
+#  define LATENCY_UPDATE(elapsed)
+#endif
+
+#if defined(CONFIG_SCHED_IRQMONITOR) || defined(CONFIG_SCHED_LATENCYMONITOR)
+#  define CALL_VECTOR(ndx, vector, irq, context, arg) \
+     do \
+       { \
+         clock_t start; \
+         clock_t elapsed; \
+         start = perf_gettime(); \
+         vector(irq, context, arg); \
+         elapsed = perf_gettime() - start; \
+         IRQMONITOR_UPDATE(ndx, vector, irq, elapsed); \
+         LATENCY_UPDATE(elapsed); \
+       } \
+     while (0)
+#else
 #  define CALL_VECTOR(ndx, vector, irq, context, arg) \
      vector(irq, context, arg)
-#endif /* CONFIG_SCHED_IRQMONITOR */
+#endif
 
 /****************************************************************************
  * Public Functions
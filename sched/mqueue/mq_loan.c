@@ -0,0 +1,490 @@
+/****************************************************************************
+ * sched/mqueue/mq_loan.c
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <sys/types.h>
+#include <fcntl.h>
+#include <assert.h>
+#include <errno.h>
+#include <mqueue.h>
+
+#include <nuttx/irq.h>
+#include <nuttx/arch.h>
+#include <nuttx/nuttx.h>
+#include <nuttx/mqueue.h>
+
+#include "mqueue/mqueue.h"
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: nxmq_loan_msgq
+ *
+ * Description:
+ *   Return the message queue of a descriptor opened with 'oflag'.
+ *
+ ****************************************************************************/
+
+static int nxmq_loan_msgq(FAR struct file *mq, int oflag,
+                          FAR struct mqueue_inode_s **pmsgq)
+{
+  if (mq->f_inode == NULL || mq->f_inode->i_private == NULL)
+    {
+      return -EBADF;
+    }
+
+  if ((mq->f_oflags & oflag) == 0)
+    {
+      return -EBADF;
+    }
+
+  *pmsgq = mq->f_inode->i_private;
+  return OK;
+}
+
+/****************************************************************************
+ * Name: nxmq_loan_add
+ *
+ * Description:
+ *   Put a message out on loan.  The loan keeps the message queue from being
+ *   freed until it is given back.  Called within a critical section.
+ *
+ ****************************************************************************/
+
+static void nxmq_loan_add(FAR struct mqueue_inode_s *msgq,
+                          FAR struct mqueue_msg_s *mqmsg)
+{
+  list_add_tail(&msgq->loans, &mqmsg->node);
+  mqmsg->msgq = msgq;
+  msgq->nloans++;
+}
+
+/****************************************************************************
+ * Name: nxmq_loan_remove
+ *
+ * Description:
+ *   Take back the message that holds a loaned buffer.  Returns NULL if the
+ *   buffer is not out on loan from the message queue.  Called within a
+ *   critical section.
+ *
+ ****************************************************************************/
+
+static FAR struct mqueue_msg_s *
+nxmq_loan_remove(FAR struct mqueue_inode_s *msgq, FAR void *buffer)
+{
+  FAR struct mqueue_msg_s *mqmsg;
+
+  list_for_every_entry(&msgq->loans, mqmsg, struct mqueue_msg_s, node)
+    {
+      if (mqmsg->mail == buffer)
+        {
+          list_delete(&mqmsg->node);
+          mqmsg->msgq = NULL;
+          msgq->nloans--;
+          return mqmsg;
+        }
+    }
+
+  return NULL;
+}
+
+/****************************************************************************
+ * Name: nxmq_loan_free
+ *
+ * Description:
+ *   Free a message taken back from loan, and the message queue with it if
+ *   the queue was closed and unlinked and this was its last loan.  Called
+ *   within a critical section.
+ *
+ ****************************************************************************/
+
+static void nxmq_loan_free(FAR struct mqueue_inode_s *msgq,
+                           FAR struct mqueue_msg_s *mqmsg)
+{
+  nxmq_free_msg(msgq, mqmsg);
+
+  if (msgq->orphan && msgq->nloans == 0)
+    {
+      nxmq_free_msgq(msgq);
+    }
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: file_mq_loan
+ *
+ * Description:
+ *   Borrow a message buffer of the message queue "mq".  See nxmq_loan().
+ *
+ ****************************************************************************/
+
+int file_mq_loan(FAR struct file *mq, FAR void **buffer)
+{
+  FAR struct mqueue_inode_s *msgq;
+  FAR struct mqueue_msg_s *mqmsg;
+  irqstate_t flags;
+  int ret;
+
+  ret = nxmq_loan_msgq(mq, O_WROK, &msgq);
+  if (ret < 0)
+    {
+      return ret;
+    }
+
+  DEBUGASSERT(buffer != NULL);
+
+  flags = enter_critical_section();
+  mqmsg = nxmq_alloc_msg(msgq);
+  if (mqmsg != NULL)
+    {
+      nxmq_loan_add(msgq, mqmsg);
+    }
+
+  leave_critical_section(flags);
+
+  if (mqmsg == NULL)
+    {
+      return -ENOMEM;
+    }
+
+  *buffer = mqmsg->mail;
+  return OK;
+}
+
+/****************************************************************************
+ * Name: file_mq_send_loan
+ *
+ * Description:
+ *   Send a loaned message buffer to the message queue "mq".  See
+ *   nxmq_send_loan().
+ *
+ ****************************************************************************/
+
+int file_mq_send_loan(FAR struct file *mq, FAR void *buffer, size_t msglen,
+                      unsigned int prio)
+{
+  FAR struct mqueue_inode_s *msgq;
+  FAR struct mqueue_msg_s *mqmsg;
+  irqstate_t flags;
+  int ret;
+
+  ret = nxmq_loan_msgq(mq, O_WROK, &msgq);
+  if (ret < 0)
+    {
+      return ret;
+    }
+
+  if (prio >= MQ_PRIO_MAX)
+    {
+      return -EINVAL;
+    }
+
+  if (msglen > (size_t)msgq->maxmsgsize)
+    {
+      return -EMSGSIZE;
+    }
+
+  flags = enter_critical_section();
+
+  /* Take the buffer back from the caller, so that it cannot be sent or
+   * released twice while we wait.
+   */
+
+  mqmsg = nxmq_loan_remove(msgq, buffer);
+  if (mqmsg == NULL)
+    {
+      leave_critical_section(flags);
+      return -EINVAL;
+    }
+
+  /* Wait for space in the message queue, unless we are called from an
+   * interrupt handler.  See file_mq_send().
+   */
+
+  if (!up_interrupt_context() && msgq->nmsgs >= msgq->maxmsgs)
+    {
+      ret = nxmq_wait_send(msgq, mq->f_oflags);
+    }
+
+  if (ret == OK)
+    {
+      ret = nxmq_do_send(msgq, mqmsg, buffer, msglen, prio);
+    }
+  else
+    {
+      /* The caller still owns the buffer */
+
+      nxmq_loan_add(msgq, mqmsg);
+    }
+
+  leave_critical_section(flags);
+  return ret;
+}
+
+/****************************************************************************
+ * Name: file_mq_receive_loan
+ *
+ * Description:
+ *   Receive a message from the message queue "mq" without copying it.  See
+ *   nxmq_receive_loan().
+ *
+ ****************************************************************************/
+
+ssize_t file_mq_receive_loan(FAR struct file *mq, FAR void **buffer,
+                             FAR unsigned int *prio)
+{
+  FAR struct mqueue_inode_s *msgq;
+  FAR struct mqueue_msg_s *mqmsg;
+  irqstate_t flags;
+  ssize_t ret;
+
+  DEBUGASSERT(up_interrupt_context() == false && buffer != NULL);
+
+  ret = nxmq_loan_msgq(mq, O_RDOK, &msgq);
+  if (ret < 0)
+    {
+      return ret;
+    }
+
+  flags = enter_critical_section();
+
+  ret = nxmq_wait_receive(msgq, mq->f_oflags, &mqmsg);
+  if (ret == OK)
+    {
+      /* Remove the message but keep it; the caller now owns it */
+
+      ret     = nxmq_do_receive(msgq, mqmsg, NULL, prio);
+      *buffer = mqmsg->mail;
+      nxmq_loan_add(msgq, mqmsg);
+    }
+
+  leave_critical_section(flags);
+  return ret;
+}
+
+/****************************************************************************
+ * Name: file_mq_release_loan
+ *
+ * Description:
+ *   Give a loaned message buffer back to the message queue "mq".  See
+ *   nxmq_release_loan().
+ *
+ ****************************************************************************/
+
+int file_mq_release_loan(FAR struct file *mq, FAR void *buffer)
+{
+  FAR struct mqueue_inode_s *msgq;
+  FAR struct mqueue_msg_s *mqmsg;
+  irqstate_t flags;
+
+  if (mq->f_inode == NULL || mq->f_inode->i_private == NULL)
+    {
+      return -EBADF;
+    }
+
+  msgq  = mq->f_inode->i_private;
+
+  flags = enter_critical_section();
+  mqmsg = nxmq_loan_remove(msgq, buffer);
+  if (mqmsg != NULL)
+    {
+      nxmq_loan_free(msgq, mqmsg);
+    }
+
+  leave_critical_section(flags);
+  return mqmsg != NULL ? OK : -EINVAL;
+}
+
+/****************************************************************************
+ * Name: nxmq_loan
+ *
+ * Description:
+ *   Borrow a message buffer of the message queue "mqdes".
+ *
+ * Input Parameters:
+ *   mqdes  - Message queue descriptor, opened for writing
+ *   buffer - The location to return the message buffer
+ *
+ * Returned Value:
+ *   Zero (OK) on success, a negated errno value on failure.
+ *
+ ****************************************************************************/
+
+int nxmq_loan(mqd_t mqdes, FAR void **buffer)
+{
+  FAR struct file *filep;
+  int ret;
+
+  ret = fs_getfilep(mqdes, &filep);
+  if (ret < 0)
+    {
+      return ret;
+    }
+
+  return file_mq_loan(filep, buffer);
+}
+
+/****************************************************************************
+ * Name: nxmq_send_loan
+ *
+ * Description:
+ *   Send a message that was written in place in a loaned buffer.
+ *
+ * Input Parameters:
+ *   mqdes  - Message queue descriptor
+ *   buffer - The buffer returned by nxmq_loan()
+ *   msglen - The length of the message in bytes
+ *   prio   - The priority of the message
+ *
+ * Returned Value:
+ *   Zero (OK) on success, a negated errno value on failure.
+ *
+ ****************************************************************************/
+
+int nxmq_send_loan(mqd_t mqdes, FAR void *buffer, size_t msglen,
+                   unsigned int prio)
+{
+  FAR struct file *filep;
+  int ret;
+
+  ret = fs_getfilep(mqdes, &filep);
+  if (ret < 0)
+    {
+      return ret;
+    }
+
+  return file_mq_send_loan(filep, buffer, msglen, prio);
+}
+
+/****************************************************************************
+ * Name: nxmq_receive_loan
+ *
+ * Description:
+ *   Receive the oldest of the highest priority messages without copying
+ *   it.
+ *
+ * Input Parameters:
+ *   mqdes  - Message queue descriptor
+ *   buffer - The location to return the message buffer
+ *   prio   - If not NULL, the location to store message priority.
+ *
+ * Returned Value:
+ *   The length of the message on success, a negated errno value on
+ *   failure.
+ *
+ ****************************************************************************/
+
+ssize_t nxmq_receive_loan(mqd_t mqdes, FAR void **buffer,
+                          FAR unsigned int *prio)
+{
+  FAR struct file *filep;
+  int ret;
+
+  ret = fs_getfilep(mqdes, &filep);
+  if (ret < 0)
+    {
+      return ret;
+    }
+
+  return file_mq_receive_loan(filep, buffer, prio);
+}
+
+/****************************************************************************
+ * Name: nxmq_release_loan
+ *
+ * Description:
+ *   Give a loaned message buffer back to the message queue.
+ *
+ * Input Parameters:
+ *   mqdes  - Message queue descriptor
+ *   buffer - The buffer returned by nxmq_loan() or nxmq_receive_loan()
+ *
+ * Returned Value:
+ *   Zero (OK) on success, a negated errno value on failure.
+ *
+ ****************************************************************************/
+
+int nxmq_release_loan(mqd_t mqdes, FAR void *buffer)
+{
+  FAR struct file *filep;
+  int ret;
+
+  ret = fs_getfilep(mqdes, &filep);
+  if (ret < 0)
+    {
+      return ret;
+    }
+
+  return file_mq_release_loan(filep, buffer);
+}
+
+/****************************************************************************
+ * Name: nxmq_return_loan
+ *
+ * Description:
+ *   Give a loaned message buffer back to the message queue that lent it,
+ *   without a descriptor of the queue.  This is the only way to give back
+ *   a buffer once the queue was closed for the last time.
+ *
+ * Input Parameters:
+ *   buffer - The buffer returned by nxmq_loan() or nxmq_receive_loan()
+ *
+ * Returned Value:
+ *   Zero (OK) on success, a negated errno value on failure.
+ *
+ ****************************************************************************/
+
+int nxmq_return_loan(FAR void *buffer)
+{
+  FAR struct mqueue_inode_s *msgq;
+  FAR struct mqueue_msg_s *mqmsg;
+  irqstate_t flags;
+
+  if (buffer == NULL)
+    {
+      return -EINVAL;
+    }
+
+  mqmsg = container_of(buffer, struct mqueue_msg_s, mail);
+
+  flags = enter_critical_section();
+
+  /* The queue is cleared when the message is taken back from loan */
+
+  msgq  = mqmsg->msgq;
+  mqmsg = msgq != NULL ? nxmq_loan_remove(msgq, buffer) : NULL;
+  if (mqmsg != NULL)
+    {
+      nxmq_loan_free(msgq, mqmsg);
+    }
+
+  leave_critical_section(flags);
+  return mqmsg != NULL ? OK : -EINVAL;
+}
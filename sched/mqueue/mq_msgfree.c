@@ -45,6 +45,7 @@
  *   allocated dynamically it will be deallocated.
  *
  * Input Parameters:
+ *   msgq  - The message queue that the message was allocated for
  *   mqmsg - message to free
  *
  * Returned Value:
@@ -52,7 +53,8 @@
  *
  ****************************************************************************/
 
-void nxmq_free_msg(FAR struct mqueue_msg_s *mqmsg)
+void nxmq_free_msg(FAR struct mqueue_inode_s *msgq,
+                   FAR struct mqueue_msg_s *mqmsg)
 {
   /* If this is a generally available pre-allocated message,
    * then just put it back in the free list.
@@ -80,6 +82,18 @@ void nxmq_free_msg(FAR struct mqueue_msg_s *mqmsg)
       list_add_tail(&g_msgfreeirq, &mqmsg->node);
     }
 
+#ifdef CONFIG_MQ_QUEUE_POOL
+  /* If this message came from the pool of the message queue, then put it
+   * back in that pool.
+   */
+
+  else if (mqmsg->type == MQ_ALLOC_QUEUE)
+    {
+      DEBUGASSERT(nxmq_msg_inpool(msgq, mqmsg));
+      list_add_tail(&msgq->msgfree, &mqmsg->node);
+    }
+#endif
+
   /* Otherwise, deallocate it.  Note:  interrupt handlers
    * will never deallocate messages because they will not
    * received them.
@@ -24,8 +24,10 @@
 
 #include <nuttx/config.h>
 
+#include <stdint.h>
 #include <mqueue.h>
 #include <assert.h>
+#include <errno.h>
 
 #include <nuttx/kmalloc.h>
 #include <nuttx/sched.h>
@@ -43,7 +45,9 @@
  *
  * Description:
  *   This function implements a part of the POSIX message queue open logic.
- *   It allocates and initializes a struct mqueue_inode_s structure.
+ *   It allocates and initializes a struct mqueue_inode_s structure and, if
+ *   CONFIG_MQ_QUEUE_POOL is selected, a pool of messages sized for the new
+ *   message queue.
  *
  * Input Parameters:
  *   attr   - The mq_maxmsg attribute is used at the time that the message
@@ -66,6 +70,13 @@ int nxmq_alloc_msgq(FAR struct mq_attr *attr,
                     FAR struct mqueue_inode_s **pmsgq)
 {
   FAR struct mqueue_inode_s *msgq;
+  size_t maxmsgs    = MQ_MAX_MSGS;
+  size_t maxmsgsize = MQ_MAX_BYTES;
+  size_t msgqsize   = sizeof(struct mqueue_inode_s);
+#ifdef CONFIG_MQ_QUEUE_POOL
+  size_t msgsize;
+  size_t i;
+#endif
 
   /* Check if the caller is attempting to allocate a message for messages
    * larger than the configured maximum message size.
@@ -77,26 +88,70 @@ int nxmq_alloc_msgq(FAR struct mq_attr *attr,
       return -EINVAL;
     }
 
+  if (attr)
+    {
+      maxmsgs    = attr->mq_maxmsg;
+      maxmsgsize = attr->mq_msgsize;
+    }
+
+#ifdef CONFIG_MQ_QUEUE_POOL
+  /* The pool follows the message queue structure in the same allocation */
+
+  msgqsize = (msgqsize + MQ_MSG_ALIGN - 1) & ~(MQ_MSG_ALIGN - 1);
+  msgsize  = MQ_MSG_SIZE(maxmsgsize);
+#endif
+
+  /* The number of messages must fit in the queue, and its pool in memory */
+
+  if (maxmsgs > INT16_MAX)
+    {
+      return -EINVAL;
+    }
+
+#ifdef CONFIG_MQ_QUEUE_POOL
+  if (maxmsgs > (SIZE_MAX - msgqsize) / msgsize)
+    {
+      return -ENOSPC;
+    }
+#endif
+
   /* Allocate memory for the new message queue. */
 
   msgq = (FAR struct mqueue_inode_s *)
-    kmm_zalloc(sizeof(struct mqueue_inode_s));
+#ifdef CONFIG_MQ_QUEUE_POOL
+    kmm_zalloc(msgqsize + maxmsgs * msgsize);
+#else
+    kmm_zalloc(msgqsize);
+#endif
 
   if (msgq)
     {
       /* Initialize the new named message queue */
 
       list_initialize(&msgq->msglist);
-      if (attr)
-        {
-          msgq->maxmsgs    = (int16_t)attr->mq_maxmsg;
-          msgq->maxmsgsize = (int16_t)attr->mq_msgsize;
-        }
-      else
+      msgq->maxmsgs    = (int16_t)maxmsgs;
+      msgq->maxmsgsize = maxmsgsize;
+
+#ifdef CONFIG_MQ_QUEUE_POOL
+      /* Put the messages of the pool on the free list of the queue */
+
+      list_initialize(&msgq->msgfree);
+      msgq->pool     = (FAR char *)msgq + msgqsize;
+      msgq->poolsize = maxmsgs * msgsize;
+
+      for (i = 0; i < maxmsgs; i++)
         {
-          msgq->maxmsgs    = MQ_MAX_MSGS;
-          msgq->maxmsgsize = MQ_MAX_BYTES;
+          FAR struct mqueue_msg_s *mqmsg =
+            (FAR struct mqueue_msg_s *)(msgq->pool + i * msgsize);
+
+          mqmsg->type = MQ_ALLOC_QUEUE;
+          list_add_tail(&msgq->msgfree, &mqmsg->node);
         }
+#endif
+
+#ifdef CONFIG_MQ_LOAN
+      list_initialize(&msgq->loans);
+#endif
 
 #ifndef CONFIG_DISABLE_MQUEUE_NOTIFICATION
       msgq->ntpid = INVALID_PROCESS_ID;
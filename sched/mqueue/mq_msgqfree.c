@@ -63,10 +63,24 @@ void nxmq_free_msgq(FAR struct mqueue_inode_s *msgq)
       /* Deallocate the message structure. */
 
       list_delete(&entry->node);
-      nxmq_free_msg(entry);
+      nxmq_free_msg(msgq, entry);
     }
 
-  /* Then deallocate the message queue itself */
+#ifdef CONFIG_MQ_LOAN
+  /* Buffers out on loan may still be accessed by their borrowers, and may
+   * be in the pool of the queue.  Keep the queue rather than free the
+   * memory under them: it is freed when nxmq_return_loan() gives the last
+   * one back.
+   */
+
+  if (msgq->nloans > 0)
+    {
+      msgq->orphan = true;
+      return;
+    }
+#endif
+
+  /* Then deallocate the message queue itself, together with its pool */
 
   kmm_free(msgq);
 }
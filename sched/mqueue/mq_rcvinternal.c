@@ -250,7 +250,9 @@ int nxmq_wait_receive(FAR struct mqueue_inode_s *msgq,
  * Input Parameters:
  *   msgq    - Message queue descriptor
  *   mqmsg   - The message obtained by mq_waitmsg()
- *   ubuffer - The address of the user provided buffer to receive the message
+ *   ubuffer - The address of the user provided buffer to receive the
+ *             message.  If NULL, the message is not copied nor freed; it
+ *             is loaned to the caller, who frees it when done with it.
  *   prio    - The user-provided location to return the message priority.
  *
  * Returned Value:
@@ -277,20 +279,23 @@ ssize_t nxmq_do_receive(FAR struct mqueue_inode_s *msgq,
 
   rcvmsglen = mqmsg->msglen;
 
-  /* Copy the message into the caller's buffer */
-
-  memcpy(ubuffer, (FAR const void *)mqmsg->mail, rcvmsglen);
-
-  /* Copy the message priority as well (if a buffer is provided) */
+  /* Copy the message priority (if a buffer is provided) */
 
   if (prio)
     {
       *prio = mqmsg->priority;
     }
 
-  /* We are done with the message.  Deallocate it now. */
+  if (ubuffer != NULL)
+    {
+      /* Copy the message into the caller's buffer */
+
+      memcpy(ubuffer, (FAR const void *)mqmsg->mail, rcvmsglen);
+
+      /* We are done with the message.  Deallocate it now. */
 
-  nxmq_free_msg(mqmsg);
+      nxmq_free_msg(msgq, mqmsg);
+    }
 
   /* Check if any tasks are waiting for the MQ not full event. */
 
@@ -171,7 +171,7 @@ int file_mq_timedsend(FAR struct file *mq, FAR const char *msg,
 
   /* Pre-allocate a message structure */
 
-  mqmsg = nxmq_alloc_msg();
+  mqmsg = nxmq_alloc_msg(msgq);
   if (mqmsg == NULL)
     {
       /* Failed to allocate the message. nxmq_alloc_msg() does not set the
@@ -212,7 +212,7 @@ int file_mq_timedsend(FAR struct file *mq, FAR const char *msg,
   if (!abstime || abstime->tv_nsec < 0 || abstime->tv_nsec >= 1000000000)
     {
       ret = -EINVAL;
-      nxmq_free_msg(mqmsg);
+      nxmq_free_msg(msgq, mqmsg);
       goto errout_in_critical_section;
     }
 
@@ -239,7 +239,7 @@ int file_mq_timedsend(FAR struct file *mq, FAR const char *msg,
   if (ret != OK)
     {
       ret = -ret;
-      nxmq_free_msg(mqmsg);
+      nxmq_free_msg(msgq, mqmsg);
       goto errout_in_critical_section;
     }
 
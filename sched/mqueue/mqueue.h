@@ -29,6 +29,7 @@
 #include <nuttx/compiler.h>
 
 #include <sys/types.h>
+#include <stddef.h>
 #include <stdint.h>
 #include <stdbool.h>
 #include <limits.h>
@@ -47,6 +48,22 @@
 #define MQ_MAX_MSGS    16
 #define MQ_PRIO_MAX    _POSIX_MQ_PRIO_MAX
 
+/* The size of a message with 'n' bytes of payload, as it is laid out in
+ * the pool of a message queue.
+ */
+
+#define MQ_MSG_ALIGN   sizeof(FAR void *)
+#define MQ_MSG_SIZE(n) \
+  ((offsetof(struct mqueue_msg_s, mail) + (n) + MQ_MSG_ALIGN - 1) & \
+   ~(MQ_MSG_ALIGN - 1))
+
+/* Check if a message belongs to the pool of the message queue */
+
+#ifdef CONFIG_MQ_QUEUE_POOL
+#  define nxmq_msg_inpool(msgq, mqmsg) \
+     ((size_t)((FAR char *)(mqmsg) - (msgq)->pool) < (msgq)->poolsize)
+#endif
+
 /****************************************************************************
  * Public Type Definitions
  ****************************************************************************/
@@ -55,7 +72,8 @@ enum mqalloc_e
 {
   MQ_ALLOC_FIXED = 0,  /* Pre-allocated; never freed */
   MQ_ALLOC_DYN,        /* Dynamically allocated; free when unused */
-  MQ_ALLOC_IRQ         /* Preallocated, reserved for interrupt handling */
+  MQ_ALLOC_IRQ,        /* Preallocated, reserved for interrupt handling */
+  MQ_ALLOC_QUEUE       /* Preallocated with the message queue */
 };
 
 /* This structure describes one buffered POSIX message. */
@@ -63,6 +81,9 @@ enum mqalloc_e
 struct mqueue_msg_s
 {
   struct list_node node;   /* Link node to message */
+#ifdef CONFIG_MQ_LOAN
+  FAR struct mqueue_inode_s *msgq; /* The queue that lent it, if on loan */
+#endif
   uint8_t type;            /* (Used to manage allocations) */
   uint8_t priority;        /* Priority of message */
 #if MQ_MAX_BYTES < 256
@@ -107,7 +128,8 @@ struct task_group_s; /* Forward reference */
 /* Functions defined in mq_initialize.c *************************************/
 
 void nxmq_initialize(void);
-void nxmq_free_msg(FAR struct mqueue_msg_s *mqmsg);
+void nxmq_free_msg(FAR struct mqueue_inode_s *msgq,
+                   FAR struct mqueue_msg_s *mqmsg);
 
 /* mq_waitirq.c *************************************************************/
 
@@ -134,7 +156,7 @@ int nxmq_verify_send(FAR struct file *mq, FAR const char *msg,
 #else
 #  define nxmq_verify_send(mq, msg, msglen, prio) OK
 #endif
-FAR struct mqueue_msg_s *nxmq_alloc_msg(void);
+FAR struct mqueue_msg_s *nxmq_alloc_msg(FAR struct mqueue_inode_s *msgq);
 int nxmq_wait_send(FAR struct mqueue_inode_s *msgq, int oflags);
 int nxmq_do_send(FAR struct mqueue_inode_s *msgq,
                  FAR struct mqueue_msg_s *mqmsg,
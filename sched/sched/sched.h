@@ -413,6 +413,24 @@ void nxsched_resume_critmon(FAR struct tcb_s *tcb);
 void nxsched_suspend_critmon(FAR struct tcb_s *tcb);
 #endif
 
+/* Latency monitor */
+
+#ifdef CONFIG_SCHED_LATENCYMONITOR
+void nxsched_latency_record(FAR struct latency_hist_s *hist, uint64_t nsec);
+void nxsched_latency_elapsed(FAR struct latency_hist_s *hist,
+                             clock_t elapsed);
+void nxsched_latency_wdog(sclock_t lag);
+void nxsched_wakeup_latency(FAR struct tcb_s *tcb);
+#endif
+
+/* Scheduler statistics */
+
+#ifdef CONFIG_SCHED_SCHEDSTAT
+void nxsched_schedstat_wakeup(FAR struct tcb_s *tcb);
+void nxsched_schedstat_suspend(FAR struct tcb_s *tcb);
+void nxsched_schedstat_resume(FAR struct tcb_s *tcb);
+#endif
+
 /* TCB operations */
 
 bool nxsched_verify_tcb(FAR struct tcb_s *tcb);
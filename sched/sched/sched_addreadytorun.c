@@ -70,6 +70,19 @@ bool nxsched_add_readytorun(FAR struct tcb_s *btcb)
   FAR struct tcb_s *rtcb = this_task();
   bool ret;
 
+#ifdef CONFIG_SCHED_LATENCYMONITOR
+  /* Measure the time until the task gets the CPU */
+
+  if (btcb->wakeup_start == 0)
+    {
+      btcb->wakeup_start = perf_gettime();
+    }
+#endif
+
+#ifdef CONFIG_SCHED_SCHEDSTAT
+  nxsched_schedstat_wakeup(btcb);
+#endif
+
   /* Check if pre-emption is disabled for the current running task and if
    * the new ready-to-run task would cause the current running task to be
    * pre-empted.  NOTE that IRQs disabled implies that pre-emption is
@@ -159,6 +172,19 @@ bool nxsched_add_readytorun(FAR struct tcb_s *btcb)
   int cpu;
   int me;
 
+#ifdef CONFIG_SCHED_LATENCYMONITOR
+  /* Measure the time until the task gets the CPU */
+
+  if (btcb->wakeup_start == 0)
+    {
+      btcb->wakeup_start = perf_gettime();
+    }
+#endif
+
+#ifdef CONFIG_SCHED_SCHEDSTAT
+  nxsched_schedstat_wakeup(btcb);
+#endif
+
   /* Check if the blocked TCB is locked to this CPU */
 
   if ((btcb->flags & TCB_FLAG_CPU_LOCKED) != 0)
@@ -0,0 +1,199 @@
+/****************************************************************************
+ * sched/sched/sched_latency.c
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <sys/types.h>
+#include <stdint.h>
+#include <strings.h>
+#include <time.h>
+
+#include <nuttx/clock.h>
+#include <nuttx/sched.h>
+
+#include "sched/sched.h"
+
+#ifdef CONFIG_SCHED_LATENCYMONITOR
+
+/****************************************************************************
+ * Public Data
+ ****************************************************************************/
+
+struct latency_hist_s g_irq_latency[CONFIG_SMP_NCPUS];
+struct latency_hist_s g_wakeup_latency[CONFIG_SMP_NCPUS];
+struct latency_hist_s g_wdog_latency;
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: nxsched_latency_record
+ *
+ * Description:
+ *   Add a latency of 'nsec' nanoseconds to a histogram.  The caller must
+ *   keep other CPUs from updating the same histogram.
+ *
+ ****************************************************************************/
+
+void nxsched_latency_record(FAR struct latency_hist_s *hist, uint64_t nsec)
+{
+  int bucket = nsec > 0 ? flsll(nsec) - 1 : 0;
+
+  if (bucket >= LATENCY_NBUCKETS)
+    {
+      bucket = LATENCY_NBUCKETS - 1;
+    }
+
+  hist->count[bucket]++;
+  if (nsec > hist->max)
+    {
+      hist->max = nsec;
+    }
+}
+
+/****************************************************************************
+ * Name: nxsched_latency_elapsed
+ *
+ * Description:
+ *   Add a latency measured with perf_gettime() to a histogram.
+ *
+ ****************************************************************************/
+
+void nxsched_latency_elapsed(FAR struct latency_hist_s *hist,
+                             clock_t elapsed)
+{
+  struct timespec ts;
+
+  perf_convert(elapsed, &ts);
+  nxsched_latency_record(hist, (uint64_t)ts.tv_sec * NSEC_PER_SEC +
+                               ts.tv_nsec);
+}
+
+/****************************************************************************
+ * Name: nxsched_latency_wdog
+ *
+ * Description:
+ *   Called when a watchdog expires, 'lag' being the (zero or negative)
+ *   number of ticks left on it.  Records how late the watchdog runs
+ *   compared to the tick it was due.  With a tick based system clock the
+ *   resolution is a tick.
+ *
+ * Assumptions:
+ *   Called from within the critical section of the watchdog expiration.
+ *
+ ****************************************************************************/
+
+void nxsched_latency_wdog(sclock_t lag)
+{
+  struct timespec ts;
+  uint64_t expected;
+  uint64_t now;
+
+  expected = TICK2NSEC((uint64_t)(clock_systime_ticks() + lag));
+
+  clock_systime_timespec(&ts);
+  now = (uint64_t)ts.tv_sec * NSEC_PER_SEC + ts.tv_nsec;
+
+  nxsched_latency_record(&g_wdog_latency, now > expected ?
+                                          now - expected : 0);
+}
+
+/****************************************************************************
+ * Name: nxsched_wakeup_latency
+ *
+ * Description:
+ *   Called when 'tcb' starts running on this CPU.  If it was made ready-
+ *   to-run since it last ran, record how long it waited for the CPU.
+ *
+ ****************************************************************************/
+
+void nxsched_wakeup_latency(FAR struct tcb_s *tcb)
+{
+  struct timespec ts;
+  uint64_t nsec;
+
+  if (tcb->wakeup_start == 0)
+    {
+      return;
+    }
+
+  perf_convert(perf_gettime() - tcb->wakeup_start, &ts);
+  tcb->wakeup_start = 0;
+
+  nsec = (uint64_t)ts.tv_sec * NSEC_PER_SEC + ts.tv_nsec;
+  nxsched_latency_record(&tcb->wakeup_latency, nsec);
+  nxsched_latency_record(&g_wakeup_latency[this_cpu()], nsec);
+}
+
+/****************************************************************************
+ * Name: nxsched_latency_percentile
+ *
+ * Description:
+ *   Return an upper bound, in nanoseconds, of the latency below which
+ *   'permille' thousandths of the samples of a latency histogram fall.
+ *   Zero is returned if the histogram is empty.
+ *
+ ****************************************************************************/
+
+uint64_t nxsched_latency_percentile(FAR const struct latency_hist_s *hist,
+                                    unsigned int permille)
+{
+  uint64_t total = 0;
+  uint64_t target;
+  uint64_t bound;
+  int i;
+
+  for (i = 0; i < LATENCY_NBUCKETS; i++)
+    {
+      total += hist->count[i];
+    }
+
+  if (total == 0)
+    {
+      return 0;
+    }
+
+  target = (total * permille + 999) / 1000;
+  total  = 0;
+
+  for (i = 0; i < LATENCY_NBUCKETS - 1; i++)
+    {
+      total += hist->count[i];
+      if (total >= target)
+        {
+          break;
+        }
+    }
+
+  /* The bucket bounds the latency, the largest sample may bound it
+   * better.
+   */
+
+  bound = i < LATENCY_NBUCKETS - 1 ? (UINT64_C(1) << (i + 1)) - 1 :
+                                     hist->max;
+  return bound < hist->max ? bound : hist->max;
+}
+
+#endif /* CONFIG_SCHED_LATENCYMONITOR */
@@ -30,6 +30,7 @@
 
 #include <nuttx/arch.h>
 #include <nuttx/sched.h>
+#include <nuttx/perf.h>
 
 #include "sched/sched.h"
 #include "group/group.h"
@@ -122,6 +123,15 @@ int nxsched_release_tcb(FAR struct tcb_s *tcb, uint8_t ttype)
           nxsched_releasepid(tcb->pid);
         }
 
+#ifdef CONFIG_PERF_EVENTS
+      /* Detach the performance counters that count this thread.  This is
+       * done once the PID is released: perf_setup() can no longer find the
+       * TCB and attach a counter to it after its list was emptied.
+       */
+
+      perf_event_release(tcb);
+#endif
+
       /* Delete the thread's stack if one has been allocated */
 
       if (tcb->stack_alloc_ptr)
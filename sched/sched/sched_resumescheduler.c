@@ -28,6 +28,7 @@
 
 #include <nuttx/sched.h>
 #include <nuttx/clock.h>
+#include <nuttx/perf.h>
 #include <nuttx/sched_note.h>
 
 #include "irq/irq.h"
@@ -71,6 +72,15 @@ void nxsched_resume_scheduler(FAR struct tcb_s *tcb)
 #ifdef CONFIG_SCHED_CRITMONITOR
   nxsched_resume_critmon(tcb);
 #endif
+#ifdef CONFIG_PERF_EVENTS
+  perf_event_resume(tcb);
+#endif
+#ifdef CONFIG_SCHED_LATENCYMONITOR
+  nxsched_wakeup_latency(tcb);
+#endif
+#ifdef CONFIG_SCHED_SCHEDSTAT
+  nxsched_schedstat_resume(tcb);
+#endif
 #ifdef CONFIG_SCHED_INSTRUMENTATION
   sched_note_resume(tcb);
 #endif
@@ -0,0 +1,139 @@
+/****************************************************************************
+ * sched/sched/sched_schedstat.c
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <sys/types.h>
+#include <time.h>
+
+#include <nuttx/clock.h>
+#include <nuttx/sched.h>
+
+#include "sched/sched.h"
+
+#ifdef CONFIG_SCHED_SCHEDSTAT
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: nxsched_schedstat_wakeup
+ *
+ * Description:
+ *   Called when 'tcb' is added to the ready-to-run list.  Starts the wait
+ *   for the CPU unless the thread is already waiting or running, as when
+ *   its priority is changed.
+ *
+ ****************************************************************************/
+
+void nxsched_schedstat_wakeup(FAR struct tcb_s *tcb)
+{
+  if (tcb->schedstat.stamp == 0)
+    {
+      tcb->schedstat.stamp = perf_gettime();
+    }
+}
+
+/****************************************************************************
+ * Name: nxsched_schedstat_suspend
+ *
+ * Description:
+ *   Called when 'tcb' stops running on this CPU.  The thread switched out
+ *   voluntarily if it blocked, involuntarily if it is still ready-to-run.
+ *
+ * Assumptions:
+ *   The ready-to-run list already holds the thread that replaces 'tcb'.
+ *
+ ****************************************************************************/
+
+void nxsched_schedstat_suspend(FAR struct tcb_s *tcb)
+{
+  FAR struct schedstat_s *stat = &tcb->schedstat;
+  clock_t now = perf_gettime();
+
+  if (stat->stamp != 0)
+    {
+      stat->exec_time += now - stat->stamp;
+    }
+
+  stat->stamp = 0;
+
+  if (tcb->task_state >= FIRST_BLOCKED_STATE)
+    {
+      stat->nr_vcsw++;
+    }
+  else if (tcb->task_state != TSTATE_TASK_RUNNING)
+    {
+      /* Preempted or yielding, the wait for the CPU starts now */
+
+      stat->nr_ivcsw++;
+      stat->stamp = now;
+
+      if (current_task(this_cpu())->sched_priority > tcb->sched_priority)
+        {
+          stat->nr_preempt++;
+        }
+    }
+}
+
+/****************************************************************************
+ * Name: nxsched_schedstat_resume
+ *
+ * Description:
+ *   Called when 'tcb' starts running on this CPU.  Accounts the time it
+ *   waited for the CPU.
+ *
+ ****************************************************************************/
+
+void nxsched_schedstat_resume(FAR struct tcb_s *tcb)
+{
+  FAR struct schedstat_s *stat = &tcb->schedstat;
+  clock_t now = perf_gettime();
+  clock_t wait;
+
+  if (stat->stamp != 0)
+    {
+      wait = now - stat->stamp;
+      stat->wait_time += wait;
+      if (wait > stat->wait_max)
+        {
+          stat->wait_max = wait;
+        }
+    }
+
+#ifdef CONFIG_SMP
+  if (stat->nr_run > 0 && stat->cpu != this_cpu())
+    {
+      stat->nr_migrate++;
+    }
+
+  stat->cpu = this_cpu();
+#endif
+
+  stat->stamp = now;
+  stat->nr_run++;
+}
+
+#endif /* CONFIG_SCHED_SCHEDSTAT */
@@ -30,6 +30,7 @@
 #include <nuttx/arch.h>
 #include <nuttx/sched.h>
 #include <nuttx/clock.h>
+#include <nuttx/perf.h>
 #include <nuttx/sched_note.h>
 
 #include "clock/clock.h"
@@ -73,6 +74,15 @@ void nxsched_suspend_scheduler(FAR struct tcb_s *tcb)
 #ifdef CONFIG_SCHED_CRITMONITOR
   nxsched_suspend_critmon(tcb);
 #endif
+#ifdef CONFIG_PERF_EVENTS
+  perf_event_suspend(tcb);
+#endif
+#ifdef CONFIG_SCHED_LATENCYMONITOR
+  tcb->wakeup_start = 0;
+#endif
+#ifdef CONFIG_SCHED_SCHEDSTAT
+  nxsched_schedstat_suspend(tcb);
+#endif
 #ifdef CONFIG_SCHED_INSTRUMENTATION
   sched_note_suspend(tcb);
 #endif
@@ -0,0 +1,226 @@
+/****************************************************************************
+ * sched/sched/sched_syscallstat.c
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <sys/types.h>
+#include <stdatomic.h>
+#include <stdint.h>
+#include <string.h>
+#include <strings.h>
+#include <assert.h>
+#include <time.h>
+
+#include <nuttx/clock.h>
+#include <nuttx/irq.h>
+#include <nuttx/sched.h>
+#include <nuttx/seqlock.h>
+
+#include <syscall.h>
+
+#include "sched/sched.h"
+
+#ifdef CONFIG_SCHED_SYSCALLSTAT
+
+/****************************************************************************
+ * Private Types
+ ****************************************************************************/
+
+/* The statistics of the system calls made on a CPU.  Only the CPU updates
+ * them, with interrupts disabled, so that system calls made on different
+ * CPUs do not contend.  The sequence count lets nxsched_syscall_snapshot()
+ * read them from another CPU without tearing the 64-bit values.
+ */
+
+struct syscallstat_cpu_s
+{
+  seqcount_t seq;                        /* Changes with every update */
+  unsigned int gen;                      /* Generation of the statistics */
+  struct syscallstat_s stats[SYS_nsyscalls];
+};
+
+/****************************************************************************
+ * Private Data
+ ****************************************************************************/
+
+static struct syscallstat_cpu_s g_syscallstat[CONFIG_SMP_NCPUS];
+
+/* Incremented by nxsched_syscall_reset().  A CPU whose statistics are of
+ * an older generation clears them before its next update.
+ */
+
+static atomic_uint g_syscallstat_gen;
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: nxsched_syscall_stat
+ *
+ * Description:
+ *   Called by the system call wrappers when the system call 'nr', entered
+ *   at time 'start', returns.
+ *
+ ****************************************************************************/
+
+void nxsched_syscall_stat(int nr, clock_t start)
+{
+  FAR struct syscallstat_cpu_s *cpu;
+  FAR struct syscallstat_s *stat;
+  FAR struct tcb_s *rtcb;
+  clock_t elapsed = perf_gettime() - start;
+  unsigned int gen;
+  struct timespec ts;
+  uint64_t usec;
+  irqstate_t flags;
+  int bucket;
+
+  nr -= CONFIG_SYS_RESERVED;
+  DEBUGASSERT(nr >= 0 && nr < SYS_nsyscalls);
+
+  perf_convert(elapsed, &ts);
+  usec   = (uint64_t)ts.tv_sec * USEC_PER_SEC + ts.tv_nsec / NSEC_PER_USEC;
+  bucket = usec > 0 ? flsll(usec) - 1 : 0;
+  if (bucket >= SYSCALLSTAT_NBUCKETS)
+    {
+      bucket = SYSCALLSTAT_NBUCKETS - 1;
+    }
+
+  /* Stay on this CPU while its statistics are updated */
+
+  flags = up_irq_save();
+  cpu   = &g_syscallstat[this_cpu()];
+  gen   = atomic_load(&g_syscallstat_gen);
+
+  write_seqcount_begin(&cpu->seq);
+
+  if (cpu->gen != gen)
+    {
+      memset(cpu->stats, 0, sizeof(cpu->stats));
+      cpu->gen = gen;
+    }
+
+  stat = &cpu->stats[nr];
+  stat->count++;
+  stat->time += elapsed;
+  stat->hist[bucket]++;
+  if (elapsed > stat->max)
+    {
+      stat->max = elapsed;
+    }
+
+  write_seqcount_end(&cpu->seq);
+
+  /* Only the thread itself updates its own statistics */
+
+  rtcb = this_task();
+  rtcb->syscall_count++;
+  rtcb->syscall_time += elapsed;
+  if (elapsed > rtcb->syscall_max)
+    {
+      rtcb->syscall_max = elapsed;
+    }
+
+  up_irq_restore(flags);
+}
+
+/****************************************************************************
+ * Name: nxsched_syscall_snapshot
+ *
+ * Description:
+ *   Copy the statistics of the first 'nstats' system calls, indexed by
+ *   system call number less CONFIG_SYS_RESERVED, to 'stats', adding up the
+ *   statistics of the CPUs.
+ *
+ ****************************************************************************/
+
+void nxsched_syscall_snapshot(FAR struct syscallstat_s *stats, int nstats)
+{
+  FAR struct syscallstat_cpu_s *cpu;
+  struct syscallstat_s stat;
+  unsigned int gen = atomic_load(&g_syscallstat_gen);
+  unsigned int seq;
+  int ncpu;
+  int nr;
+  int i;
+
+  if (nstats > SYS_nsyscalls)
+    {
+      nstats = SYS_nsyscalls;
+    }
+
+  memset(stats, 0, nstats * sizeof(struct syscallstat_s));
+
+  for (ncpu = 0; ncpu < CONFIG_SMP_NCPUS; ncpu++)
+    {
+      cpu = &g_syscallstat[ncpu];
+
+      for (nr = 0; nr < nstats; nr++)
+        {
+          do
+            {
+              seq  = read_seqcount_begin(&cpu->seq);
+              stat = cpu->stats[nr];
+              if (cpu->gen != gen)
+                {
+                  stat.count = 0;
+                }
+            }
+          while (read_seqcount_retry(&cpu->seq, seq));
+
+          if (stat.count == 0)
+            {
+              continue;
+            }
+
+          stats[nr].count += stat.count;
+          stats[nr].time  += stat.time;
+          if (stat.max > stats[nr].max)
+            {
+              stats[nr].max = stat.max;
+            }
+
+          for (i = 0; i < SYSCALLSTAT_NBUCKETS; i++)
+            {
+              stats[nr].hist[i] += stat.hist[i];
+            }
+        }
+    }
+}
+
+/****************************************************************************
+ * Name: nxsched_syscall_reset
+ *
+ * Description:
+ *   Clear the statistics of all system calls.
+ *
+ ****************************************************************************/
+
+void nxsched_syscall_reset(void)
+{
+  atomic_fetch_add(&g_syscallstat_gen, 1);
+}
+
+#endif /* CONFIG_SCHED_SYSCALLSTAT */
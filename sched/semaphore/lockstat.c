@@ -0,0 +1,538 @@
+/****************************************************************************
+ * sched/semaphore/lockstat.c
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <sys/types.h>
+#include <stdatomic.h>
+#include <stdint.h>
+#include <string.h>
+
+#include <nuttx/clock.h>
+#include <nuttx/irq.h>
+#include <nuttx/lockstat.h>
+#include <nuttx/seqlock.h>
+#include <nuttx/spinlock.h>
+
+#include "sched/sched.h"
+
+#ifdef CONFIG_SCHED_LOCKSTAT
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+#define LOCKSTAT_NCLASSES CONFIG_SCHED_LOCKSTAT_NCLASSES
+
+/* Number of slots probed for the class of a key.  When they are all taken,
+ * the least used class among them is evicted.
+ */
+
+#define LOCKSTAT_NPROBES  8
+
+/* Number of spinlocks whose hold time is tracked per CPU */
+
+#define LOCKSTAT_NHELD    8
+
+/****************************************************************************
+ * Private Types
+ ****************************************************************************/
+
+/* A spinlock held by a CPU */
+
+struct lockstat_held_s
+{
+  FAR volatile spinlock_t *lock;    /* The spinlock */
+  clock_t start;                    /* Time it was acquired */
+};
+
+/* The statistics of a CPU.  Only the CPU updates them, with interrupts
+ * disabled, so that locks are accounted without a global lock.  The
+ * sequence count lets lockstat_snapshot() read them from another CPU.
+ */
+
+struct lockstat_cpu_s
+{
+  seqcount_t seq;                   /* Changes with every update */
+  unsigned int gen;                 /* Generation of the classes */
+  int nheld;                        /* Number of entries in 'held' */
+  struct lockstat_held_s held[LOCKSTAT_NHELD];
+  struct lockstat_class_s classes[LOCKSTAT_NCLASSES];
+};
+
+/****************************************************************************
+ * Private Data
+ ****************************************************************************/
+
+static struct lockstat_cpu_s g_lockstat[CONFIG_SMP_NCPUS];
+
+/* Incremented by lockstat_reset().  A CPU whose classes are of an older
+ * generation clears them before its next update.
+ */
+
+static atomic_uint g_lockstat_gen;
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: lockstat_begin
+ *
+ * Description:
+ *   Start an update of the statistics of this CPU.
+ *
+ * Assumptions:
+ *   Interrupts are disabled.
+ *
+ ****************************************************************************/
+
+static FAR struct lockstat_cpu_s *lockstat_begin(void)
+{
+  FAR struct lockstat_cpu_s *stat = &g_lockstat[this_cpu()];
+  unsigned int gen = atomic_load(&g_lockstat_gen);
+
+  write_seqcount_begin(&stat->seq);
+
+  if (stat->gen != gen)
+    {
+      memset(stat->classes, 0, sizeof(stat->classes));
+      stat->gen = gen;
+    }
+
+  return stat;
+}
+
+/****************************************************************************
+ * Name: lockstat_find
+ *
+ * Description:
+ *   Find the class of 'key' in the classes of a CPU, creating it if needed.
+ *
+ ****************************************************************************/
+
+static FAR struct lockstat_class_s *
+lockstat_find(FAR struct lockstat_cpu_s *stat, FAR const void *key,
+              uint8_t type)
+{
+  FAR struct lockstat_class_s *least = NULL;
+  FAR struct lockstat_class_s *cls;
+  unsigned int index;
+  int i;
+
+  index = ((uintptr_t)key >> 2) % LOCKSTAT_NCLASSES;
+  for (i = 0; i < LOCKSTAT_NPROBES; i++)
+    {
+      cls = &stat->classes[(index + i) % LOCKSTAT_NCLASSES];
+      if (cls->key == key && cls->type == type)
+        {
+          return cls;
+        }
+
+      if (least == NULL || cls->nacquired < least->nacquired)
+        {
+          least = cls;
+        }
+    }
+
+  /* Take the free or the least used slot, so that short-lived locks,
+   * allocated from the heap for example, cannot exhaust the classes.
+   */
+
+  memset(least, 0, sizeof(*least));
+  least->key  = key;
+  least->type = type;
+  return least;
+}
+
+/****************************************************************************
+ * Name: lockstat_waiter
+ *
+ * Description:
+ *   Account the time 'wait' waited by the thread 'pid' to a class.  The
+ *   class keeps the threads that waited the most: a thread that is not
+ *   among them replaces the one that waited the least, if it waited
+ *   longer.
+ *
+ ****************************************************************************/
+
+static void lockstat_waiter(FAR struct lockstat_class_s *cls, pid_t pid,
+                            clock_t wait)
+{
+  FAR struct lockstat_waiter_s *waiter;
+  FAR struct lockstat_waiter_s *least;
+  int i;
+
+  least = &cls->waiters[0];
+
+  for (i = 0; i < LOCKSTAT_NWAITERS; i++)
+    {
+      waiter = &cls->waiters[i];
+      if (waiter->wait_time > 0 && waiter->pid == pid)
+        {
+          waiter->wait_time += wait;
+          return;
+        }
+
+      if (waiter->wait_time < least->wait_time)
+        {
+          least = waiter;
+        }
+    }
+
+  if (wait > least->wait_time)
+    {
+      least->pid       = pid;
+      least->wait_time = wait;
+    }
+}
+
+/****************************************************************************
+ * Name: lockstat_wait
+ *
+ * Description:
+ *   Account an acquisition that started at 'start' to a class, and the
+ *   wait of the running thread if it was contended.
+ *
+ ****************************************************************************/
+
+static void lockstat_wait(FAR struct lockstat_class_s *cls, clock_t start,
+                          bool contended, clock_t now)
+{
+  clock_t wait;
+
+  cls->nacquired++;
+  if (!contended)
+    {
+      return;
+    }
+
+  wait = now - start;
+  cls->ncontended++;
+  cls->wait_time += wait;
+  if (wait > cls->wait_max)
+    {
+      cls->wait_max = wait;
+    }
+
+  lockstat_waiter(cls, this_task()->pid, wait);
+}
+
+/****************************************************************************
+ * Name: lockstat_hold
+ *
+ * Description:
+ *   Account the time a lock of the class was held.
+ *
+ ****************************************************************************/
+
+static void lockstat_hold(FAR struct lockstat_class_s *cls, clock_t hold)
+{
+  cls->hold_time += hold;
+  if (hold > cls->hold_max)
+    {
+      cls->hold_max = hold;
+    }
+}
+
+/****************************************************************************
+ * Name: lockstat_merge
+ *
+ * Description:
+ *   Add the statistics of the class 'src' to the class 'dest'.
+ *
+ ****************************************************************************/
+
+static void lockstat_merge(FAR struct lockstat_class_s *dest,
+                           FAR const struct lockstat_class_s *src)
+{
+  int i;
+
+  dest->nacquired  += src->nacquired;
+  dest->ncontended += src->ncontended;
+  dest->wait_time  += src->wait_time;
+  dest->hold_time  += src->hold_time;
+
+  if (src->wait_max > dest->wait_max)
+    {
+      dest->wait_max = src->wait_max;
+    }
+
+  if (src->hold_max > dest->hold_max)
+    {
+      dest->hold_max = src->hold_max;
+    }
+
+  for (i = 0; i < LOCKSTAT_NWAITERS; i++)
+    {
+      if (src->waiters[i].wait_time > 0)
+        {
+          lockstat_waiter(dest, src->waiters[i].pid,
+                          src->waiters[i].wait_time);
+        }
+    }
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: lockstat_init
+ *
+ * Description:
+ *   Attach a mutex to the class of its initialization site 'site'.
+ *
+ ****************************************************************************/
+
+void lockstat_init(FAR struct lockstat_s *stat, FAR const void *site)
+{
+  /* Without a site, the mutex is a class of its own */
+
+  stat->key        = site;
+  stat->hold_start = 0;
+}
+
+/****************************************************************************
+ * Name: lockstat_acquired
+ *
+ * Description:
+ *   Record the acquisition of a mutex whose acquisition started at 'start'.
+ *   'lock' identifies the class of a mutex that was not initialized by
+ *   lockstat_init().
+ *
+ ****************************************************************************/
+
+void lockstat_acquired(FAR struct lockstat_s *stat, FAR const void *lock,
+                       clock_t start, bool contended)
+{
+  FAR struct lockstat_cpu_s *cpu;
+  FAR struct lockstat_class_s *cls;
+  clock_t now = perf_gettime();
+  irqstate_t flags;
+
+  flags = up_irq_save();
+  cpu   = lockstat_begin();
+
+  cls = lockstat_find(cpu, stat->key != NULL ? stat->key : lock,
+                      LOCKSTAT_MUTEX);
+  lockstat_wait(cls, start, contended, now);
+  stat->hold_start = now;
+
+  write_seqcount_end(&cpu->seq);
+  up_irq_restore(flags);
+}
+
+/****************************************************************************
+ * Name: lockstat_released
+ *
+ * Description:
+ *   Record the release of a mutex.  'lock' is as for lockstat_acquired().
+ *
+ ****************************************************************************/
+
+void lockstat_released(FAR struct lockstat_s *stat, FAR const void *lock)
+{
+  FAR struct lockstat_cpu_s *cpu;
+  clock_t now = perf_gettime();
+  irqstate_t flags;
+
+  if (stat->hold_start == 0)
+    {
+      return;
+    }
+
+  /* The holder may have moved to another CPU, whose copy of the class
+   * receives the hold time.
+   */
+
+  flags = up_irq_save();
+  cpu   = lockstat_begin();
+
+  lockstat_hold(lockstat_find(cpu, stat->key != NULL ? stat->key : lock,
+                              LOCKSTAT_MUTEX),
+                now - stat->hold_start);
+  stat->hold_start = 0;
+
+  write_seqcount_end(&cpu->seq);
+  up_irq_restore(flags);
+}
+
+/****************************************************************************
+ * Name: lockstat_spin_acquired
+ *
+ * Description:
+ *   Record the acquisition of a spinlock.
+ *
+ ****************************************************************************/
+
+void lockstat_spin_acquired(FAR volatile spinlock_t *lock, clock_t start,
+                            bool contended)
+{
+  FAR struct lockstat_cpu_s *cpu;
+  clock_t now = perf_gettime();
+  irqstate_t flags;
+
+  flags = up_irq_save();
+  cpu   = lockstat_begin();
+
+  lockstat_wait(lockstat_find(cpu, (FAR const void *)lock,
+                              LOCKSTAT_SPINLOCK),
+                start, contended, now);
+
+  /* Remember when the lock was taken, on the stack of the spinlocks held
+   * by this CPU.  When it is full, the oldest entry is dropped: it belongs
+   * to a lock that will not be released here, if the holder migrated.
+   */
+
+  if (cpu->nheld == LOCKSTAT_NHELD)
+    {
+      memmove(&cpu->held[0], &cpu->held[1],
+              (LOCKSTAT_NHELD - 1) * sizeof(struct lockstat_held_s));
+      cpu->nheld--;
+    }
+
+  cpu->held[cpu->nheld].lock  = lock;
+  cpu->held[cpu->nheld].start = now;
+  cpu->nheld++;
+
+  write_seqcount_end(&cpu->seq);
+  up_irq_restore(flags);
+}
+
+/****************************************************************************
+ * Name: lockstat_spin_released
+ *
+ * Description:
+ *   Record the release of a spinlock.
+ *
+ ****************************************************************************/
+
+void lockstat_spin_released(FAR volatile spinlock_t *lock)
+{
+  FAR struct lockstat_cpu_s *cpu;
+  clock_t now = perf_gettime();
+  irqstate_t flags;
+  int i;
+
+  flags = up_irq_save();
+  cpu   = lockstat_begin();
+
+  for (i = cpu->nheld - 1; i >= 0; i--)
+    {
+      if (cpu->held[i].lock == lock)
+        {
+          lockstat_hold(lockstat_find(cpu, (FAR const void *)lock,
+                                      LOCKSTAT_SPINLOCK),
+                        now - cpu->held[i].start);
+
+          cpu->nheld--;
+          memmove(&cpu->held[i], &cpu->held[i + 1],
+                  (cpu->nheld - i) * sizeof(struct lockstat_held_s));
+          break;
+        }
+    }
+
+  write_seqcount_end(&cpu->seq);
+  up_irq_restore(flags);
+}
+
+/****************************************************************************
+ * Name: lockstat_snapshot
+ *
+ * Description:
+ *   Copy up to 'nclasses' lock classes to 'classes', adding up the
+ *   statistics of the CPUs.
+ *
+ * Returned Value:
+ *   The number of classes copied.
+ *
+ ****************************************************************************/
+
+int lockstat_snapshot(FAR struct lockstat_class_s *classes, int nclasses)
+{
+  FAR struct lockstat_cpu_s *cpu;
+  struct lockstat_class_s cls;
+  unsigned int gen = atomic_load(&g_lockstat_gen);
+  unsigned int seq;
+  int ncopied = 0;
+  int i;
+  int j;
+  int k;
+
+  for (i = 0; i < CONFIG_SMP_NCPUS; i++)
+    {
+      cpu = &g_lockstat[i];
+
+      for (j = 0; j < LOCKSTAT_NCLASSES; j++)
+        {
+          do
+            {
+              seq = read_seqcount_begin(&cpu->seq);
+              cls = cpu->classes[j];
+              if (cpu->gen != gen)
+                {
+                  cls.nacquired = 0;
+                }
+            }
+          while (read_seqcount_retry(&cpu->seq, seq));
+
+          if (cls.nacquired == 0)
+            {
+              continue;
+            }
+
+          for (k = 0; k < ncopied; k++)
+            {
+              if (classes[k].key == cls.key && classes[k].type == cls.type)
+                {
+                  lockstat_merge(&classes[k], &cls);
+                  break;
+                }
+            }
+
+          if (k == ncopied && ncopied < nclasses)
+            {
+              classes[ncopied++] = cls;
+            }
+        }
+    }
+
+  return ncopied;
+}
+
+/****************************************************************************
+ * Name: lockstat_reset
+ *
+ * Description:
+ *   Clear the statistics of all lock classes.
+ *
+ ****************************************************************************/
+
+void lockstat_reset(void)
+{
+  atomic_fetch_add(&g_lockstat_gen, 1);
+}
+
+#endif /* CONFIG_SCHED_LOCKSTAT */
@@ -0,0 +1,170 @@
+/****************************************************************************
+ * sched/semaphore/mutex_spin.c
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <sys/types.h>
+#include <stdbool.h>
+
+#include <nuttx/irq.h>
+#include <nuttx/mutex.h>
+#include <nuttx/semaphore.h>
+#include <nuttx/spinlock.h>
+
+#include "sched/sched.h"
+
+#ifdef CONFIG_MUTEX_SPIN
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+/* The number of polls between two checks that the owner is still running.
+ * The check takes the critical section, which the owner may need itself
+ * to release the mutex.
+ */
+
+#define MUTEX_SPIN_CHECK 16
+
+/****************************************************************************
+ * Public Data
+ ****************************************************************************/
+
+struct mutex_spin_s g_mutex_spin[CONFIG_SMP_NCPUS];
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: nxmutex_spin
+ *
+ * Description:
+ *   Spin while the mutex is locked by a thread running on another CPU, and
+ *   take it if it is released.  Spinning stops as soon as the owner is not
+ *   running, other threads wait for the mutex, or CONFIG_MUTEX_SPIN_COUNT
+ *   polls are done.
+ *
+ * Parameters:
+ *   mutex - mutex descriptor.
+ *
+ * Return Value:
+ *   true if the mutex was taken, false if the caller has to block.
+ *
+ ****************************************************************************/
+
+bool nxmutex_spin(FAR mutex_t *mutex)
+{
+  FAR volatile pid_t *pholder = &mutex->holder;
+  FAR struct tcb_s *owner;
+  irqstate_t flags;
+  pid_t checked = NXMUTEX_NO_HOLDER;
+  pid_t holder;
+  bool running;
+  bool taken = false;
+  bool spun = false;
+  int count;
+  int spin;
+
+  /* Other CPUs may need the critical section to release the mutex */
+
+  if (this_task()->irqcount > 0)
+    {
+      return false;
+    }
+
+  for (spin = 0; spin < CONFIG_MUTEX_SPIN_COUNT; spin++)
+    {
+      count = nxsem_count_get(&mutex->sem);
+      if (count > 0)
+        {
+          /* Released, another thread may still beat us to it */
+
+          if (nxsem_trywait(&mutex->sem) >= 0)
+            {
+              taken = true;
+              break;
+            }
+
+          continue;
+        }
+      else if (count < 0)
+        {
+          /* Threads already wait, the mutex will be handed to them */
+
+          break;
+        }
+
+      /* The owner sets the holder just after it takes the mutex and clears
+       * it just before it releases it, keep spinning in between.
+       */
+
+      holder = *pholder;
+      if (holder != NXMUTEX_NO_HOLDER &&
+          (holder != checked || spin % MUTEX_SPIN_CHECK == 0))
+        {
+          /* Look a new owner up at once, and the same owner again every
+           * MUTEX_SPIN_CHECK polls, within the critical section that keeps
+           * its TCB from being released while it is examined.
+           */
+
+          flags   = enter_critical_section();
+          owner   = nxsched_get_tcb(holder);
+          running = owner != NULL &&
+                    owner->task_state == TSTATE_TASK_RUNNING;
+          leave_critical_section(flags);
+
+          if (!running)
+            {
+              break;
+            }
+
+          checked = holder;
+        }
+
+      spun = true;
+      SP_DSB();
+    }
+
+  /* A mutex found unlocked at the first poll was not contended */
+
+  if (spun || !taken)
+    {
+      flags = up_irq_save();
+      if (taken)
+        {
+          g_mutex_spin[this_cpu()].nspin++;
+        }
+      else
+        {
+          g_mutex_spin[this_cpu()].nblock++;
+        }
+
+      up_irq_restore(flags);
+    }
+
+  return taken;
+}
+
+#endif /* CONFIG_MUTEX_SPIN */
@@ -99,6 +99,13 @@ int nxsem_clockwait(FAR sem_t *sem, clockid_t clockid,
   DEBUGASSERT(sem != NULL && abstime != NULL);
   DEBUGASSERT(up_interrupt_context() == false);
 
+  /* Take an uncontended count without entering the critical section */
+
+  if (nxsem_trywait_fast(sem))
+    {
+      return OK;
+    }
+
   /* We will disable interrupts until we have completed the semaphore
    * wait.  We need to do this (as opposed to just disabling pre-emption)
    * because there could be interrupt handlers that are asynchronously
@@ -88,6 +88,12 @@ nxsem_allocholder(FAR sem_t *sem, FAR struct tcb_s *htcb)
 
       g_freeholders  = pholder->flink;
       pholder->flink = sem->hhead;
+      pholder->blink = NULL;
+      if (sem->hhead != NULL)
+        {
+          sem->hhead->blink = pholder;
+        }
+
       sem->hhead     = pholder;
     }
 #else
@@ -109,6 +115,12 @@ nxsem_allocholder(FAR sem_t *sem, FAR struct tcb_s *htcb)
   /* Put it into the task's list */
 
   pholder->tlink  = htcb->holdsem;
+  pholder->tblink = NULL;
+  if (htcb->holdsem != NULL)
+    {
+      htcb->holdsem->tblink = pholder;
+    }
+
   htcb->holdsem   = pholder;
 
   return pholder;
@@ -183,24 +195,28 @@ nxsem_findorallocateholder(FAR sem_t *sem, FAR struct tcb_s *htcb)
 static inline void nxsem_freeholder(FAR sem_t *sem,
                                     FAR struct semholder_s *pholder)
 {
-  FAR struct semholder_s * FAR *curr;
+  /* Remove the holder from the task's list.  Both lists are doubly linked
+   * so that a thread holding many semaphores does not have to walk them.
+   */
 
-  /* Remove the holder from the task's list */
+  if (pholder->tblink != NULL)
+    {
+      pholder->tblink->tlink = pholder->tlink;
+    }
+  else if (pholder->htcb->holdsem == pholder)
+    {
+      pholder->htcb->holdsem = pholder->tlink;
+    }
 
-  for (curr = &pholder->htcb->holdsem;
-       *curr != NULL;
-       curr = &(*curr)->tlink)
+  if (pholder->tlink != NULL)
     {
-      if (*curr == pholder)
-        {
-          *curr = pholder->tlink;
-          break;
-        }
+      pholder->tlink->tblink = pholder->tblink;
     }
 
   /* Release the holder and counts */
 
   pholder->tlink  = NULL;
+  pholder->tblink = NULL;
   pholder->sem    = NULL;
   pholder->htcb   = NULL;
   pholder->counts = 0;
@@ -208,19 +224,23 @@ static inline void nxsem_freeholder(FAR sem_t *sem,
 #if CONFIG_SEM_PREALLOCHOLDERS > 0
   /* Remove the holder from the semaphore's list */
 
-  for (curr = &sem->hhead;
-       *curr != NULL;
-       curr = &(*curr)->flink)
+  if (pholder->blink != NULL)
     {
-      if (*curr == pholder)
-        {
-          *curr = pholder->flink;
-          break;
-        }
+      pholder->blink->flink = pholder->flink;
+    }
+  else if (sem->hhead == pholder)
+    {
+      sem->hhead = pholder->flink;
+    }
+
+  if (pholder->flink != NULL)
+    {
+      pholder->flink->blink = pholder->blink;
     }
 
   /* And put it in the free list */
 
+  pholder->blink = NULL;
   pholder->flink = g_freeholders;
   g_freeholders  = pholder;
 #endif
@@ -983,7 +1003,7 @@ void nxsem_release_all(FAR struct tcb_s *htcb)
        * that was taken by sem_wait() or sem_post().
        */
 
-      sem->semcount++;
+      nxsem_count_inc(sem);
     }
 }
 
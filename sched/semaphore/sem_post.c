@@ -78,6 +78,15 @@ int nxsem_post(FAR sem_t *sem)
 
   DEBUGASSERT(sem != NULL);
 
+  /* Give back the count without entering the critical section if nobody
+   * waits for it.
+   */
+
+  if (nxsem_post_fast(sem))
+    {
+      return OK;
+    }
+
   /* The following operations must be performed with interrupts
    * disabled because sem_post() may be called from an interrupt
    * handler.
@@ -85,18 +94,25 @@ int nxsem_post(FAR sem_t *sem)
 
   flags = enter_critical_section();
 
-  sem_count = sem->semcount;
-
-  /* Check the maximum allowable value */
+  /* Increment the count, unless it is at the maximum allowable value.  The
+   * count may be changed concurrently by a fast path.
+   */
 
-  if (sem_count >= SEM_VALUE_MAX)
+  sem_count = nxsem_count_get(sem);
+  do
     {
-      leave_critical_section(flags);
-      return -EOVERFLOW;
+      if (sem_count >= SEM_VALUE_MAX)
+        {
+          leave_critical_section(flags);
+          return -EOVERFLOW;
+        }
     }
+  while (!nxsem_count_cmpxchg(sem, &sem_count, sem_count + 1));
 
-  /* Perform the semaphore unlock operation, releasing this task as a
-   * holder then also incrementing the count on the semaphore.
+  sem_count++;
+
+  /* Complete the semaphore unlock operation, releasing this task as a
+   * holder of the count given back above.
    *
    * NOTE:  When semaphores are used for signaling purposes, the holder
    * of the semaphore may not be this thread!  In this case,
@@ -113,8 +129,6 @@ int nxsem_post(FAR sem_t *sem)
    */
 
   nxsem_release_holder(sem);
-  sem_count++;
-  sem->semcount = sem_count;
 
 #ifdef CONFIG_PRIORITY_INHERITANCE
   /* Don't let any unblocked tasks run until we complete any priority
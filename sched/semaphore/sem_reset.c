@@ -96,9 +96,9 @@ int nxsem_reset(FAR sem_t *sem, int16_t count)
    * value of sem->semcount is already correct in this case.
    */
 
-  if (sem->semcount >= 0)
+  if (nxsem_count_get(sem) >= 0)
     {
-      sem->semcount = count;
+      nxsem_count_set(sem, count);
     }
 
   /* Allow any pending context switches to occur now */
@@ -68,6 +68,7 @@ int nxsem_trywait(FAR sem_t *sem)
 {
   FAR struct tcb_s *rtcb = this_task();
   irqstate_t flags;
+  short count;
   int ret;
 
   /* This API should not be called from the idleloop */
@@ -76,28 +77,36 @@ int nxsem_trywait(FAR sem_t *sem)
   DEBUGASSERT(!OSINIT_IDLELOOP() || !sched_idletask() ||
               up_interrupt_context());
 
+  /* Take an uncontended count without entering the critical section */
+
+  if (nxsem_trywait_fast(sem))
+    {
+      return OK;
+    }
+
   /* The following operations must be performed with interrupts disabled
    * because sem_post() may be called from an interrupt handler.
    */
 
   flags = enter_critical_section();
 
-  /* If the semaphore is available, give it to the requesting task */
-
-  if (sem->semcount > 0)
-    {
-      /* It is, let the task take the semaphore */
+  /* If the semaphore is available, give it to the requesting task.  The
+   * count may be changed concurrently by a fast path.
+   */
 
-      sem->semcount--;
-      nxsem_add_holder(sem);
-      rtcb->waitobj = NULL;
-      ret = OK;
-    }
-  else
+  ret   = -EAGAIN;
+  count = nxsem_count_get(sem);
+  while (count > 0)
     {
-      /* Semaphore is not available */
-
-      ret = -EAGAIN;
+      if (nxsem_count_cmpxchg(sem, &count, count - 1))
+        {
+          /* It is, let the task take the semaphore */
+
+          nxsem_add_holder(sem);
+          rtcb->waitobj = NULL;
+          ret = OK;
+          break;
+        }
     }
 
   /* Interrupts may now be enabled. */
@@ -79,6 +79,13 @@ int nxsem_wait(FAR sem_t *sem)
   DEBUGASSERT(sem != NULL && up_interrupt_context() == false);
   DEBUGASSERT(!OSINIT_IDLELOOP() || !sched_idletask());
 
+  /* Take an uncontended count without entering the critical section */
+
+  if (nxsem_trywait_fast(sem))
+    {
+      return OK;
+    }
+
   /* The following operations must be performed with interrupts
    * disabled because nxsem_post() may be called from an interrupt
    * handler.
@@ -86,15 +93,14 @@ int nxsem_wait(FAR sem_t *sem)
 
   flags = enter_critical_section();
 
-  /* Make sure we were supplied with a valid semaphore. */
-
-  /* Check if the lock is available */
+  /* Take a count, or a place in the line of waiters.  The count may have
+   * been changed by a fast path since it was checked above.
+   */
 
-  if (sem->semcount > 0)
+  if (nxsem_count_dec(sem) > 0)
     {
-      /* It is, let the task take the semaphore. */
+      /* It was available, let the task take the semaphore. */
 
-      sem->semcount--;
       nxsem_add_holder(sem);
       rtcb->waitobj = NULL;
       ret = OK;
@@ -116,10 +122,6 @@ int nxsem_wait(FAR sem_t *sem)
 
       DEBUGASSERT(rtcb->waitobj == NULL);
 
-      /* Handle the POSIX semaphore (but don't set the owner yet) */
-
-      sem->semcount--;
-
       /* Save the waited on semaphore in the TCB */
 
       rtcb->waitobj = sem;
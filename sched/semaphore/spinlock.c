@@ -29,11 +29,14 @@
 #include <sched.h>
 #include <assert.h>
 
+#include <nuttx/clock.h>
+#include <nuttx/lockstat.h>
 #include <nuttx/spinlock.h>
 #include <nuttx/sched_note.h>
 #include <arch/irq.h>
 
-#if defined(CONFIG_TICKET_SPINLOCK) || defined(CONFIG_RW_SPINLOCK)
+#if defined(CONFIG_TICKET_SPINLOCK) || defined(CONFIG_MCS_SPINLOCK) || \
+    defined(CONFIG_RW_SPINLOCK)
 #  include <stdatomic.h>
 #endif
 
@@ -41,6 +44,127 @@
 
 #if defined(CONFIG_SPINLOCK) || defined(CONFIG_TICKET_SPINLOCK)
 
+#ifdef CONFIG_MCS_SPINLOCK
+
+/****************************************************************************
+ * Private Types
+ ****************************************************************************/
+
+/* The queue node of a CPU waiting for a MCS spinlock.  A CPU waits for one
+ * spinlock at a time with interrupts disabled, so one node per CPU is
+ * enough.  Nodes are named by 1 + their CPU index, 0 meaning none.
+ */
+
+struct mcs_node_s
+{
+  atomic_ushort next;        /* Node of the next waiter */
+  atomic_uchar  locked;      /* Set when the waiter heads the queue */
+};
+
+/****************************************************************************
+ * Private Data
+ ****************************************************************************/
+
+static struct mcs_node_s g_mcs_node[CONFIG_SMP_NCPUS];
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: spin_trylock_mcs
+ *
+ * Description:
+ *   Take a MCS spinlock if it is free and nobody waits for it.
+ *
+ ****************************************************************************/
+
+static inline bool spin_trylock_mcs(FAR volatile spinlock_t *lock)
+{
+  spinlock_t old = SP_UNLOCKED;
+  spinlock_t new = SP_LOCKED;
+
+  return atomic_compare_exchange_strong((FAR atomic_uint *)&lock->value,
+                                        &old.value, new.value);
+}
+
+/****************************************************************************
+ * Name: spin_lock_mcs
+ *
+ * Description:
+ *   Queue up for a contended MCS spinlock and take it.  The waiters queue
+ *   in arrival order.  Each one polls its own node until its predecessor
+ *   makes it the head of the queue; only the head polls the lock itself.
+ *
+ ****************************************************************************/
+
+static void spin_lock_mcs(FAR volatile spinlock_t *lock)
+{
+  FAR struct mcs_node_s *node;
+  irqstate_t flags;
+  spinlock_t old = SP_UNLOCKED;
+  spinlock_t new = SP_LOCKED;
+  unsigned short prev;
+  unsigned short next;
+  unsigned short tail;
+
+  /* The node belongs to this CPU as long as we are queued */
+
+  flags = up_irq_save();
+  tail  = this_cpu() + 1;
+  node  = &g_mcs_node[tail - 1];
+
+  atomic_store(&node->next, 0);
+  atomic_store(&node->locked, 0);
+
+  prev = atomic_exchange((FAR atomic_ushort *)&lock->mcs.tail, tail);
+  if (prev != 0)
+    {
+      /* Link behind the previous waiter and wait for our turn */
+
+      atomic_store(&g_mcs_node[prev - 1].next, tail);
+      while (atomic_load(&node->locked) == 0)
+        {
+          SP_DSB();
+          SP_WFE();
+        }
+    }
+
+  /* We head the queue, wait for the owner to release the lock */
+
+  while (atomic_load((FAR atomic_uchar *)&lock->mcs.locked) != 0)
+    {
+      SP_DSB();
+      SP_WFE();
+    }
+
+  /* Take the lock, and empty the queue if we are the last waiter.  Nobody
+   * else may take the lock while the queue is not empty.
+   */
+
+  old.mcs.tail = tail;
+  if (!atomic_compare_exchange_strong((FAR atomic_uint *)&lock->value,
+                                      &old.value, new.value))
+    {
+      atomic_store((FAR atomic_uchar *)&lock->mcs.locked, 1);
+
+      /* Make the next waiter the head, once it has linked itself */
+
+      while ((next = atomic_load(&node->next)) == 0)
+        {
+          SP_DSB();
+        }
+
+      atomic_store(&g_mcs_node[next - 1].locked, 1);
+      SP_DSB();
+      SP_SEV();
+    }
+
+  up_irq_restore(flags);
+}
+
+#endif /* CONFIG_MCS_SPINLOCK */
+
 /****************************************************************************
  * Public Functions
  ****************************************************************************/
@@ -70,13 +194,20 @@
 
 void spin_lock(FAR volatile spinlock_t *lock)
 {
+#ifdef CONFIG_SCHED_LOCKSTAT
+  clock_t start = perf_gettime();
+  bool contended = false;
+#endif
+
 #ifdef CONFIG_SCHED_INSTRUMENTATION_SPINLOCKS
   /* Notify that we are waiting for a spinlock */
 
   sched_note_spinlock(this_task(), lock, NOTE_SPINLOCK_LOCK);
 #endif
 
-#ifdef CONFIG_TICKET_SPINLOCK
+#if defined(CONFIG_MCS_SPINLOCK)
+  if (!spin_trylock_mcs(lock))
+#elif defined(CONFIG_TICKET_SPINLOCK)
   unsigned short ticket =
     atomic_fetch_add((FAR atomic_ushort *)&lock->tickets.next, 1);
   while (atomic_load((FAR atomic_ushort *)&lock->tickets.owner) != ticket)
@@ -84,8 +215,15 @@ void spin_lock(FAR volatile spinlock_t *lock)
   while (up_testset(lock) == SP_LOCKED)
 #endif
     {
+#ifdef CONFIG_SCHED_LOCKSTAT
+      contended = true;
+#endif
+#ifdef CONFIG_MCS_SPINLOCK
+      spin_lock_mcs(lock);
+#else
       SP_DSB();
       SP_WFE();
+#endif
     }
 
 #ifdef CONFIG_SCHED_INSTRUMENTATION_SPINLOCKS
@@ -94,6 +232,10 @@ void spin_lock(FAR volatile spinlock_t *lock)
   sched_note_spinlock(this_task(), lock, NOTE_SPINLOCK_LOCKED);
 #endif
   SP_DMB();
+
+#ifdef CONFIG_SCHED_LOCKSTAT
+  lockstat_spin_acquired(lock, start, contended);
+#endif
 }
 
 /****************************************************************************
@@ -120,6 +262,12 @@ void spin_lock(FAR volatile spinlock_t *lock)
 
 void spin_lock_wo_note(FAR volatile spinlock_t *lock)
 {
+#if defined(CONFIG_MCS_SPINLOCK)
+  if (!spin_trylock_mcs(lock))
+    {
+      spin_lock_mcs(lock);
+    }
+#else
 #ifdef CONFIG_TICKET_SPINLOCK
   unsigned short ticket =
     atomic_fetch_add((FAR atomic_ushort *)&lock->tickets.next, 1);
@@ -131,6 +279,7 @@ void spin_lock_wo_note(FAR volatile spinlock_t *lock)
       SP_DSB();
       SP_WFE();
     }
+#endif /* CONFIG_MCS_SPINLOCK */
 
   SP_DMB();
 }
@@ -182,6 +331,8 @@ bool spin_trylock(FAR volatile spinlock_t *lock)
 
   if (!atomic_compare_exchange_strong((FAR atomic_uint *)&lock->value,
                                       &old.value, new.value))
+#elif defined(CONFIG_MCS_SPINLOCK)
+  if (!spin_trylock_mcs(lock))
 #else /* CONFIG_TICKET_SPINLOCK */
   if (up_testset(lock) == SP_LOCKED)
 #endif /* CONFIG_TICKET_SPINLOCK */
@@ -201,6 +352,10 @@ bool spin_trylock(FAR volatile spinlock_t *lock)
   sched_note_spinlock(this_task(), lock, NOTE_SPINLOCK_LOCKED);
 #endif
   SP_DMB();
+
+#ifdef CONFIG_SCHED_LOCKSTAT
+  lockstat_spin_acquired(lock, perf_gettime(), false);
+#endif
   return true;
 }
 
@@ -248,6 +403,8 @@ bool spin_trylock_wo_note(FAR volatile spinlock_t *lock)
 
   if (!atomic_compare_exchange_strong((FAR atomic_uint *)&lock->value,
                                       &old.value, new.value))
+#elif defined(CONFIG_MCS_SPINLOCK)
+  if (!spin_trylock_mcs(lock))
 #else /* CONFIG_TICKET_SPINLOCK */
   if (up_testset(lock) == SP_LOCKED)
 #endif /* CONFIG_TICKET_SPINLOCK */
@@ -280,6 +437,10 @@ bool spin_trylock_wo_note(FAR volatile spinlock_t *lock)
 #ifdef __SP_UNLOCK_FUNCTION
 void spin_unlock(FAR volatile spinlock_t *lock)
 {
+#ifdef CONFIG_SCHED_LOCKSTAT
+  lockstat_spin_released(lock);
+#endif
+
 #ifdef CONFIG_SCHED_INSTRUMENTATION_SPINLOCKS
   /* Notify that we are unlocking the spinlock */
 
@@ -287,8 +448,10 @@ void spin_unlock(FAR volatile spinlock_t *lock)
 #endif
 
   SP_DMB();
-#ifdef CONFIG_TICKET_SPINLOCK
+#if defined(CONFIG_TICKET_SPINLOCK)
   atomic_fetch_add((FAR atomic_ushort *)&lock->tickets.owner, 1);
+#elif defined(CONFIG_MCS_SPINLOCK)
+  atomic_store((FAR atomic_uchar *)&lock->mcs.locked, 0);
 #else
   *lock = SP_UNLOCKED;
 #endif
@@ -320,8 +483,10 @@ void spin_unlock(FAR volatile spinlock_t *lock)
 void spin_unlock_wo_note(FAR volatile spinlock_t *lock)
 {
   SP_DMB();
-#ifdef CONFIG_TICKET_SPINLOCK
+#if defined(CONFIG_TICKET_SPINLOCK)
   atomic_fetch_add((FAR atomic_ushort *)&lock->tickets.owner, 1);
+#elif defined(CONFIG_MCS_SPINLOCK)
+  atomic_store((FAR atomic_uchar *)&lock->mcs.locked, 0);
 #else
   *lock = SP_UNLOCKED;
 #endif
@@ -481,6 +646,13 @@ void spin_clrbit(FAR volatile cpu_set_t *set, unsigned int cpu,
 
 void read_lock(FAR volatile rwlock_t *lock)
 {
+#ifdef CONFIG_SCHED_INSTRUMENTATION_SPINLOCKS
+  /* Notify that we are waiting for a spinlock */
+
+  sched_note_spinlock(this_task(), (FAR volatile spinlock_t *)lock,
+                      NOTE_SPINLOCK_LOCK);
+#endif
+
   while (true)
     {
       int old = atomic_load((FAR atomic_int *)lock);
@@ -497,6 +669,12 @@ void read_lock(FAR volatile rwlock_t *lock)
         }
     }
 
+#ifdef CONFIG_SCHED_INSTRUMENTATION_SPINLOCKS
+  /* Notify that we have the spinlock */
+
+  sched_note_spinlock(this_task(), (FAR volatile spinlock_t *)lock,
+                      NOTE_SPINLOCK_LOCKED);
+#endif
   SP_DMB();
 }
 
@@ -526,12 +704,25 @@ void read_lock(FAR volatile rwlock_t *lock)
 
 bool read_trylock(FAR volatile rwlock_t *lock)
 {
+#ifdef CONFIG_SCHED_INSTRUMENTATION_SPINLOCKS
+  /* Notify that we are waiting for a spinlock */
+
+  sched_note_spinlock(this_task(), (FAR volatile spinlock_t *)lock,
+                      NOTE_SPINLOCK_LOCK);
+#endif
+
   while (true)
     {
       int old = atomic_load((FAR atomic_int *)lock);
       if (old <= RW_SP_WRITE_LOCKED)
         {
           DEBUGASSERT(old == RW_SP_WRITE_LOCKED);
+#ifdef CONFIG_SCHED_INSTRUMENTATION_SPINLOCKS
+          /* Notify that we abort for a spinlock */
+
+          sched_note_spinlock(this_task(), (FAR volatile spinlock_t *)lock,
+                              NOTE_SPINLOCK_ABORT);
+#endif
           return false;
         }
       else if (atomic_compare_exchange_strong((FAR atomic_int *)lock,
@@ -541,6 +732,12 @@ bool read_trylock(FAR volatile rwlock_t *lock)
         }
     }
 
+#ifdef CONFIG_SCHED_INSTRUMENTATION_SPINLOCKS
+  /* Notify that we have the spinlock */
+
+  sched_note_spinlock(this_task(), (FAR volatile spinlock_t *)lock,
+                      NOTE_SPINLOCK_LOCKED);
+#endif
   SP_DMB();
   return true;
 }
@@ -566,6 +763,13 @@ void read_unlock(FAR volatile rwlock_t *lock)
 {
   DEBUGASSERT(atomic_load((FAR atomic_int *)lock) >= RW_SP_READ_LOCKED);
 
+#ifdef CONFIG_SCHED_INSTRUMENTATION_SPINLOCKS
+  /* Notify that we are unlocking the spinlock */
+
+  sched_note_spinlock(this_task(), (FAR volatile spinlock_t *)lock,
+                      NOTE_SPINLOCK_UNLOCK);
+#endif
+
   SP_DMB();
   atomic_fetch_sub((FAR atomic_int *)lock, 1);
   SP_DSB();
@@ -601,13 +805,27 @@ void write_lock(FAR volatile rwlock_t *lock)
 {
   int zero = RW_SP_UNLOCKED;
 
+#ifdef CONFIG_SCHED_INSTRUMENTATION_SPINLOCKS
+  /* Notify that we are waiting for a spinlock */
+
+  sched_note_spinlock(this_task(), (FAR volatile spinlock_t *)lock,
+                      NOTE_SPINLOCK_LOCK);
+#endif
+
   while (!atomic_compare_exchange_strong((FAR atomic_int *)lock,
                                          &zero, RW_SP_WRITE_LOCKED))
     {
+      zero = RW_SP_UNLOCKED;
       SP_DSB();
       SP_WFE();
     }
 
+#ifdef CONFIG_SCHED_INSTRUMENTATION_SPINLOCKS
+  /* Notify that we have the spinlock */
+
+  sched_note_spinlock(this_task(), (FAR volatile spinlock_t *)lock,
+                      NOTE_SPINLOCK_LOCKED);
+#endif
   SP_DMB();
 }
 
@@ -640,13 +858,32 @@ bool write_trylock(FAR volatile rwlock_t *lock)
 {
   int zero = RW_SP_UNLOCKED;
 
+#ifdef CONFIG_SCHED_INSTRUMENTATION_SPINLOCKS
+  /* Notify that we are waiting for a spinlock */
+
+  sched_note_spinlock(this_task(), (FAR volatile spinlock_t *)lock,
+                      NOTE_SPINLOCK_LOCK);
+#endif
+
   if (atomic_compare_exchange_strong((FAR atomic_int *)lock,
                                      &zero, RW_SP_WRITE_LOCKED))
     {
+#ifdef CONFIG_SCHED_INSTRUMENTATION_SPINLOCKS
+      /* Notify that we have the spinlock */
+
+      sched_note_spinlock(this_task(), (FAR volatile spinlock_t *)lock,
+                          NOTE_SPINLOCK_LOCKED);
+#endif
       SP_DMB();
       return true;
     }
 
+#ifdef CONFIG_SCHED_INSTRUMENTATION_SPINLOCKS
+  /* Notify that we abort for a spinlock */
+
+  sched_note_spinlock(this_task(), (FAR volatile spinlock_t *)lock,
+                      NOTE_SPINLOCK_ABORT);
+#endif
   SP_DSB();
   return false;
 }
@@ -674,6 +911,13 @@ void write_unlock(FAR volatile rwlock_t *lock)
 
   DEBUGASSERT(atomic_load((FAR atomic_int *)lock) == RW_SP_WRITE_LOCKED);
 
+#ifdef CONFIG_SCHED_INSTRUMENTATION_SPINLOCKS
+  /* Notify that we are unlocking the spinlock */
+
+  sched_note_spinlock(this_task(), (FAR volatile spinlock_t *)lock,
+                      NOTE_SPINLOCK_UNLOCK);
+#endif
+
   SP_DMB();
   atomic_store((FAR atomic_int *)lock, RW_SP_UNLOCKED);
   SP_DSB();
@@ -120,6 +120,10 @@ static inline void wd_expiration(void)
 
       /* Execute the watchdog function */
 
+#ifdef CONFIG_SCHED_LATENCYMONITOR
+      nxsched_latency_wdog(wdog->lag);
+#endif
+
       up_setpicbase(wdog->picbase);
       CALL_FUNC(func, wdog->arg);
     }
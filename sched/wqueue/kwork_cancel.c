@@ -24,6 +24,7 @@
 
 #include <nuttx/config.h>
 
+#include <stdbool.h>
 #include <assert.h>
 #include <errno.h>
 
@@ -91,6 +92,7 @@ static int work_qcancel(FAR struct kwork_wqueue_s *wqueue, int nthread,
       else
         {
           dq_rem((FAR dq_entry_t *)work, &wqueue->q);
+          work_stat_removed(wqueue);
         }
 
       work->worker = NULL;
@@ -116,6 +118,36 @@ static int work_qcancel(FAR struct kwork_wqueue_s *wqueue, int nthread,
   return ret;
 }
 
+/****************************************************************************
+ * Name: work_cpucancel
+ *
+ * Description:
+ *   Cancel work queued with CPUWORK.  Pending work is on the queue of
+ *   work->cpu, but work that is running may have been stolen by the worker
+ *   thread of any CPU.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_SCHED_CPUWORK
+static int work_cpucancel(FAR struct work_s *work, bool sync)
+{
+  irqstate_t flags;
+  int ret;
+  int cpu;
+
+  flags = enter_critical_section();
+
+  ret = work_qcancel(&g_cpuwork[work->cpu], -1, work);
+  for (cpu = 0; sync && ret == -ENOENT && cpu < CONFIG_SMP_NCPUS; cpu++)
+    {
+      ret = work_qcancel(&g_cpuwork[cpu], 1, work);
+    }
+
+  leave_critical_section(flags);
+  return ret;
+}
+#endif
+
 /****************************************************************************
  * Public Functions
  ****************************************************************************/
@@ -162,6 +194,15 @@ int work_cancel(int qid, FAR struct work_s *work)
                           -1, work);
     }
   else
+#endif
+#ifdef CONFIG_SCHED_CPUWORK
+  if (qid == CPUWORK)
+    {
+      /* Cancel per-CPU work */
+
+      return work_cpucancel(work, false);
+    }
+  else
 #endif
     {
       return -EINVAL;
@@ -210,6 +251,15 @@ int work_cancel_sync(int qid, FAR struct work_s *work)
                           CONFIG_SCHED_LPNTHREADS, work);
     }
   else
+#endif
+#ifdef CONFIG_SCHED_CPUWORK
+  if (qid == CPUWORK)
+    {
+      /* Cancel per-CPU work */
+
+      return work_cpucancel(work, true);
+    }
+  else
 #endif
     {
       return -EINVAL;
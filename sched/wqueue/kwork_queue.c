@@ -34,6 +34,7 @@
 #include <nuttx/queue.h>
 #include <nuttx/wqueue.h>
 
+#include "sched/sched.h"
 #include "wqueue/wqueue.h"
 
 #ifdef CONFIG_SCHED_WORKQUEUE
@@ -47,6 +48,7 @@
     { \
       int sem_count; \
       dq_addlast((FAR dq_entry_t *)(work), &(wqueue).q); \
+      work_stat_queued(&(wqueue), (FAR struct work_s *)(work)); \
       nxsem_get_value(&(wqueue).sem, &sem_count); \
       if (sem_count < 0) /* There are threads waiting for sem. */ \
         { \
@@ -85,6 +87,55 @@ static void lp_work_timer_expiry(wdparm_t arg)
 }
 #endif
 
+/****************************************************************************
+ * Name: cpu_queue_work
+ *
+ * Description:
+ *   Queue work on the per-CPU queue of work->cpu.  If the worker thread of
+ *   that CPU is busy, wake up an idle worker thread of another CPU, which
+ *   will steal the work.  Called within a critical section.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_SCHED_CPUWORK
+static void cpu_queue_work(FAR struct work_s *work)
+{
+  FAR struct kwork_wqueue_s *wqueue = &g_cpuwork[work->cpu];
+#ifdef CONFIG_SCHED_CPUWORK_STEAL
+  int sem_count;
+  int cpu;
+#endif
+
+  queue_work(*wqueue, work);
+
+#ifdef CONFIG_SCHED_CPUWORK_STEAL
+  if (wqueue->worker[0].work != NULL)
+    {
+      for (cpu = 0; cpu < CONFIG_SMP_NCPUS; cpu++)
+        {
+          nxsem_get_value(&g_cpuwork[cpu].sem, &sem_count);
+          if (sem_count < 0)
+            {
+              nxsem_post(&g_cpuwork[cpu].sem);
+              break;
+            }
+        }
+    }
+#endif
+}
+
+/****************************************************************************
+ * Name: cpu_work_timer_expiry
+ ****************************************************************************/
+
+static void cpu_work_timer_expiry(wdparm_t arg)
+{
+  irqstate_t flags = enter_critical_section();
+  cpu_queue_work((FAR struct work_s *)arg);
+  leave_critical_section(flags);
+}
+#endif
+
 /****************************************************************************
  * Public Functions
  ****************************************************************************/
@@ -105,7 +156,9 @@ static void lp_work_timer_expiry(wdparm_t arg)
  *   pending work will be canceled and lost.
  *
  * Input Parameters:
- *   qid    - The work queue ID (index)
+ *   qid    - The work queue ID (index).  Work queued with CPUWORK is
+ *            performed by the worker thread of the calling CPU, unless it
+ *            is stolen by an idle CPU.
  *   work   - The work structure to queue
  *   worker - The worker callback to be invoked.  The callback will be
  *            invoked on the worker thread of execution.
@@ -178,6 +231,24 @@ int work_queue(int qid, FAR struct work_s *work, worker_t worker,
         }
     }
   else
+#endif
+#ifdef CONFIG_SCHED_CPUWORK
+  if (qid == CPUWORK)
+    {
+      /* Queue the work on the queue of this CPU, also when it is delayed */
+
+      work->cpu = this_cpu();
+      if (!delay)
+        {
+          cpu_queue_work(work);
+        }
+      else
+        {
+          wd_start(&work->u.timer, delay, cpu_work_timer_expiry,
+                   (wdparm_t)work);
+        }
+    }
+  else
 #endif
     {
       ret = -EINVAL;
@@ -97,10 +97,129 @@ struct lp_wqueue_s g_lpwork =
 
 #endif /* CONFIG_SCHED_LPWORK */
 
+#if defined(CONFIG_SCHED_CPUWORK)
+/* The state of the kernel mode, per-CPU work queues. */
+
+struct kwork_wqueue_s g_cpuwork[CONFIG_SMP_NCPUS];
+
+#endif /* CONFIG_SCHED_CPUWORK */
+
 /****************************************************************************
  * Private Functions
  ****************************************************************************/
 
+/****************************************************************************
+ * Name: work_stat_run
+ *
+ * Description:
+ *   Account one work that waited 'wait' and ran for 'run'.  Called within
+ *   a critical section.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_SCHED_WORKQUEUE_STATS
+static void work_stat_run(FAR struct kwork_wqueue_s *wqueue, clock_t wait,
+                          clock_t run)
+{
+  FAR struct work_stat_s *stat = &wqueue->stat;
+
+  stat->nrun++;
+  stat->wait_time += wait;
+  stat->run_time  += run;
+
+  if (wait > stat->wait_max)
+    {
+      stat->wait_max = wait;
+    }
+
+  if (run > stat->run_max)
+    {
+      stat->run_max = run;
+    }
+}
+#endif
+
+/****************************************************************************
+ * Name: work_qid2wqueue
+ *
+ * Description:
+ *   Return the kernel work queue 'qid' and its number of worker threads.
+ *
+ ****************************************************************************/
+
+static FAR struct kwork_wqueue_s *work_qid2wqueue(int qid, FAR int *nthread)
+{
+#ifdef CONFIG_SCHED_HPWORK
+  if (qid == HPWORK)
+    {
+      *nthread = CONFIG_SCHED_HPNTHREADS;
+      return (FAR struct kwork_wqueue_s *)&g_hpwork;
+    }
+#endif
+
+#ifdef CONFIG_SCHED_LPWORK
+  if (qid == LPWORK)
+    {
+      *nthread = CONFIG_SCHED_LPNTHREADS;
+      return (FAR struct kwork_wqueue_s *)&g_lpwork;
+    }
+#endif
+
+  return NULL;
+}
+
+/****************************************************************************
+ * Name: work_dequeue
+ *
+ * Description:
+ *   Remove the next work from the queue of a worker thread.  The worker
+ *   thread of a per-CPU queue that is empty steals the oldest work of a
+ *   CPU whose worker thread is busy.  Called within a critical section.
+ *
+ ****************************************************************************/
+
+static FAR struct work_s *work_dequeue(FAR struct kwork_wqueue_s *wqueue)
+{
+  FAR struct work_s *work;
+#ifdef CONFIG_SCHED_CPUWORK_STEAL
+  FAR struct kwork_wqueue_s *victim;
+  int cpu;
+#endif
+
+  work = (FAR struct work_s *)dq_remfirst(&wqueue->q);
+  if (work != NULL)
+    {
+      work_stat_removed(wqueue);
+      return work;
+    }
+
+#ifdef CONFIG_SCHED_CPUWORK_STEAL
+  if (wqueue >= g_cpuwork && wqueue < &g_cpuwork[CONFIG_SMP_NCPUS])
+    {
+      for (cpu = 0; cpu < CONFIG_SMP_NCPUS; cpu++)
+        {
+          victim = &g_cpuwork[cpu];
+          if (victim == wqueue || victim->worker[0].work == NULL)
+            {
+              continue;
+            }
+
+          work = (FAR struct work_s *)dq_remfirst(&victim->q);
+          if (work != NULL)
+            {
+              work_stat_removed(victim);
+#ifdef CONFIG_SCHED_WORKQUEUE_STATS
+              wqueue->stat.nstolen++;
+#endif
+              return work;
+            }
+        }
+    }
+#endif
+
+  return NULL;
+}
+
 /****************************************************************************
  * Name: work_thread
  *
@@ -132,6 +251,10 @@ static int work_thread(int argc, FAR char *argv[])
   irqstate_t flags;
   FAR void *arg;
   int semcount;
+#ifdef CONFIG_SCHED_WORKQUEUE_STATS
+  clock_t start;
+  clock_t wait;
+#endif
 
   /* Get the handle from argv */
 
@@ -153,7 +276,7 @@ static int work_thread(int argc, FAR char *argv[])
 
       /* Remove the ready-to-execute work from the list */
 
-      while ((work = (FAR struct work_s *)dq_remfirst(&wqueue->q)) != NULL)
+      while ((work = work_dequeue(wqueue)) != NULL)
         {
           if (work->worker == NULL)
             {
@@ -178,6 +301,11 @@ static int work_thread(int argc, FAR char *argv[])
 
           kworker->work = work;
 
+#ifdef CONFIG_SCHED_WORKQUEUE_STATS
+          start = perf_gettime();
+          wait  = start - work->stamp;
+#endif
+
           /* Do the work.  Re-enable interrupts while the work is being
            * performed... we don't have any idea how long this will take!
            */
@@ -186,6 +314,10 @@ static int work_thread(int argc, FAR char *argv[])
           CALL_WORKER(worker, arg);
           flags = enter_critical_section();
 
+#ifdef CONFIG_SCHED_WORKQUEUE_STATS
+          work_stat_run(wqueue, wait, perf_gettime() - start);
+#endif
+
           /* Mark the thread un-busy */
 
           kworker->work = NULL;
@@ -302,31 +434,141 @@ void work_foreach(int qid, work_foreach_t handler, FAR void *arg)
   int nthread;
   int wndx;
 
-#ifdef CONFIG_SCHED_HPWORK
-  if (qid == HPWORK)
+#ifdef CONFIG_SCHED_CPUWORK
+  if (qid == CPUWORK)
     {
-      wqueue  = (FAR struct kwork_wqueue_s *)&g_hpwork;
-      nthread = CONFIG_SCHED_HPNTHREADS;
+      for (wndx = 0; wndx < CONFIG_SMP_NCPUS; wndx++)
+        {
+          handler(g_cpuwork[wndx].worker[0].pid, arg);
+        }
+
+      return;
     }
-  else
 #endif
-#ifdef CONFIG_SCHED_LPWORK
-  if (qid == LPWORK)
+
+  wqueue = work_qid2wqueue(qid, &nthread);
+  if (wqueue == NULL)
     {
-      wqueue  = (FAR struct kwork_wqueue_s *)&g_lpwork;
-      nthread = CONFIG_SCHED_LPNTHREADS;
+      return;
+    }
+
+  for (wndx = 0; wndx < nthread; wndx++)
+    {
+      handler(wqueue->worker[wndx].pid, arg);
+    }
+}
+
+/****************************************************************************
+ * Name: work_getstat and work_resetstat
+ *
+ * Description:
+ *   Get a snapshot of, or clear, the statistics of a kernel work queue.
+ *
+ * Input Parameters:
+ *   qid  - The work queue ID (HPWORK or LPWORK)
+ *   stat - Location to return the statistics
+ *
+ * Returned Value:
+ *   Zero (OK) on success, -EINVAL if there is no such work queue.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_SCHED_WORKQUEUE_STATS
+int work_getstat(int qid, FAR struct work_stat_s *stat)
+{
+  FAR struct kwork_wqueue_s *wqueue;
+  irqstate_t flags;
+  int nthread;
+#ifdef CONFIG_SCHED_CPUWORK
+  FAR struct work_stat_s *cpustat;
+  int cpu;
+
+  /* The statistics of the per-CPU queues are added up */
+
+  if (qid == CPUWORK)
+    {
+      memset(stat, 0, sizeof(struct work_stat_s));
+
+      flags = enter_critical_section();
+      for (cpu = 0; cpu < CONFIG_SMP_NCPUS; cpu++)
+        {
+          cpustat = &g_cpuwork[cpu].stat;
+
+          stat->nqueued    += cpustat->nqueued;
+          stat->nrun       += cpustat->nrun;
+          stat->npending   += cpustat->npending;
+          stat->maxpending += cpustat->maxpending;
+          stat->wait_time  += cpustat->wait_time;
+          stat->run_time   += cpustat->run_time;
+          stat->nstolen    += cpustat->nstolen;
+
+          if (cpustat->wait_max > stat->wait_max)
+            {
+              stat->wait_max = cpustat->wait_max;
+            }
+
+          if (cpustat->run_max > stat->run_max)
+            {
+              stat->run_max = cpustat->run_max;
+            }
+        }
+
+      leave_critical_section(flags);
+      return OK;
+    }
+#endif
+
+  wqueue = work_qid2wqueue(qid, &nthread);
+  if (wqueue == NULL)
+    {
+      return -EINVAL;
+    }
+
+  flags = enter_critical_section();
+  memcpy(stat, &wqueue->stat, sizeof(struct work_stat_s));
+  leave_critical_section(flags);
+  return OK;
+}
+
+int work_resetstat(int qid)
+{
+  FAR struct kwork_wqueue_s *wqueue;
+  irqstate_t flags;
+  uint32_t npending;
+  int nqueues = 1;
+  int nthread;
+
+#ifdef CONFIG_SCHED_CPUWORK
+  if (qid == CPUWORK)
+    {
+      wqueue  = g_cpuwork;
+      nqueues = CONFIG_SMP_NCPUS;
     }
   else
 #endif
     {
-      return;
+      wqueue = work_qid2wqueue(qid, &nthread);
+      if (wqueue == NULL)
+        {
+          return -EINVAL;
+        }
     }
 
-  for (wndx = 0; wndx < nthread; wndx++)
+  /* The work still pending is not forgotten */
+
+  flags = enter_critical_section();
+  for (; nqueues > 0; nqueues--, wqueue++)
     {
-      handler(wqueue->worker[wndx].pid, arg);
+      npending = wqueue->stat.npending;
+      memset(&wqueue->stat, 0, sizeof(struct work_stat_s));
+      wqueue->stat.npending   = npending;
+      wqueue->stat.maxpending = npending;
     }
+
+  leave_critical_section(flags);
+  return OK;
 }
+#endif
 
 /****************************************************************************
  * Name: work_start_highpri
@@ -384,4 +626,62 @@ int work_start_lowpri(void)
 }
 #endif /* CONFIG_SCHED_LPWORK */
 
+/****************************************************************************
+ * Name: work_start_cpu
+ *
+ * Description:
+ *   Start the per-CPU, kernel-mode worker threads, each bound to its CPU.
+ *
+ * Input Parameters:
+ *   None
+ *
+ * Returned Value:
+ *   Zero (OK) on success, a negated errno value on failure.
+ *
+ ****************************************************************************/
+
+#if defined(CONFIG_SCHED_CPUWORK)
+int work_start_cpu(void)
+{
+  FAR struct kwork_wqueue_s *wqueue;
+  cpu_set_t cpuset;
+  char name[16];
+  int ret = OK;
+  int cpu;
+
+  sinfo("Starting per-CPU kernel worker threads\n");
+
+  /* Keep the new threads from running until they are bound to their CPU */
+
+  sched_lock();
+
+  for (cpu = 0; cpu < CONFIG_SMP_NCPUS; cpu++)
+    {
+      wqueue = &g_cpuwork[cpu];
+      nxsem_init(&wqueue->sem, 0, 0);
+
+      snprintf(name, sizeof(name), CPUWORKNAME "%d", cpu);
+      ret = work_thread_create(name, CONFIG_SCHED_CPUWORKPRIORITY,
+                               CONFIG_SCHED_CPUWORKSTACKSIZE, 1, wqueue);
+      if (ret < 0)
+        {
+          break;
+        }
+
+      CPU_ZERO(&cpuset);
+      CPU_SET(cpu, &cpuset);
+      ret = nxsched_set_affinity(wqueue->worker[0].pid, sizeof(cpu_set_t),
+                                 &cpuset);
+      if (ret < 0)
+        {
+          serr("ERROR: Failed to bind %s: %d\n", name, ret);
+          break;
+        }
+    }
+
+  sched_unlock();
+  return ret;
+}
+#endif /* CONFIG_SCHED_CPUWORK */
+
 #endif /* CONFIG_SCHED_WORKQUEUE */
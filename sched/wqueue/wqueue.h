@@ -32,6 +32,7 @@
 
 #include <nuttx/clock.h>
 #include <nuttx/queue.h>
+#include <nuttx/wqueue.h>
 
 #ifdef CONFIG_SCHED_WORKQUEUE
 
@@ -43,6 +44,27 @@
 
 #define HPWORKNAME "hpwork"
 #define LPWORKNAME "lpwork"
+#define CPUWORKNAME "cpuwork"
+
+/* Statistics hooks, called within a critical section */
+
+#ifdef CONFIG_SCHED_WORKQUEUE_STATS
+#  define work_stat_queued(wqueue, work) \
+     do \
+       { \
+         (work)->stamp = perf_gettime(); \
+         (wqueue)->stat.nqueued++; \
+         if (++(wqueue)->stat.npending > (wqueue)->stat.maxpending) \
+           { \
+             (wqueue)->stat.maxpending = (wqueue)->stat.npending; \
+           } \
+       } \
+     while (0)
+#  define work_stat_removed(wqueue) ((wqueue)->stat.npending--)
+#else
+#  define work_stat_queued(wqueue, work)
+#  define work_stat_removed(wqueue)
+#endif
 
 /****************************************************************************
  * Public Type Definitions
@@ -63,6 +85,9 @@ struct kwork_wqueue_s
 {
   struct dq_queue_s q;         /* The queue of pending work */
   sem_t             sem;       /* The counting semaphore of the wqueue */
+#ifdef CONFIG_SCHED_WORKQUEUE_STATS
+  struct work_stat_s stat;     /* Statistics of the wqueue */
+#endif
   struct kworker_s  worker[1]; /* Describes a worker thread */
 };
 
@@ -75,6 +100,9 @@ struct hp_wqueue_s
 {
   struct dq_queue_s q;         /* The queue of pending work */
   sem_t             sem;       /* The counting semaphore of the wqueue */
+#ifdef CONFIG_SCHED_WORKQUEUE_STATS
+  struct work_stat_s stat;     /* Statistics of the wqueue */
+#endif
 
   /* Describes each thread in the high priority queue's thread pool */
 
@@ -91,6 +119,9 @@ struct lp_wqueue_s
 {
   struct dq_queue_s q;         /* The queue of pending work */
   sem_t             sem;       /* The counting semaphore of the wqueue */
+#ifdef CONFIG_SCHED_WORKQUEUE_STATS
+  struct work_stat_s stat;     /* Statistics of the wqueue */
+#endif
 
   /* Describes each thread in the low priority queue's thread pool */
 
@@ -114,6 +145,14 @@ extern struct hp_wqueue_s g_hpwork;
 extern struct lp_wqueue_s g_lpwork;
 #endif
 
+#ifdef CONFIG_SCHED_CPUWORK
+/* The state of the kernel mode, per-CPU work queues.  Each has one worker
+ * thread, bound to its CPU.
+ */
+
+extern struct kwork_wqueue_s g_cpuwork[CONFIG_SMP_NCPUS];
+#endif
+
 /****************************************************************************
  * Public Function Prototypes
  ****************************************************************************/
@@ -156,6 +195,24 @@ int work_start_highpri(void);
 int work_start_lowpri(void);
 #endif
 
+/****************************************************************************
+ * Name: work_start_cpu
+ *
+ * Description:
+ *   Start the per-CPU, kernel-mode worker threads.
+ *
+ * Input Parameters:
+ *   None
+ *
+ * Returned Value:
+ *   Zero (OK) on success, a negated errno value on failure.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_SCHED_CPUWORK
+int work_start_cpu(void);
+#endif
+
 /****************************************************************************
  * Name: work_initialize_notifier
  *
@@ -567,6 +567,13 @@ static void generate_wrapper(int nfixed, int nparms)
   fprintf(stream, "#include <nuttx/sched_note.h>\n");
   fprintf(stream, "#include <stdint.h>\n");
 
+  /* System call statistics need the time and the scheduler hook */
+
+  fprintf(stream, "#ifdef CONFIG_SCHED_SYSCALLSTAT\n");
+  fprintf(stream, "#  include <nuttx/clock.h>\n");
+  fprintf(stream, "#  include <nuttx/sched.h>\n");
+  fprintf(stream, "#endif\n");
+
   /* Suppress "'noreturn' function does return" warnings. */
 
   fprintf(stream, "#include <nuttx/compiler.h>\n");
@@ -663,6 +670,12 @@ static void generate_wrapper(int nfixed, int nparms)
       fprintf(stream, "  %s result;\n", g_parm[RETTYPE_INDEX]);
     }
 
+  /* Generate the start time variable definition for the statistics */
+
+  fprintf(stream, "#ifdef CONFIG_SCHED_SYSCALLSTAT\n");
+  fprintf(stream, "  clock_t start;\n");
+  fprintf(stream, "#endif\n");
+
   /* Generate the wrapped (real) function prototype definition */
 
   if (strcmp(g_parm[RETTYPE_INDEX], "noreturn") == 0)
@@ -774,6 +787,12 @@ static void generate_wrapper(int nfixed, int nparms)
 
   fprintf(stream, ");\n\n");
 
+  /* Time the system call */
+
+  fprintf(stream, "#ifdef CONFIG_SCHED_SYSCALLSTAT\n");
+  fprintf(stream, "  start = perf_gettime();\n");
+  fprintf(stream, "#endif\n\n");
+
   /* Then call the wrapped (real) function.  Functions that have no return
    * value are a special case.
    */
@@ -822,6 +841,15 @@ static void generate_wrapper(int nfixed, int nparms)
 
   fprintf(stream, ");\n\n");
 
+  /* Account the system call.  Functions that do not return are never
+   * accounted.
+   */
+
+  fprintf(stream, "#ifdef CONFIG_SCHED_SYSCALLSTAT\n");
+  fprintf(stream, "  nxsched_syscall_stat(SYS_%s, start);\n",
+          g_parm[NAME_INDEX]);
+  fprintf(stream, "#endif\n\n");
+
   /* Tail end of the function.  If the wrapped (real) function has no return
    * value, do nothing.
    */
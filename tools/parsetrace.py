@@ -21,8 +21,10 @@
 
 import argparse
 import bisect
+import json
 import os
 import re
+import struct
 import subprocess
 from typing import Union
 
@@ -311,6 +313,183 @@ class ParseBinaryLogTool:
                 print(f"debug, dump one={mod.dump_one_trace()}")
 
 
+NOTE_START = 0
+NOTE_STOP = 1
+NOTE_SUSPEND = 2
+NOTE_RESUME = 3
+NOTE_SYSCALL_ENTER = 18
+NOTE_SYSCALL_LEAVE = 19
+NOTE_IRQ_ENTER = 20
+NOTE_IRQ_LEAVE = 21
+NOTE_DUMP_STRING = 22
+NOTE_DUMP_BINARY = 23
+NOTE_DUMP_BEGIN = 24
+NOTE_DUMP_END = 25
+NOTE_DUMP_MARK = 28
+NOTE_DUMP_COUNTER = 29
+
+# Thread IDs used for the interrupt tracks, one per CPU
+
+IRQ_TID_BASE = 0x40000000
+
+
+def align(offset, size):
+    return (offset + size - 1) & ~(size - 1)
+
+
+class NoteLayout(object):
+    """Offsets of the fields of struct note_*_s for one target."""
+
+    def __init__(self, long_size, time64, smp, big_endian):
+        self.endian = ">" if big_endian else "<"
+        self.long = "q" if long_size == 8 else "i"
+        self.ptr = "Q" if long_size == 8 else "I"
+        self.ptr_size = long_size
+        self.time = "q" if time64 else "I"
+        time_size = 8 if time64 else 4
+
+        # struct note_common_s
+
+        self.cpu = 3 if smp else None
+        self.pid = 4
+        self.sec = align(8, time_size)
+        self.nsec = align(self.sec + time_size, long_size)
+        self.common = align(self.nsec + long_size, max(time_size, long_size))
+
+        # Fields following the common header
+
+        self.ip = align(self.common, long_size)
+        self.data = self.ip + long_size
+
+    def unpack(self, fmt, buf, offset):
+        return struct.unpack_from(self.endian + fmt, buf, offset)[0]
+
+
+class ParseBinaryJsonTool(object):
+    """Convert binary notes to the JSON trace event format of Perfetto."""
+
+    def __init__(self, layout, symbols=None):
+        self.layout = layout
+        self.symbols = symbols
+        self.events = []
+        self.names = {}
+        self.running = {}
+
+    def emit(self, **event):
+        event.setdefault("pid", 0)
+        self.events.append(event)
+
+    def switch_out(self, cpu, ts):
+        if cpu in self.running:
+            pid, start = self.running.pop(cpu)
+            self.emit(
+                name="Running",
+                ph="X",
+                tid=pid,
+                ts=start,
+                dur=ts - start,
+                args={"cpu": cpu},
+            )
+
+    def lookup(self, addr):
+        if self.symbols is None:
+            return "%#x" % addr
+        return self.symbols.addr2symbol(addr)
+
+    def parse_one(self, buf, offset):
+        lay = self.layout
+        length = buf[offset]
+        ntype = buf[offset + 1]
+        note = buf[offset : offset + length]
+        cpu = note[lay.cpu] if lay.cpu is not None else 0
+        pid = lay.unpack("i", note, lay.pid)
+        ts = (
+            lay.unpack(lay.time, note, lay.sec) * 1000000
+            + lay.unpack(lay.long, note, lay.nsec) / 1000.0
+        )
+
+        if ntype == NOTE_START:
+            name = note[lay.common :].split(b"\0")[0].decode(errors="replace")
+            self.names[pid] = name
+        elif ntype == NOTE_STOP:
+            self.switch_out(cpu, ts)
+        elif ntype == NOTE_SUSPEND:
+            self.switch_out(cpu, ts)
+        elif ntype == NOTE_RESUME:
+            self.switch_out(cpu, ts)
+            self.running[cpu] = (pid, ts)
+        elif ntype in (NOTE_SYSCALL_ENTER, NOTE_SYSCALL_LEAVE):
+            nr = note[lay.common]
+            phase = "B" if ntype == NOTE_SYSCALL_ENTER else "E"
+            self.emit(name="syscall %d" % nr, ph=phase, tid=pid, ts=ts)
+        elif ntype in (NOTE_IRQ_ENTER, NOTE_IRQ_LEAVE):
+            handler = lay.unpack(lay.ptr, note, lay.ip)
+            irq = note[lay.ip + lay.ptr_size]
+            phase = "B" if ntype == NOTE_IRQ_ENTER else "E"
+            self.emit(
+                name="irq %d" % irq,
+                ph=phase,
+                tid=IRQ_TID_BASE + cpu,
+                ts=ts,
+                args={"handler": self.lookup(handler)},
+            )
+        elif ntype in (NOTE_DUMP_BEGIN, NOTE_DUMP_END):
+            data = note[lay.data :].split(b"\0")[0].decode(errors="replace")
+            if not data:
+                data = self.lookup(lay.unpack(lay.ptr, note, lay.ip))
+            phase = "B" if ntype == NOTE_DUMP_BEGIN else "E"
+            self.emit(name=data, ph=phase, tid=pid, ts=ts)
+        elif ntype in (NOTE_DUMP_STRING, NOTE_DUMP_MARK):
+            data = note[lay.data :].split(b"\0")[0].decode(errors="replace")
+            fields = data.split("|", 2)
+            if len(fields) == 3 and fields[0] in ("B", "E"):
+                self.emit(name=fields[2], ph=fields[0], tid=pid, ts=ts)
+            else:
+                self.emit(name=data, ph="i", s="t", tid=pid, ts=ts)
+        elif ntype == NOTE_DUMP_COUNTER:
+            value = lay.unpack(lay.long, note, lay.data)
+            name = note[lay.data + lay.ptr_size :].split(b"\0")[0]
+            self.emit(
+                name=name.decode(errors="replace"),
+                ph="C",
+                tid=pid,
+                ts=ts,
+                args={"value": value},
+            )
+
+        return length
+
+    def parse(self, buf):
+        offset = 0
+        while offset + self.layout.common <= len(buf):
+            length = buf[offset]
+            if length < self.layout.common or offset + length > len(buf):
+                print("Truncated note at offset %d" % offset)
+                break
+
+            self.parse_one(buf, offset)
+            offset += length
+
+        last = max([e["ts"] for e in self.events] + [0])
+        for cpu in list(self.running):
+            self.switch_out(cpu, last)
+
+    def dump(self, out):
+        for tid, name in self.names.items():
+            self.emit(name="thread_name", ph="M", tid=tid, args={"name": name})
+
+        irqtids = set(e["tid"] for e in self.events if e["tid"] >= IRQ_TID_BASE)
+        for tid in irqtids:
+            self.emit(
+                name="thread_name",
+                ph="M",
+                tid=tid,
+                args={"name": "CPU %d IRQ" % (tid - IRQ_TID_BASE)},
+            )
+
+        json.dump({"traceEvents": self.events, "displayTimeUnit": "ns"}, out)
+
+
 if __name__ == "__main__":
     parser = argparse.ArgumentParser()
     parser.add_argument("-t", "--trace", help="original trace file", required=True)
@@ -321,6 +500,31 @@ if __name__ == "__main__":
         help="filtered trace file, default output trace.systrace",
         default="trace.systrace",
     )
+    parser.add_argument(
+        "-j",
+        "--json",
+        action="store_true",
+        help="convert a binary trace to the JSON trace event format, "
+        "which ui.perfetto.dev and chrome://tracing load directly",
+    )
+    parser.add_argument(
+        "--long-size",
+        type=int,
+        choices=[4, 8],
+        default=4,
+        help="size of long and pointers on the target (binary trace)",
+    )
+    parser.add_argument(
+        "--time64",
+        action="store_true",
+        help="CONFIG_SYSTEM_TIME64 is set (binary trace)",
+    )
+    parser.add_argument(
+        "--smp", action="store_true", help="CONFIG_SMP is set (binary trace)"
+    )
+    parser.add_argument(
+        "--big-endian", action="store_true", help="target is big endian"
+    )
     args = parser.parse_args()
 
     file_type = subprocess.check_output(f"file -b {args.trace}", shell=True)
@@ -341,13 +545,30 @@ if __name__ == "__main__":
         with open(args.out, "w") as out:
             out.writelines("\n".join(lines))
             print(os.path.abspath(args.out))
+    elif args.json:
+        print("trace log type is binary, converting to JSON")
+        layout = NoteLayout(args.long_size, args.time64, args.smp, args.big_endian)
+        symbols = None
+        if args.elf:
+            symbols = SymbolTables(args.elf)
+            symbols.parse_symbol()
+        notes = ParseBinaryJsonTool(layout, symbols)
+        with open(args.trace, "rb") as f:
+            notes.parse(f.read())
+        with open(args.out, "w") as f:
+            notes.dump(f)
+        print("%d events written to %s" % (len(notes.events), args.out))
     else:
         print("trace log type is binary")
         if args.elf:
-            print(
-                "parse_binary_log, default config, size_long=4, config_endian_big=False, config_smp=0"
+            parse_binary_log_tool = ParseBinaryLogTool(
+                args.trace,
+                args.elf,
+                args.out,
+                size_long=args.long_size,
+                config_endian_big=args.big_endian,
+                config_smp=int(args.smp),
             )
-            parse_binary_log_tool = ParseBinaryLogTool(args.trace, args.elf, args.out)
             parse_binary_log_tool.symbol_tables.parse_symbol()
             parse_binary_log_tool.parse_binary_log()
         else: